@@ -60,6 +60,23 @@ public:
     ATOMIC_FAA(&ref_count_, 1);
   }
 
+  // only inc ref when the obj is still referenced by others, used by the lock free
+  // readers which may see an obj whose last ref has just been released
+  inline bool try_inc_ref()
+  {
+    bool bret = false;
+    int64_t old_count = ATOMIC_LOAD(&ref_count_);
+    int64_t cur_count = 0;
+    while (!bret && old_count > 0) {
+      if (old_count == (cur_count = ATOMIC_VCAS(&ref_count_, old_count, old_count + 1))) {
+        bret = true;
+      } else {
+        old_count = cur_count;
+      }
+    }
+    return bret;
+  }
+
   inline void dec_ref()
   {
     if (1 == ATOMIC_FAA(&ref_count_, -1)) {
@@ -19,6 +19,8 @@
 #include "iocore/eventsystem/ob_task.h"
 #include "cmd/ob_show_sqlaudit_handler.h"
 #include "lib/allocator/ob_mem_leak_checker.h"
+#include "proxy/mysql/ob_mysql_client_session.h"
+#include "stat/ob_mysql_stats.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::lib;
@@ -167,6 +169,16 @@ int ObShowMemoryHandler::handle_show_memory(int event, void *data)
         }
       }
     }
+    if (OB_SUCC(ret)) {
+      if (OB_FAIL(dump_hibernated_client_session_memory())) {
+        LOG_WDIAG("fail to dump hibernated client session memory", K(ret));
+      }
+    }
+    if (OB_SUCC(ret) && g_event_processor.enable_io_buffer_slab_) {
+      if (OB_FAIL(dump_io_buffer_slab_memory())) {
+        LOG_WDIAG("fail to dump io buffer slab memory", K(ret));
+      }
+    }
   }
 
   if (OB_SUCC(ret)) {
@@ -252,6 +264,57 @@ int ObShowMemoryHandler::dump_mod_memory(const char *name, const char *type, con
   return ret;
 }
 
+// resident bytes of the hibernated client sessions, before and after their read
+// buffers were freed, avg_used is the bytes per session
+int ObShowMemoryHandler::dump_hibernated_client_session_memory()
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  int64_t freed_bytes = 0;
+  MYSQL_READ_DYN_SUM(CURRENT_HIBERNATED_CLIENT_SESSIONS, count);
+  MYSQL_READ_DYN_SUM(CURRENT_HIBERNATED_CLIENT_SESSION_BYTES, freed_bytes);
+  const int64_t after = count * static_cast<int64_t>(sizeof(ObMysqlClientSession));
+  const int64_t before = after + freed_bytes;
+  if (OB_FAIL(dump_mod_memory("HIBERNATED_CLIENT_SESSION_BEFORE", "user", before, before, count))) {
+    LOG_WDIAG("fail to dump memory info", K(ret));
+  } else if (OB_FAIL(dump_mod_memory("HIBERNATED_CLIENT_SESSION_AFTER", "user", after, after, count))) {
+    LOG_WDIAG("fail to dump memory info", K(ret));
+  }
+  return ret;
+}
+
+// one row for each size class, summed over the slabs of all event threads
+int ObShowMemoryHandler::dump_io_buffer_slab_memory()
+{
+  int ret = OB_SUCCESS;
+  char name[64];
+  int64_t hold = 0;
+  int64_t used = 0;
+  int64_t count = 0;
+  int64_t thread_hold = 0;
+  int64_t thread_used = 0;
+  int64_t thread_count = 0;
+  ObEThread *ethread = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    hold = 0;
+    used = 0;
+    count = 0;
+    for (int64_t j = 0; j < g_event_processor.event_thread_count_; ++j) {
+      if (NULL != (ethread = g_event_processor.all_event_threads_[j]) && NULL != ethread->io_buffer_slab_) {
+        ethread->io_buffer_slab_->get_usage(i, thread_hold, thread_used, thread_count);
+        hold += thread_hold;
+        used += thread_used;
+        count += thread_count;
+      }
+    }
+    snprintf(name, sizeof(name), "IO_BUFFER_SLAB_%ld", static_cast<int64_t>(BUFFER_SIZE_FOR_INDEX(i)));
+    if (OB_FAIL(dump_mod_memory(name, "allocator", hold, used, count))) {
+      LOG_WDIAG("fail to dump memory info", K(name), K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObShowMemoryHandler::handle_show_objpool(int event, void *data)
 {
   int event_ret = EVENT_DONE;
@@ -39,6 +39,8 @@ private:
   int dump_mod_memory_header();
   int dump_mod_memory(const char *name, const char *type, const int64_t hold,
                       const int64_t used, const int64_t count, const ObString& backtrace = ObString(""));
+  int dump_io_buffer_slab_memory();
+  int dump_hibernated_client_session_memory();
 
   int dump_objpool_header();
   int dump_objpool_memory(const common::ObObjFreeList *fl, const ObString& backtrace = ObString(""));
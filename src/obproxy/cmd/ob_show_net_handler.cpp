@@ -51,6 +51,7 @@ enum
   OB_TC_PROTECTED_QUEUE_AL_SIZE,
   OB_TC_PROTECTED_QUEUE_LOCAL_SIZE,
   OB_TC_PRIORITY_QUEUE_SIZE,
+  OB_TC_TOTAL_ACCEPTED_CONNECTIONS,
   OB_TC_MAX_THREAD_COLUMN_ID,
 };
 
@@ -108,7 +109,8 @@ const ObProxyColumnSchema THREAD_COLUMN_ARRAY[OB_TC_MAX_THREAD_COLUMN_ID] = {
     ObProxyColumnSchema::make_schema(OB_TC_TOTAL_WRITE_BYTES,            "total_write_bytes",                      OB_MYSQL_TYPE_LONGLONG),
     ObProxyColumnSchema::make_schema(OB_TC_PROTECTED_QUEUE_AL_SIZE,      "protected_queue_al_size",                OB_MYSQL_TYPE_LONGLONG),
     ObProxyColumnSchema::make_schema(OB_TC_PROTECTED_QUEUE_LOCAL_SIZE,   "protected_queue_local_size",             OB_MYSQL_TYPE_LONGLONG),
-    ObProxyColumnSchema::make_schema(OB_TC_PRIORITY_QUEUE_SIZE,          "priority_queue_size",                    OB_MYSQL_TYPE_LONGLONG)
+    ObProxyColumnSchema::make_schema(OB_TC_PRIORITY_QUEUE_SIZE,          "priority_queue_size",                    OB_MYSQL_TYPE_LONGLONG),
+    ObProxyColumnSchema::make_schema(OB_TC_TOTAL_ACCEPTED_CONNECTIONS,   "total_accepted_connections",             OB_MYSQL_TYPE_LONGLONG)
 };
 
 const ObProxyColumnSchema CONN_COLUMN_ARRAY[OB_CC_MAX_CONN_COLUMN_ID] = {
@@ -378,6 +380,7 @@ int ObShowNetHandler::dump_single_thread(ObEThread *ethread, const ObNetHandler
     cells[OB_TC_PROTECTED_QUEUE_AL_SIZE].set_int(ethread->event_queue_external_.get_atomic_list_size());
     cells[OB_TC_PROTECTED_QUEUE_LOCAL_SIZE].set_int(ethread->event_queue_external_.get_local_queue_size());
     cells[OB_TC_PRIORITY_QUEUE_SIZE].set_int(ethread->event_queue_.get_queue_size());
+    cells[OB_TC_TOTAL_ACCEPTED_CONNECTIONS].set_int(ObStatProcessor::get_thread_raw_stat_sum(net_rsb, ethread, NET_ACCEPTED_CONNECTIONS));
 
     row.cells_ = cells;
     row.count_ = OB_TC_MAX_THREAD_COLUMN_ID;
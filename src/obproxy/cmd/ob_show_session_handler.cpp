@@ -59,6 +59,7 @@ enum
   OB_SILC_TID,
   OB_SILC_PID,
   OB_SILC_USING_SSL,
+  OB_SILC_CPU_TIME,
   OB_SILC_MAX_SLIST_COLUMN_ID,
 };
 
@@ -127,6 +128,7 @@ const ObProxyColumnSchema INTERNAL_LIST_COLUMN_ARRAY[OB_SILC_MAX_SLIST_COLUMN_ID
     ObProxyColumnSchema::make_schema(OB_SILC_TID,           "tid",                OB_MYSQL_TYPE_LONGLONG),
     ObProxyColumnSchema::make_schema(OB_SILC_PID,           "pid",                OB_MYSQL_TYPE_LONG),
     ObProxyColumnSchema::make_schema(OB_SILC_USING_SSL,     "using_ssl",          OB_MYSQL_TYPE_LONG),
+    ObProxyColumnSchema::make_schema(OB_SILC_CPU_TIME,      "cpu_time_us",        OB_MYSQL_TYPE_LONGLONG),
 };
 
 const ObProxyColumnSchema ATTRIBUTE_COLUMN_ARRAY[OB_SLC_MAX_SLIST_COLUMN_ID]      = {
@@ -781,7 +783,8 @@ int ObShowSessionHandler::dump_cs_list(const ObMysqlClientSession &cs)
     cells[OB_SILC_STATE].set_varchar(cs.get_read_state_str());
     cells[OB_SILC_TID].set_int(cs.get_current_tid());
     cells[OB_SILC_PID].set_mediumint(getpid());
-    cells[OB_SILC_USING_SSL].set_int(static_cast<ObUnixNetVConnection*>(cs.get_netvc())->using_ssl());
+    cells[OB_SILC_USING_SSL].set_int(static_cast<ObUnixNetVConnection*>(cs.get_netvc())->is_ssl_connection());
+    cells[OB_SILC_CPU_TIME].set_int(hrtime_to_usec(cs.get_cpu_time()));
     row.cells_ = cells;
     row.count_ = OB_SILC_MAX_SLIST_COLUMN_ID;
     if (OB_FAIL(encode_row_packet(row))) {
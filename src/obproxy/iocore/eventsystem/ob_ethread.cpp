@@ -36,8 +36,10 @@
 #include <sys/eventfd.h>
 #endif
 #include "lib/profile/ob_trace_id.h"
+#include "stat/ob_net_stats.h"
 
 using namespace oceanbase::common;
+using namespace oceanbase::obproxy::net;
 
 namespace oceanbase
 {
@@ -75,7 +77,10 @@ ObEThread::ObEThread()
       tt_(REGULAR),
       pending_event_(NULL),
       thread_prometheus_(NULL),
-      use_status_(false)
+      use_status_(false),
+      stealable_queue_(),
+      steal_seed_(0),
+      io_buffer_slab_(NULL)
 {
 #if OB_HAVE_EVENTFD
   evfd_ = -1;
@@ -116,7 +121,10 @@ ObEThread::ObEThread(const ObThreadType att, const int64_t anid)
       tt_(att),
       pending_event_(NULL),
       thread_prometheus_(NULL),
-      use_status_(false)
+      use_status_(false),
+      stealable_queue_(),
+      steal_seed_(0),
+      io_buffer_slab_(NULL)
 {
 #if OB_HAVE_EVENTFD
   evfd_ = -1;
@@ -157,7 +165,10 @@ ObEThread::ObEThread(const ObThreadType att, ObEvent *e)
       tt_(att),
       pending_event_(e),
       thread_prometheus_(NULL),
-      use_status_(false)
+      use_status_(false),
+      stealable_queue_(),
+      steal_seed_(0),
+      io_buffer_slab_(NULL)
 {
 #if OB_HAVE_EVENTFD
   evfd_ = -1;
@@ -245,6 +256,9 @@ int ObEThread::init()
         } else {
           //do nothing
         }
+        if (OB_SUCC(ret) && g_event_processor.enable_coalesced_wakeup_) {
+          event_queue_external_.set_wakeup_fd(evfd_);
+        }
 #else
         if (OB_UNLIKELY(pipe(evpipe_) < 0)) {
           ret = OB_ERR_SYS;
@@ -266,6 +280,24 @@ int ObEThread::init()
         }
 #endif
       }
+      if (OB_SUCC(ret)) {
+        if (OB_FAIL(stealable_queue_.init())) {
+          LOG_WDIAG("fail to init stealable_queue_", K(ret));
+        } else {
+          steal_seed_ = static_cast<uint32_t>(id_) + 1;
+        }
+      }
+      if (OB_SUCC(ret) && g_event_processor.enable_io_buffer_slab_) {
+        if (OB_ISNULL(io_buffer_slab_ = new (std::nothrow) ObIOBufferSlab())) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_EDIAG("fail to allocate memory for io buffer slab", K(ret));
+        } else if (OB_FAIL(io_buffer_slab_->init(g_event_processor.io_buffer_slab_numa_local_,
+                                                 g_event_processor.io_buffer_slab_huge_page_))) {
+          LOG_WDIAG("fail to init io buffer slab", K(ret));
+          delete io_buffer_slab_;
+          io_buffer_slab_ = NULL;
+        }
+      }
     } else {
       //others == tt_
     }
@@ -363,6 +395,96 @@ inline void ObEThread::dequeue_local_event(Que(ObEvent, link_) &negative_queue)
   }
 }
 
+int ObEThread::schedule_stealable(ObEvent &event, const bool fast_signal)
+{
+  UNUSED(fast_signal);
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(REGULAR != tt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("only REGULAR ethread can arrive here", K(tt_), K(ret));
+  } else if (OB_UNLIKELY(this != this_ethread())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("stealable event must be scheduled on current ethread", K(ret));
+  } else if (OB_ISNULL(event.continuation_->mutex_)) {
+    // the thread mutex can not be used by other threads, keep it local
+    ret = schedule_local(event);
+  } else {
+    event.ethread_ = this;
+    event.mutex_ = event.continuation_->mutex_;
+    stealable_queue_.push(&event);
+    // more than one event is waiting, let an idle thread help
+    if (stealable_queue_.get_size() >= 2) {
+      wakeup_idle_peer();
+    }
+  }
+  return ret;
+}
+
+inline uint32_t ObEThread::next_steal_rand()
+{
+  // xorshift32, good enough to pick a victim
+  steal_seed_ ^= steal_seed_ << 13;
+  steal_seed_ ^= steal_seed_ >> 17;
+  steal_seed_ ^= steal_seed_ << 5;
+  return steal_seed_;
+}
+
+void ObEThread::wakeup_idle_peer()
+{
+  // without coalesced wakeup we can not tell which thread sleeps, and the
+  // idle threads steal on their next heartbeat
+  if (event_queue_external_.is_coalesced_wakeup() && 0 != event_types_) {
+    const int64_t etype = __builtin_ctzll(event_types_);
+    const int64_t count = g_event_processor.thread_count_for_type_[etype];
+    const int64_t start = (count > 0) ? (next_steal_rand() % count) : 0;
+    ObEThread *peer = NULL;
+    for (int64_t i = 0; i < count; ++i) {
+      peer = g_event_processor.event_thread_[etype][(start + i) % count];
+      if (NULL != peer && this != peer && ATOMIC_LOAD(&peer->event_queue_external_.sleeping_)) {
+        peer->event_queue_external_.signal();
+        break;
+      }
+    }
+  }
+}
+
+ObEvent *ObEThread::steal_event()
+{
+  ObEvent *e = NULL;
+  if (0 != event_types_) {
+    const int64_t etype = __builtin_ctzll(event_types_);
+    const int64_t count = g_event_processor.thread_count_for_type_[etype];
+    if (count > 1) {
+      // power of two choices, try the one with the longer queue
+      ObEThread *victim = g_event_processor.event_thread_[etype][next_steal_rand() % count];
+      ObEThread *other = g_event_processor.event_thread_[etype][next_steal_rand() % count];
+      if (this == victim || (NULL != other && this != other
+          && other->stealable_queue_.get_size() > victim->stealable_queue_.get_size())) {
+        victim = other;
+      }
+      if (NULL != victim && this != victim && NULL != (e = victim->stealable_queue_.steal())) {
+        e->ethread_ = this;
+        NET_ATOMIC_INCREMENT_DYN_STAT(this, NET_EVENTS_STOLEN);
+      }
+    }
+  }
+  return e;
+}
+
+inline void ObEThread::process_stealable_events()
+{
+  // only run the events already here, the new ones wait for the next round
+  // and may be stolen meanwhile
+  ObEvent *e = NULL;
+  for (int64_t count = stealable_queue_.get_size(); count > 0 && NULL != (e = stealable_queue_.pop()); --count) {
+    if (e->cancelled_) {
+      free_event(*e);
+    } else {
+      process_event(e, e->callback_event_);
+    }
+  }
+}
+
 // Execute loops forever on:
 // Find the earliest event.
 // Sleep until the event time or until an earlier event is inserted
@@ -402,6 +524,11 @@ void ObEThread::execute()
           }
         } while (done_one);
 
+        //2.1 execute the stealable events which have not been stolen
+        if (stealable_queue_.get_size() > 0) {
+          process_stealable_events();
+        }
+
         //3. execute any negative (poll) events
         if (NULL != negative_queue.head_) {
           if (ethreads_to_be_signalled_count_ > 0) {
@@ -421,7 +548,8 @@ void ObEThread::execute()
             flush_signals(this);
           }
 
-          if (event_queue_external_.get_local_queue_size() > 0 || event_queue_external_.get_atomic_list_size() > 0) {
+          if (event_queue_external_.get_local_queue_size() > 0 || event_queue_external_.get_atomic_list_size() > 0
+              || stealable_queue_.get_size() > 0) {
             sleep_time_ = 0;
           } else {
             cur_time_ = get_hrtime_internal();
@@ -433,6 +561,12 @@ void ObEThread::execute()
             }
           }
 
+          // nothing to do before the poll, help the busy threads instead of sleeping
+          if (sleep_time_ > 0 && g_event_processor.enable_work_stealing_ && NULL != (e = steal_event())) {
+            process_event(e, e->callback_event_);
+            sleep_time_ = 0;
+          }
+
           // execute poll events
           while (NULL != (e = negative_queue.dequeue())) {
             process_event(e, EVENT_POLL);
@@ -465,6 +599,9 @@ void ObEThread::execute()
               e->ethread_ = this;
               process_event(e, e->callback_event_);
             }
+          } else if (sleep_time_ > 0 && g_event_processor.enable_work_stealing_
+                     && event_queue_external_.atomic_list_.empty() && NULL != (e = steal_event())) {
+            process_event(e, e->callback_event_);
           } else if (OB_UNLIKELY(OB_SUCCESS != event_queue_external_.dequeue_timed(next_time, true))) {
             LOG_WDIAG("fail to dequeue time in event_queue_external_");
           }
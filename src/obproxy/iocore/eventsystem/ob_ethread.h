@@ -35,6 +35,8 @@
 #include "iocore/eventsystem/ob_priority_event_queue.h"
 #include "iocore/eventsystem/ob_protected_queue.h"
 #include "iocore/eventsystem/ob_protected_queue_thread_pool.h"
+#include "iocore/eventsystem/ob_stealable_queue.h"
+#include "iocore/eventsystem/ob_io_buffer_slab.h"
 #include "lib/container/ob_vector.h"
 
 namespace oceanbase
@@ -157,6 +159,17 @@ public:
   ObEvent *schedule_imm_signal(ObContinuation *c, const int callback_event = EVENT_IMMEDIATE,
                                void *cookie = NULL);
 
+  /**
+   * Schedules the continuation on this ObEThread to receive an event as
+   * soon as possible, but lets idle ObEThreads of the same type steal it.
+   * Must be called on this ObEThread, and the continuation must have its
+   * own mutex and must not depend on the thread it runs on.
+   *
+   * @see ObStealableQueue
+   */
+  ObEvent *schedule_imm_stealable(ObContinuation *c, const int callback_event = EVENT_IMMEDIATE,
+                                  void *cookie = NULL);
+
   /**
    * Schedules the continuation on this ObEThread to receive an event
    * at the given timeout.
@@ -311,6 +324,7 @@ public:
                                 const int callback_event = EVENT_INTERVAL, void *cookie = NULL);
 
   int schedule_local(ObEvent &e, const bool fast_signal = false);
+  int schedule_stealable(ObEvent &e, const bool fast_signal = false);
 
   ObEvent *schedule_common(ObContinuation &cont, const ObHRTime atimeout_at,
                            const ObHRTime aperiod, const int callback_event,
@@ -352,6 +366,10 @@ public:
 private:
   void process_event(ObEvent *e, const int calling_code);
   void dequeue_local_event(Que(ObEvent, link_) &negative_queue);
+  void process_stealable_events();
+  ObEvent *steal_event();
+  void wakeup_idle_peer();
+  uint32_t next_steal_rand();
 
 public:
   // TODO: This would be much nicer to have "run-time" configurable
@@ -420,6 +438,14 @@ public:
   prometheus::ObThreadPrometheus *thread_prometheus_;
   bool use_status_;
 
+  // immediate events which idle threads of the same type may steal
+  ObStealableQueue stealable_queue_;
+  uint32_t steal_seed_;
+
+  // io buffer blocks of this thread, NULL if enable_io_buffer_slab is off.
+  // Never freed, the blocks of its arenas may be freed by other threads.
+  ObIOBufferSlab *io_buffer_slab_;
+
 private:
   // prevent unauthorized copies (Not implemented)
   DISALLOW_COPY_AND_ASSIGN(ObEThread);
@@ -626,6 +652,20 @@ inline int ObEThread::schedule_local(ObEvent &event, const bool fast_signal)
   return ret;
 }
 
+inline ObEvent *ObEThread::schedule_imm_stealable(
+    ObContinuation *cont, const int callback_event, void *cookie)
+{
+  ObEvent *event = NULL;
+  if (OB_ISNULL(cont)) {
+    PROXY_EVENT_LOG(WDIAG, "argument is invalid", K(cont));
+  } else if (OB_ISNULL(event = schedule_common(*cont, 0, 0, callback_event, cookie,
+      &ObEThread::schedule_stealable))) {
+    PROXY_EVENT_LOG(WDIAG, "fail to schedule_common for schedule_imm_stealable");
+  } else {/*do nothing*/}
+
+  return event;
+}
+
 inline void ObEThread::free_event(ObEvent &event)
 {
   if (OB_UNLIKELY(event.in_the_priority_queue_) || OB_UNLIKELY(event.in_the_prot_queue_)) {
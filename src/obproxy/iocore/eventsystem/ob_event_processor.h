@@ -180,6 +180,15 @@ public:
                         const int callback_event = EVENT_IMMEDIATE,
                         void *cookie = NULL);
 
+  // provides the same functionality as schedule_imm, but when work stealing
+  // is enabled and the caller is a thread of event_type, keeps the event on
+  // the caller and lets idle threads steal it. The continuation must have
+  // its own mutex and must not depend on the thread it runs on.
+  ObEvent *schedule_imm_stealable(ObContinuation *cont,
+                                  const ObEventThreadType event_type = ET_CALL,
+                                  const int callback_event = EVENT_IMMEDIATE,
+                                  void *cookie = NULL);
+
   // provides the same functionality as schedule_imm and also signals the
   // thread immediately
   ObEvent *schedule_imm_signal(ObContinuation *cont,
@@ -363,6 +372,28 @@ public:
   volatile int64_t thread_data_used_;
   common::DRWLock lock_;
 
+  /**
+   * Regular threads sleep on their eventfd and are only woken up when they
+   * are really sleeping, instead of signaling the condition variable of
+   * the external event queue on every enqueue. Must be set before start().
+   */
+  bool enable_coalesced_wakeup_;
+
+  /**
+   * Idle regular threads steal the events scheduled by schedule_imm_stealable
+   * from the busy threads of the same type. Must be set before start().
+   */
+  bool enable_work_stealing_;
+
+  /**
+   * Regular threads allocate io buffer blocks from their own ObIOBufferSlab,
+   * whose arenas may be bound to the numa node of the thread and backed by
+   * transparent huge pages. Must be set before start().
+   */
+  bool enable_io_buffer_slab_;
+  bool io_buffer_slab_numa_local_;
+  bool io_buffer_slab_huge_page_;
+
 private:
   bool started_;
   DISALLOW_COPY_AND_ASSIGN(ObEventProcessor);
@@ -374,6 +405,11 @@ inline ObEventProcessor::ObEventProcessor()
       dedicate_thread_count_(0),
       thread_data_used_(0),
       lock_(),
+      enable_coalesced_wakeup_(false),
+      enable_work_stealing_(false),
+      enable_io_buffer_slab_(false),
+      io_buffer_slab_numa_local_(false),
+      io_buffer_slab_huge_page_(false),
       started_(false)
 {
   memset(all_event_threads_, 0, sizeof(all_event_threads_));
@@ -606,6 +642,21 @@ inline ObEvent *ObEventProcessor::schedule_every(
   return event;
 }
 
+inline ObEvent *ObEventProcessor::schedule_imm_stealable(
+    ObContinuation *cont, const ObEventThreadType etype,
+    const int callback_event, void *cookie)
+{
+  ObEvent *event = NULL;
+  ObEThread *ethread = this_ethread();
+  if (enable_work_stealing_ && NULL != ethread && REGULAR == ethread->tt_
+      && ethread->is_event_thread_type(etype)) {
+    event = ethread->schedule_imm_stealable(cont, callback_event, cookie);
+  } else {
+    event = schedule_imm(cont, etype, callback_event, cookie);
+  }
+  return event;
+}
+
 inline ObEvent *ObEventProcessor::prepare_schedule_imm(
     ObContinuation *cont, const ObEventThreadType etype,
     const int callback_event, void *cookie)
@@ -72,7 +72,8 @@ enum ObAllocType
 {
   NO_ALLOC,
   DEFAULT_ALLOC,
-  CONSTANT
+  CONSTANT,
+  SLAB_ALLOC
 };
 
 /**
@@ -87,6 +88,7 @@ enum ObAllocType
  * NO_ALLOC
  * DEFAULT_ALLOC
  * CONSTANT
+ * SLAB_ALLOC, from the ObIOBufferSlab of the allocating thread
  */
 class ObIOBufferData : public common::ObRefCountObj
 {
@@ -1303,7 +1305,13 @@ inline int ObIOBufferData::alloc(const int64_t size)
 #ifdef TRACK_BUFFER_USER
     iobuffer_mem_inc(location_, size_);
 #endif
-    data_ = static_cast<char *>(op_fixed_mem_alloc(size_));
+    ObEThread *ethread = this_ethread();
+    if (NULL != ethread && NULL != ethread->io_buffer_slab_
+        && NULL != (data_ = static_cast<char *>(ethread->io_buffer_slab_->alloc(size_)))) {
+      mem_type_ = SLAB_ALLOC;
+    } else {
+      data_ = static_cast<char *>(op_fixed_mem_alloc(size_));
+    }
     if (OB_ISNULL(data_)) {
       ret = common::OB_ALLOCATE_MEMORY_FAILED;
       PROXY_EVENT_LOG(EDIAG, "fail to allocate memory for ObIOBufferData", K(ret));
@@ -1321,6 +1329,12 @@ inline void ObIOBufferData::dealloc()
     iobuffer_mem_dec(location_, size_);
 #endif
     op_fixed_mem_free(data_, size_);
+  } else if (SLAB_ALLOC == mem_type_) {
+#ifdef TRACK_BUFFER_USER
+    iobuffer_mem_dec(location_, size_);
+#endif
+    ObEThread *ethread = this_ethread();
+    ObIOBufferSlab::free(data_, NULL == ethread ? NULL : ethread->io_buffer_slab_);
   }
 
   data_ = NULL;
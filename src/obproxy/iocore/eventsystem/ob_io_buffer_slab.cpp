@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+
+#define USING_LOG_PREFIX PROXY_EVENT
+
+#include "iocore/eventsystem/ob_io_buffer_slab.h"
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// the build host may have old headers without numaif.h
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace event
+{
+
+int ObIOBufferSlab::init(const bool numa_local, const bool huge_page)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WDIAG("init twice", K(ret));
+  } else if (OB_UNLIKELY(sizeof(ObIOBufferSlabArena) > DEFAULT_BUFFER_BASE_SIZE)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("arena header is larger than the smallest block", K(sizeof(ObIOBufferSlabArena)), K(ret));
+  } else {
+    numa_local_ = numa_local;
+    huge_page_ = huge_page;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+// The first block of an arena is taken by its header
+int ObIOBufferSlab::new_arena(const int64_t size_index)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = IO_BUFFER_SLAB_ARENA_SIZE;
+  char *buf = NULL;
+  char *start = NULL;
+  if (MAP_FAILED == (buf = static_cast<char *>(mmap(NULL, size * 2, PROT_READ | PROT_WRITE,
+                                                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WDIAG("fail to mmap io buffer slab arena", K(size), KERRMSGS, K(ret));
+  } else {
+    start = reinterpret_cast<char *>((reinterpret_cast<uint64_t>(buf) + size - 1) & ~static_cast<uint64_t>(size - 1));
+    if (start > buf) {
+      munmap(buf, start - buf);
+    }
+    if (buf + size > start) {
+      munmap(start + size, buf + size - start);
+    }
+
+    // before any page of the arena is touched
+    if (huge_page_ && 0 != madvise(start, size, MADV_HUGEPAGE)) {
+      LOG_DEBUG("fail to madvise MADV_HUGEPAGE for io buffer slab arena", KERRMSGS);
+    }
+    if (numa_local_) {
+      unsigned int cpu = 0;
+      unsigned int node = 0;
+      uint64_t node_mask = 0;
+      if (0 != syscall(SYS_getcpu, &cpu, &node, NULL) || node >= sizeof(node_mask) * 8) {
+        LOG_DEBUG("fail to get numa node of current thread", K(node), KERRMSGS);
+      } else if (FALSE_IT(node_mask = 1ULL << node)) {
+      } else if (0 != syscall(SYS_mbind, start, size, MPOL_PREFERRED, &node_mask, sizeof(node_mask) * 8, 0)) {
+        LOG_DEBUG("fail to mbind io buffer slab arena", K(node), KERRMSGS);
+      }
+    }
+
+    ObIOBufferSlabClass &sc = classes_[size_index];
+    ObIOBufferSlabArena *arena = reinterpret_cast<ObIOBufferSlabArena *>(start);
+    arena->owner_ = this;
+    arena->size_index_ = size_index;
+    arena->next_ = sc.arenas_;
+    sc.arenas_ = arena;
+    ++sc.arena_count_;
+    sc.cursor_ = start + BUFFER_SIZE_FOR_INDEX(size_index);
+    sc.end_ = start + size;
+  }
+  return ret;
+}
+
+void ObIOBufferSlab::take_remote_free(ObIOBufferSlabClass &sc)
+{
+  void *head = ATOMIC_TAS(&sc.remote_free_list_, NULL);
+  if (NULL != head) {
+    int64_t count = 1;
+    void *tail = head;
+    while (NULL != *reinterpret_cast<void **>(tail)) {
+      tail = *reinterpret_cast<void **>(tail);
+      ++count;
+    }
+    *reinterpret_cast<void **>(tail) = sc.free_list_;
+    sc.free_list_ = head;
+    sc.used_count_ -= count;
+  }
+}
+
+void ObIOBufferSlab::get_usage(const int64_t size_index, int64_t &hold, int64_t &used, int64_t &count) const
+{
+  hold = 0;
+  used = 0;
+  count = 0;
+  if (size_index >= 0 && size_index < BUFFER_SIZE_INDEX_COUNT) {
+    const ObIOBufferSlabClass &sc = classes_[size_index];
+    hold = ATOMIC_LOAD(&sc.arena_count_) * IO_BUFFER_SLAB_ARENA_SIZE;
+    count = ATOMIC_LOAD(&sc.used_count_);
+    used = count * BUFFER_SIZE_FOR_INDEX(size_index);
+  }
+}
+
+} // end of namespace event
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+
+#ifndef OBPROXY_IO_BUFFER_SLAB_H
+#define OBPROXY_IO_BUFFER_SLAB_H
+
+#include "iocore/eventsystem/ob_buf_allocator.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace event
+{
+
+#define IO_BUFFER_SLAB_ARENA_SIZE    (2 * 1024 * 1024)
+
+class ObIOBufferSlab;
+
+// Header at the start of each arena. Blocks of one arena are of the same size
+// class, the arena of a block is found by rounding its address down.
+struct ObIOBufferSlabArena
+{
+  ObIOBufferSlab *owner_;
+  int64_t size_index_;
+  ObIOBufferSlabArena *next_;
+};
+
+struct ObIOBufferSlabClass
+{
+  ObIOBufferSlabClass()
+      : free_list_(NULL), cursor_(NULL), end_(NULL), arenas_(NULL),
+        arena_count_(0), used_count_(0), remote_free_list_(NULL) { }
+
+  // only touched by the owner thread
+  void *free_list_;
+  char *cursor_;
+  char *end_;
+  ObIOBufferSlabArena *arenas_;
+  int64_t arena_count_;
+  // blocks freed by other threads are counted until the owner takes them back
+  int64_t used_count_;
+
+  // pushed by other threads and taken all at once by the owner, so there is no ABA
+  void *volatile remote_free_list_ CACHE_ALIGNED;
+} CACHE_ALIGNED;
+
+// Slab of io buffer blocks owned by one event thread.
+//
+// Each size class of ObBufAllocator has its own arenas of
+// IO_BUFFER_SLAB_ARENA_SIZE, aligned to their size. The owner allocates and
+// frees without any atomic operation, blocks freed by other threads go to a
+// lock free list of their class and are taken back by the owner when its own
+// free list is empty. Freed blocks are kept in the slab, as the free lists of
+// ObBufAllocator do, arenas are never given back.
+class ObIOBufferSlab
+{
+public:
+  ObIOBufferSlab() : is_inited_(false), numa_local_(false), huge_page_(false) { }
+  ~ObIOBufferSlab() { }
+
+  int init(const bool numa_local, const bool huge_page);
+
+  // called by the owner thread only, NULL if the size is larger than the
+  // largest size class or no memory
+  void *alloc(const int64_t size);
+
+  // called by any thread, slab is the one of the calling thread, maybe NULL
+  static void free(void *ptr, ObIOBufferSlab *slab);
+
+  // memory held by arenas and used by blocks of a size class, approximate
+  // if called by other threads
+  void get_usage(const int64_t size_index, int64_t &hold, int64_t &used, int64_t &count) const;
+
+private:
+  int new_arena(const int64_t size_index);
+  void take_remote_free(ObIOBufferSlabClass &sc);
+
+  static int64_t size_to_index(const int64_t size)
+  {
+    return size > DEFAULT_BUFFER_BASE_SIZE
+           ? (8 * sizeof(int64_t) - __builtin_clzll(size - 1)) - DEFAULT_BUFFER_BASE_SHIFT : 0;
+  }
+
+private:
+  bool is_inited_;
+  bool numa_local_;
+  bool huge_page_;
+  ObIOBufferSlabClass classes_[BUFFER_SIZE_INDEX_COUNT];
+
+  DISALLOW_COPY_AND_ASSIGN(ObIOBufferSlab);
+};
+
+inline void *ObIOBufferSlab::alloc(const int64_t size)
+{
+  void *ret = NULL;
+  if (OB_LIKELY(is_inited_) && OB_LIKELY(size > 0) && OB_LIKELY(size <= DEFAULT_MAX_BUFFER_SIZE)) {
+    const int64_t index = size_to_index(size);
+    ObIOBufferSlabClass &sc = classes_[index];
+    if (NULL == sc.free_list_ && NULL != ATOMIC_LOAD(&sc.remote_free_list_)) {
+      take_remote_free(sc);
+    }
+    if (NULL != (ret = sc.free_list_)) {
+      sc.free_list_ = *reinterpret_cast<void **>(ret);
+    } else if (sc.cursor_ < sc.end_ || common::OB_SUCCESS == new_arena(index)) {
+      ret = sc.cursor_;
+      sc.cursor_ += BUFFER_SIZE_FOR_INDEX(index);
+    }
+    if (NULL != ret) {
+      ++sc.used_count_;
+    }
+  }
+  return ret;
+}
+
+inline void ObIOBufferSlab::free(void *ptr, ObIOBufferSlab *slab)
+{
+  ObIOBufferSlabArena *arena = reinterpret_cast<ObIOBufferSlabArena *>(
+      reinterpret_cast<uint64_t>(ptr) & ~static_cast<uint64_t>(IO_BUFFER_SLAB_ARENA_SIZE - 1));
+  ObIOBufferSlabClass &sc = arena->owner_->classes_[arena->size_index_];
+  if (arena->owner_ == slab) {
+    *reinterpret_cast<void **>(ptr) = sc.free_list_;
+    sc.free_list_ = ptr;
+    --sc.used_count_;
+  } else {
+    void *head = NULL;
+    do {
+      head = ATOMIC_LOAD(&sc.remote_free_list_);
+      *reinterpret_cast<void **>(ptr) = head;
+    } while (!ATOMIC_BCAS(&sc.remote_free_list_, head, ptr));
+  }
+}
+
+} // end of namespace event
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_IO_BUFFER_SLAB_H
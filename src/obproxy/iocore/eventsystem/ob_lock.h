@@ -133,6 +133,23 @@ namespace event
  */
 #define MUTEX_RELEASE(l) (l).release()
 
+/**
+ * Attempts to acquire the lock without a scoped lock variable.
+ * The caller owns the lock until MUTEX_UNTAKE_LOCK is called, it is
+ * used when the lock must be held across several handler steps, such
+ * as an io_uring submission and its completion.
+ *
+ * @param m A pointer to (or address of) a ObProxyMutex object
+ * @param t The current ObEThread executing your code.
+ */
+#ifdef OB_HAS_EVENT_DEBUG
+#define MUTEX_TAKE_TRY_LOCK(m, t) \
+  oceanbase::obproxy::event::mutex_trylock(MAKE_LOCATION(), reinterpret_cast<char*>(NULL), m, t)
+#else
+#define MUTEX_TAKE_TRY_LOCK(m, t) oceanbase::obproxy::event::mutex_trylock(m, t)
+#endif //OB_HAS_EVENT_DEBUG
+#define MUTEX_UNTAKE_LOCK(m, t) oceanbase::obproxy::event::mutex_unlock(m, t)
+
 class ObEThread;
 typedef ObEThread *ObEThreadPtr;
 
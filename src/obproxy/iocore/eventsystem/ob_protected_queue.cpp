@@ -31,6 +31,7 @@
 
 #define USING_LOG_PREFIX PROXY_EVENT
 
+#include <poll.h>
 #include "iocore/eventsystem/ob_event_system.h"
 #include "iocore/net/ob_unix_net.h"
 
@@ -72,16 +73,25 @@ void ObProtectedQueue::enqueue(ObEvent *e, const bool fast_signal)
         if (OB_FAIL(signal())) {
           LOG_WDIAG("fail to do signal, it should not happened", K(ret));
         }
-        if (NULL != e_ethread->net_poll_) {
+        if (is_coalesced_wakeup()) {
+          // signal() has written the eventfd which the net poll also waits on
+        } else if (NULL != e_ethread->net_poll_) {
           e_ethread->get_net_poll().timerfd_settime();
         }
-        if (fast_signal) {
+        if (fast_signal && !is_coalesced_wakeup()) {
           if (NULL != e_ethread->signal_hook_) {
             e_ethread->signal_hook_(*e_ethread);
           }
         }
       } else {
         bool need_break = false;
+        if (fast_signal && is_coalesced_wakeup()) {
+          // cheap when the target thread is awake, no need to defer it
+          if (OB_FAIL(signal())) {
+            LOG_WDIAG("fail to do signal, it should not happened", K(ret));
+          }
+          need_break = true;
+        }
 #ifdef EAGER_SIGNALLING
         // Try to signal now and avoid deferred posting.
         if (OB_SUCC(e_ethread->event_queue_external_.try_signal())) {
@@ -172,11 +182,15 @@ void flush_signals(ObEThread *thr)
         if (OB_FAIL(thr->ethreads_to_be_signalled_[i]->event_queue_external_.signal())) {
           LOG_WDIAG("failed to do signal, it should not happened", K(ret));
         }
-        if (NULL != thr->ethreads_to_be_signalled_[i]->net_poll_) {
-          thr->ethreads_to_be_signalled_[i]->get_net_poll().timerfd_settime();
-        }
-        if (NULL != thr->ethreads_to_be_signalled_[i]->signal_hook_) {
-          thr->ethreads_to_be_signalled_[i]->signal_hook_(*(thr->ethreads_to_be_signalled_[i]));
+        if (thr->ethreads_to_be_signalled_[i]->event_queue_external_.is_coalesced_wakeup()) {
+          // the eventfd written by signal() also wakes up the net poll
+        } else {
+          if (NULL != thr->ethreads_to_be_signalled_[i]->net_poll_) {
+            thr->ethreads_to_be_signalled_[i]->get_net_poll().timerfd_settime();
+          }
+          if (NULL != thr->ethreads_to_be_signalled_[i]->signal_hook_) {
+            thr->ethreads_to_be_signalled_[i]->signal_hook_(*(thr->ethreads_to_be_signalled_[i]));
+          }
         }
         thr->ethreads_to_be_signalled_[i] = NULL;
       }
@@ -189,7 +203,25 @@ int ObProtectedQueue::dequeue_timed(const ObHRTime timeout, const bool need_slee
 {
   ObEvent *e = NULL;
   int ret = OB_SUCCESS;
-  if (need_sleep) {
+  if (need_sleep && is_coalesced_wakeup()) {
+    if (prepare_sleep()) {
+      const ObHRTime sleep_time = timeout - get_hrtime_internal();
+      if (sleep_time > 0) {
+        struct pollfd pfd;
+        pfd.fd = wakeup_fd_;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(sleep_time / HRTIME_SECOND);
+        ts.tv_nsec = static_cast<long>(sleep_time % HRTIME_SECOND);
+        uint64_t counter = 0;
+        if (::ppoll(&pfd, 1, &ts, NULL) > 0 && ::read(wakeup_fd_, &counter, sizeof(counter)) < 0) {
+          LOG_DEBUG("fail to read wakeup fd", K_(wakeup_fd), KERRMSGS);
+        }
+      }
+      finish_sleep();
+    }
+  } else if (need_sleep) {
     if (OB_FAIL(mutex_acquire(&lock_))) {
       LOG_EDIAG("failed to acquire mutex", K(ret));
     } else {
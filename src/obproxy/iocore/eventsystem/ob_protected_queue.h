@@ -35,6 +35,12 @@
  * (2). In case the queue is empty, dequeue() sleeps for a specified
  *      amount of time, or until a new element is inserted, whichever
  *      is earlier
+ *
+ * Producers push to atomic_list_ lock free, and only the owner thread pops
+ * all of them at once, so the mutex is only used for sleeping and signaling.
+ * If a wakeup fd is set, the owner sleeps on the eventfd instead of the
+ * condition variable, and producers write the eventfd only when the owner
+ * is really sleeping, at most once for each sleep.
  */
 
 #ifndef OBPROXY_PROTECTED_QUEUE_H
@@ -52,7 +58,8 @@ namespace event
 class ObProtectedQueue
 {
 public:
-  ObProtectedQueue() : is_inited_(false), atomic_list_size_(0), local_queue_size_(0) {}
+  ObProtectedQueue()
+    : is_inited_(false), wakeup_fd_(-1), sleeping_(false), atomic_list_size_(0), local_queue_size_(0) {}
   ~ObProtectedQueue() { }
 
   int init();
@@ -66,8 +73,19 @@ public:
   int64_t get_atomic_list_size() const { return atomic_list_size_; };
   int64_t get_local_queue_size() const { return local_queue_size_; };
 
+  // eventfd of the owner thread, set before the thread runs
+  void set_wakeup_fd(const int fd) { wakeup_fd_ = fd; }
+  bool is_coalesced_wakeup() const { return wakeup_fd_ >= 0; }
+  // called by the owner thread before it sleeps on the wakeup fd (e.g. in epoll_wait),
+  // return false if there are events already and it should not sleep
+  bool prepare_sleep();
+  void finish_sleep() { ATOMIC_STORE(&sleeping_, false); }
+
 public:
   bool is_inited_;
+  int wakeup_fd_;
+  // the owner thread is sleeping or going to sleep on wakeup_fd_
+  volatile bool sleeping_;
   common::ObAtomicList atomic_list_;
   ObMutex lock_;
   ObProxyThreadCond might_have_data_;
@@ -95,11 +113,34 @@ inline int ObProtectedQueue::init()
   return ret;
 }
 
+inline bool ObProtectedQueue::prepare_sleep()
+{
+  bool bret = true;
+  ATOMIC_STORE(&sleeping_, true);
+  // pairs with the barrier of atomic_list_.push() in enqueue(), either the owner
+  // sees the new event here, or the producer sees sleeping_ and wakes it up
+  __sync_synchronize();
+  if (!atomic_list_.empty()) {
+    ATOMIC_STORE(&sleeping_, false);
+    bret = false;
+  }
+  return bret;
+}
+
 inline int ObProtectedQueue::signal()
 {
   int ret = common::OB_SUCCESS;
-  // Need to get the lock before you can signal the thread
-  if (OB_FAIL(common::mutex_acquire(&lock_))) {
+  if (wakeup_fd_ >= 0) {
+    // only the producer who clears sleeping_ writes the eventfd,
+    // an awake owner will see the event before it sleeps again
+    if (ATOMIC_LOAD(&sleeping_) && ATOMIC_BCAS(&sleeping_, true, false)) {
+      uint64_t counter = 1;
+      if (OB_UNLIKELY(static_cast<ssize_t>(sizeof(counter)) != ::write(wakeup_fd_, &counter, sizeof(counter)))) {
+        ret = common::OB_ERR_SYS;
+        PROXY_EVENT_LOG(WDIAG, "fail to write wakeup fd", K_(wakeup_fd), KERRMSGS, K(ret));
+      }
+    }
+  } else if (OB_FAIL(common::mutex_acquire(&lock_))) {
     PROXY_EVENT_LOG(EDIAG, "failed to acquire lock", K(ret));
   } else {
     if (OB_FAIL(cond_signal(&might_have_data_))) {
@@ -117,8 +158,10 @@ inline int ObProtectedQueue::signal()
 inline int ObProtectedQueue::try_signal()
 {
   int ret = common::OB_SUCCESS;
-  // Need to get the lock before you can signal the thread
-  if (common::mutex_try_acquire(&lock_)) {
+  if (wakeup_fd_ >= 0) {
+    ret = signal();
+  } else if (common::mutex_try_acquire(&lock_)) {
+    // Need to get the lock before you can signal the thread
     if (OB_FAIL(cond_signal(&might_have_data_))) {
       PROXY_EVENT_LOG(WDIAG, "failed to call cond_signal",  K(ret));
     }
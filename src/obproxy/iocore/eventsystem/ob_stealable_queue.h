@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_STEALABLE_QUEUE_H
+#define OBPROXY_STEALABLE_QUEUE_H
+
+#include "iocore/eventsystem/ob_event.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace event
+{
+
+// Immediate events of one thread which idle threads of the same type may steal.
+//
+// The owner pushes and pops at the head, so the event it scheduled last, whose
+// data is most likely still in cache, runs first. Thieves take the oldest event
+// from the tail. Only continuations which are not bound to a thread are put
+// here, and the queue is short, so a mutex is enough. Thieves only try lock it
+// and never make the owner wait for long.
+class ObStealableQueue
+{
+public:
+  ObStealableQueue() : is_inited_(false), size_(0) {}
+  ~ObStealableQueue() { }
+
+  int init();
+  // called by the owner thread only
+  void push(ObEvent *e);
+  ObEvent *pop();
+  // called by other threads, return NULL if the queue is empty or busy
+  ObEvent *steal();
+  int64_t get_size() const { return ATOMIC_LOAD(&size_); }
+
+public:
+  bool is_inited_;
+  volatile int64_t size_;
+  ObMutex lock_;
+  Que(ObEvent, link_) queue_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObStealableQueue);
+};
+
+inline int ObStealableQueue::init()
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_FAIL(common::mutex_init(&lock_))) {
+    PROXY_EVENT_LOG(WDIAG, "fail to init mutex", K(ret));
+  } else {
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+inline void ObStealableQueue::push(ObEvent *e)
+{
+  if (OB_LIKELY(common::OB_SUCCESS == common::mutex_acquire(&lock_))) {
+    queue_.push(e);
+    ATOMIC_INC(&size_);
+    common::mutex_release(&lock_);
+  }
+}
+
+inline ObEvent *ObStealableQueue::pop()
+{
+  ObEvent *e = NULL;
+  if (get_size() > 0 && OB_LIKELY(common::OB_SUCCESS == common::mutex_acquire(&lock_))) {
+    if (NULL != (e = queue_.pop())) {
+      ATOMIC_DEC(&size_);
+    }
+    common::mutex_release(&lock_);
+  }
+  return e;
+}
+
+inline ObEvent *ObStealableQueue::steal()
+{
+  ObEvent *e = NULL;
+  if (get_size() > 0 && common::mutex_try_acquire(&lock_)) {
+    if (NULL != (e = queue_.tail_)) {
+      queue_.remove(e);
+      ATOMIC_DEC(&size_);
+    }
+    common::mutex_release(&lock_);
+  }
+  return e;
+}
+
+} // end of namespace event
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_STEALABLE_QUEUE_H
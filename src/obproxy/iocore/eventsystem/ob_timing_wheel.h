@@ -0,0 +1,221 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_TIMING_WHEEL_H
+#define OBPROXY_TIMING_WHEEL_H
+
+#include "utils/ob_proxy_lib.h"
+#include "lib/list/ob_intrusive_list.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace event
+{
+
+// Hierarchical timing wheel of intrusive elements, owned by one thread.
+//
+// Level i has WHEEL_SLOT_COUNT slots of (tick << (WHEEL_SLOT_BITS * i)) each.
+// Schedule, remove and expire of one element are O(1), elements of a higher
+// level are moved down when the lower level wraps around. Elements further
+// than the top level are put into its farthest slot and scheduled again when
+// they come down to level 0.
+//
+// C must have "ObHRTime wheel_expire_at_" and "int32_t wheel_slot_", the slot
+// is -1 if the element is not in the wheel. L is the link of the slot lists.
+template <class C, class L>
+class ObTimingWheel
+{
+public:
+  static const int64_t WHEEL_SLOT_BITS = 6;
+  static const int64_t WHEEL_SLOT_COUNT = 1 << WHEEL_SLOT_BITS;
+  static const int64_t WHEEL_SLOT_MASK = WHEEL_SLOT_COUNT - 1;
+  static const int64_t WHEEL_LEVEL_COUNT = 4;
+
+  ObTimingWheel() : tick_(0), current_tick_(0), count_(0) { memset(bitmap_, 0, sizeof(bitmap_)); }
+  ~ObTimingWheel() { }
+
+  int init(const ObHRTime tick, const ObHRTime now);
+  bool is_inited() const { return tick_ > 0; }
+
+  // expire_at is rounded up to the tick, an element never expires early
+  void schedule(C *c, const ObHRTime expire_at);
+  void remove(C *c);
+  bool in(const C *c) const { return c->wheel_slot_ >= 0; }
+
+  // move all elements whose tick is not after now to expired
+  void advance(const ObHRTime now, common::Queue<C, L> &expired);
+
+  // time when advance() will have work to do next, INT64_MAX if empty
+  ObHRTime next_expire_time() const;
+  int64_t get_count() const { return count_; }
+
+private:
+  void cascade(const int64_t level);
+  void expire_slot(const int64_t slot, common::Queue<C, L> &expired);
+
+private:
+  ObHRTime tick_;
+  // all ticks before current_tick_ have been expired
+  int64_t current_tick_;
+  int64_t count_;
+  uint64_t bitmap_[WHEEL_LEVEL_COUNT];
+  common::Queue<C, L> slots_[WHEEL_LEVEL_COUNT][WHEEL_SLOT_COUNT];
+
+  DISALLOW_COPY_AND_ASSIGN(ObTimingWheel);
+};
+
+template <class C, class L>
+int ObTimingWheel<C, L>::init(const ObHRTime tick, const ObHRTime now)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_UNLIKELY(tick <= 0) || OB_UNLIKELY(now < 0)) {
+    ret = common::OB_INVALID_ARGUMENT;
+    PROXY_EVENT_LOG(WDIAG, "invalid argument", K(tick), K(now), K(ret));
+  } else if (OB_UNLIKELY(is_inited())) {
+    ret = common::OB_INIT_TWICE;
+    PROXY_EVENT_LOG(WDIAG, "init twice", K(tick_), K(ret));
+  } else {
+    tick_ = tick;
+    current_tick_ = now / tick;
+  }
+  return ret;
+}
+
+template <class C, class L>
+inline void ObTimingWheel<C, L>::schedule(C *c, const ObHRTime expire_at)
+{
+  if (in(c)) {
+    remove(c);
+  }
+
+  int64_t t = (expire_at + tick_ - 1) / tick_;
+  if (t < current_tick_) {
+    t = current_tick_;
+  }
+  int64_t delta = t - current_tick_;
+  int64_t level = 0;
+  while (level < WHEEL_LEVEL_COUNT - 1 && delta >= (WHEEL_SLOT_COUNT << (WHEEL_SLOT_BITS * level))) {
+    ++level;
+  }
+  if (OB_UNLIKELY(delta >= (WHEEL_SLOT_COUNT << (WHEEL_SLOT_BITS * level)))) {
+    t = current_tick_ + (WHEEL_SLOT_COUNT << (WHEEL_SLOT_BITS * level)) - 1;
+  }
+
+  const int64_t index = (t >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK;
+  c->wheel_expire_at_ = expire_at;
+  c->wheel_slot_ = static_cast<int32_t>((level << WHEEL_SLOT_BITS) | index);
+  slots_[level][index].push(c);
+  bitmap_[level] |= (1ULL << index);
+  ++count_;
+}
+
+template <class C, class L>
+inline void ObTimingWheel<C, L>::remove(C *c)
+{
+  if (in(c)) {
+    const int64_t level = c->wheel_slot_ >> WHEEL_SLOT_BITS;
+    const int64_t index = c->wheel_slot_ & WHEEL_SLOT_MASK;
+    slots_[level][index].remove(c);
+    if (slots_[level][index].empty()) {
+      bitmap_[level] &= ~(1ULL << index);
+    }
+    c->wheel_slot_ = -1;
+    --count_;
+  }
+}
+
+template <class C, class L>
+void ObTimingWheel<C, L>::cascade(const int64_t level)
+{
+  const int64_t index = (current_tick_ >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK;
+  if (0 != (bitmap_[level] & (1ULL << index))) {
+    common::Queue<C, L> q = slots_[level][index];
+    slots_[level][index].reset();
+    bitmap_[level] &= ~(1ULL << index);
+    C *c = NULL;
+    while (NULL != (c = q.pop())) {
+      c->wheel_slot_ = -1;
+      --count_;
+      schedule(c, c->wheel_expire_at_);
+    }
+  }
+}
+
+template <class C, class L>
+void ObTimingWheel<C, L>::expire_slot(const int64_t index, common::Queue<C, L> &expired)
+{
+  C *c = NULL;
+  while (NULL != (c = slots_[0][index].pop())) {
+    c->wheel_slot_ = -1;
+    --count_;
+    expired.enqueue(c);
+  }
+  bitmap_[0] &= ~(1ULL << index);
+}
+
+template <class C, class L>
+void ObTimingWheel<C, L>::advance(const ObHRTime now, common::Queue<C, L> &expired)
+{
+  const int64_t target = now / tick_;
+  int64_t index = 0;
+  uint64_t rest = 0;
+  while (current_tick_ <= target) {
+    if (0 == count_) {
+      current_tick_ = target + 1;
+    } else {
+      index = current_tick_ & WHEEL_SLOT_MASK;
+      // move the slots of higher levels which start from this tick down
+      for (int64_t level = 1; level < WHEEL_LEVEL_COUNT
+           && 0 == ((current_tick_ >> (WHEEL_SLOT_BITS * (level - 1))) & WHEEL_SLOT_MASK); ++level) {
+        cascade(level);
+      }
+      if (0 != (bitmap_[0] & (1ULL << index))) {
+        expire_slot(index, expired);
+      }
+      // skip the empty slots up to the end of this round of level 0
+      rest = (WHEEL_SLOT_MASK == index) ? 0 : (bitmap_[0] >> (index + 1) << (index + 1));
+      if (0 != rest) {
+        current_tick_ += __builtin_ctzll(rest) - index;
+      } else {
+        current_tick_ += WHEEL_SLOT_COUNT - index;
+      }
+      if (current_tick_ > target + 1) {
+        current_tick_ = target + 1;
+      }
+    }
+  }
+}
+
+template <class C, class L>
+ObHRTime ObTimingWheel<C, L>::next_expire_time() const
+{
+  ObHRTime ret = INT64_MAX;
+  if (count_ > 0) {
+    const int64_t index = current_tick_ & WHEEL_SLOT_MASK;
+    const uint64_t rest = bitmap_[0] >> index << index;
+    if (0 != rest) {
+      ret = (current_tick_ + __builtin_ctzll(rest) - index) * tick_;
+    } else {
+      // level 0 is empty up to the end of this round, wake up for the cascade
+      ret = (current_tick_ + WHEEL_SLOT_COUNT - index) * tick_;
+    }
+  }
+  return ret;
+}
+
+} // end of namespace event
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_TIMING_WHEEL_H
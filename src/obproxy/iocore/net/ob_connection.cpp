@@ -471,6 +471,19 @@ int ObServerConnection::setup_fd_for_listen_proxy_mode(
     PROXY_SOCK_LOG(WDIAG, "fail to set sockopt SO_REUSEADDR", K(fd_), K(ret));
   }
 
+#ifdef SO_REUSEPORT
+  if (OB_SUCC(ret) && reuse_port_
+      && OB_FAIL(ObSocketManager::setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT,
+      reinterpret_cast<const void *>(&SOCKOPT_ON), sizeof(SOCKOPT_ON)))) {
+    PROXY_SOCK_LOG(WDIAG, "fail to set sockopt SO_REUSEPORT", K(fd_), K(ret));
+  }
+#else
+  if (OB_SUCC(ret) && reuse_port_) {
+    ret = OB_NOT_SUPPORTED;
+    PROXY_SOCK_LOG(WDIAG, "SO_REUSEPORT is not supported", K(fd_), K(ret));
+  }
+#endif
+
 #ifdef SET_TCP_NO_DELAY
   if (OB_SUCC(ret) && OB_FAIL(ObSocketManager::setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY,
       reinterpret_cast<const void *>(&SOCKOPT_ON), sizeof(SOCKOPT_ON)))) {
@@ -619,6 +632,38 @@ int ObServerConnection::listen_proxy_mode(const bool non_blocking, const int32_t
   return ret;
 }
 
+int ObServerConnection::listen_reuse_port(const ObIpEndpoint &bound_addr, const bool non_blocking,
+                                          const int32_t recv_bufsize, const int32_t send_bufsize)
+{
+  int ret = OB_SUCCESS;
+  reuse_port_ = true;
+  ops_ip_copy(addr_, bound_addr);
+
+  if (OB_UNLIKELY(RUN_MODE_PROXY != g_run_mode) || OB_UNLIKELY(!ops_is_ip(bound_addr))) {
+    ret = OB_NOT_SUPPORTED;
+    PROXY_SOCK_LOG(WDIAG, "reuse port is only supported by tcp socket", K(bound_addr), K(ret));
+  } else if (OB_FAIL(ObSocketManager::socket(addr_.sa_.sa_family, SOCK_STREAM, IPPROTO_TCP, fd_))) {
+    PROXY_SOCK_LOG(WDIAG, "fail to create socket", K(addr_), KERRMSGS, K(ret));
+  } else if (OB_FAIL(setup_fd_for_listen_proxy_mode(non_blocking, recv_bufsize, send_bufsize))) {
+    PROXY_SOCK_LOG(WDIAG, "fail to setup_fd_for_listen", K(addr_), K(ret));
+  } else if (OB_FAIL(ObSocketManager::bind(fd_, &addr_.sa_,
+      static_cast<int64_t>(ops_ip_size(addr_.sa_))))) {
+    PROXY_SOCK_LOG(WDIAG, "fail to bind", K(addr_), KERRMSGS, K(ret));
+  } else if (OB_FAIL(ObSocketManager::listen(fd_, LISTEN_BACKLOG))) {
+    PROXY_SOCK_LOG(WDIAG, "fail to listen", K(addr_), KERRMSGS, K(ret));
+  }
+
+  if (OB_FAIL(ret) && NO_FD != fd_) {
+    // make coverity happy
+    int tmp_ret = ret;
+    if (OB_FAIL(close())) {
+      PROXY_SOCK_LOG(WDIAG, "fail to close server connection", K(ret));
+    }
+    ret = tmp_ret;
+  }
+  return ret;
+}
+
 } // end of namespace net
 } // end of namespace obproxy
 } // end of namespace oceanbase
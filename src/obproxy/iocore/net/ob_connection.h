@@ -127,7 +127,7 @@ class ObServerConnection : public ObConnection
 {
 public:
   ObServerConnection()
-      : ObConnection()
+      : ObConnection(), reuse_port_(false)
   {
     ob_zero(accept_addr_);
   }
@@ -155,9 +155,29 @@ public:
              const int32_t recv_bufsize = 0,
              const int32_t send_bufsize = 0);
 
+  /**
+   * Open one more SO_REUSEPORT listen socket on the address which
+   * has already been bound by another reuse port socket. The socket
+   * is owned by a single net thread and is not passed to the new
+   * process on hot upgrade.
+   *
+   * @param bound_addr  address the first socket bound to
+   * @param non_blocking
+   * @param recv_bufsize
+   * @param send_bufsize
+   *
+   * @return
+   */
+  int listen_reuse_port(const ObIpEndpoint &bound_addr,
+                        const bool non_blocking = false,
+                        const int32_t recv_bufsize = 0,
+                        const int32_t send_bufsize = 0);
+
 public:
   // Client side (inbound) local IP address.
   ObIpEndpoint accept_addr_;
+  // set SO_REUSEPORT before bind
+  bool reuse_port_;
 
 private:
   int setup_fd_for_listen_proxy_mode(
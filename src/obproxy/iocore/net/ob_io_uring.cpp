@@ -0,0 +1,305 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_NET
+
+#include <sys/mman.h>
+#include "iocore/net/ob_io_uring.h"
+#include "lib/atomic/ob_atomic.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+ObIOUring::ObIOUring()
+    : ring_fd_(-1), sq_entries_(0), cq_entries_(0), sqe_head_(0), sqe_tail_(0),
+      sq_ring_ptr_(MAP_FAILED), sq_ring_size_(0), cq_ring_ptr_(MAP_FAILED), cq_ring_size_(0),
+      sqes_ptr_(MAP_FAILED), sqes_size_(0), sq_head_(NULL), sq_tail_(NULL),
+      sq_ring_mask_(NULL), sq_array_(NULL), cq_head_(NULL), cq_tail_(NULL),
+      cq_ring_mask_(NULL), cqes_(NULL)
+{
+}
+
+#ifdef OB_HAVE_IO_URING
+
+#ifndef RWF_NOWAIT
+#define RWF_NOWAIT 0x00000008
+#endif
+
+int ObIOUring::init(const uint32_t entries)
+{
+  int ret = OB_SUCCESS;
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  if (OB_UNLIKELY(is_inited())) {
+    ret = OB_INIT_TWICE;
+    LOG_WDIAG("io_uring init twice", K_(ring_fd), K(ret));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid argument", K(entries), K(ret));
+  } else if (OB_UNLIKELY((ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params))) < 0)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_INFO("io_uring_setup failed, kernel may not support io_uring", K(entries), KERRMSGS, K(ret));
+    ring_fd_ = -1;
+  } else {
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    const bool single_mmap = (0 != (params.features & IORING_FEAT_SINGLE_MMAP));
+    if (single_mmap) {
+      sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+      cq_ring_size_ = sq_ring_size_;
+    }
+
+    if (MAP_FAILED == (sq_ring_ptr_ = mmap(NULL, sq_ring_size_, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING))) {
+      ret = ob_get_sys_errno();
+      LOG_WDIAG("fail to mmap io_uring sq ring", K_(sq_ring_size), KERRMSGS, K(ret));
+    } else if (single_mmap) {
+      cq_ring_ptr_ = sq_ring_ptr_;
+    } else if (MAP_FAILED == (cq_ring_ptr_ = mmap(NULL, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING))) {
+      ret = ob_get_sys_errno();
+      LOG_WDIAG("fail to mmap io_uring cq ring", K_(cq_ring_size), KERRMSGS, K(ret));
+    }
+
+    if (OB_SUCC(ret)) {
+      if (MAP_FAILED == (sqes_ptr_ = mmap(NULL, sqes_size_, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES))) {
+        ret = ob_get_sys_errno();
+        LOG_WDIAG("fail to mmap io_uring sqes", K_(sqes_size), KERRMSGS, K(ret));
+      } else {
+        char *sq_ptr = static_cast<char *>(sq_ring_ptr_);
+        char *cq_ptr = static_cast<char *>(cq_ring_ptr_);
+        sq_head_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.tail);
+        sq_ring_mask_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.array);
+        cq_head_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.tail);
+        cq_ring_mask_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.ring_mask);
+        cqes_ = cq_ptr + params.cq_off.cqes;
+        sqe_head_ = *sq_tail_;
+        sqe_tail_ = sqe_head_;
+        LOG_INFO("succ to init io_uring", K_(ring_fd), K_(sq_entries), K_(cq_entries),
+                 "features", params.features);
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+      destroy();
+    }
+  }
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+  if (MAP_FAILED != sqes_ptr_) {
+    munmap(sqes_ptr_, sqes_size_);
+    sqes_ptr_ = MAP_FAILED;
+  }
+  if (MAP_FAILED != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  cq_ring_ptr_ = MAP_FAILED;
+  if (MAP_FAILED != sq_ring_ptr_) {
+    munmap(sq_ring_ptr_, sq_ring_size_);
+    sq_ring_ptr_ = MAP_FAILED;
+  }
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  sq_head_ = NULL;
+  sq_tail_ = NULL;
+  sq_ring_mask_ = NULL;
+  sq_array_ = NULL;
+  cq_head_ = NULL;
+  cq_tail_ = NULL;
+  cq_ring_mask_ = NULL;
+  cqes_ = NULL;
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  sqe_head_ = 0;
+  sqe_tail_ = 0;
+}
+
+struct io_uring_sqe *ObIOUring::get_sqe()
+{
+  struct io_uring_sqe *sqe = NULL;
+  // the kernel advances sq head when it consumes sqes
+  const uint32_t head = ATOMIC_LOAD_ACQ(sq_head_);
+  if (OB_LIKELY(sqe_tail_ - head < sq_entries_)) {
+    sqe = static_cast<struct io_uring_sqe *>(sqes_ptr_) + (sqe_tail_ & *sq_ring_mask_);
+    ++sqe_tail_;
+    memset(sqe, 0, sizeof(*sqe));
+  }
+  return sqe;
+}
+
+int ObIOUring::prep_rw(const uint8_t opcode, const int fd, const struct iovec *iov,
+                       const int32_t niov, const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+  struct io_uring_sqe *sqe = NULL;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(fd < 0) || OB_ISNULL(iov) || OB_UNLIKELY(niov <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid argument", K(fd), K(iov), K(niov), K(ret));
+  } else if (OB_ISNULL(sqe = get_sqe())) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->off = 0;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = static_cast<uint32_t>(niov);
+    // never block in the kernel, a socket without data completes with -EAGAIN
+    sqe->rw_flags = RWF_NOWAIT;
+    sqe->user_data = user_data;
+  }
+  return ret;
+}
+
+int ObIOUring::prep_readv(const int fd, const struct iovec *iov, const int32_t niov, const uint64_t user_data)
+{
+  return prep_rw(IORING_OP_READV, fd, iov, niov, user_data);
+}
+
+int ObIOUring::prep_writev(const int fd, const struct iovec *iov, const int32_t niov, const uint64_t user_data)
+{
+  return prep_rw(IORING_OP_WRITEV, fd, iov, niov, user_data);
+}
+
+int ObIOUring::submit_and_wait(const uint32_t wait_nr, int64_t &submitted)
+{
+  int ret = OB_SUCCESS;
+  submitted = 0;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+  } else {
+    // publish queued sqes to the kernel
+    const uint32_t to_submit = sqe_tail_ - sqe_head_;
+    uint32_t tail = *sq_tail_;
+    const uint32_t mask = *sq_ring_mask_;
+    for (uint32_t i = 0; i < to_submit; ++i) {
+      sq_array_[tail & mask] = (sqe_head_ + i) & mask;
+      ++tail;
+    }
+    sqe_head_ = sqe_tail_;
+    ATOMIC_STORE_REL(sq_tail_, tail);
+
+    if (to_submit > 0 || wait_nr > 0) {
+      const uint32_t flags = (wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0);
+      int64_t count = -1;
+      do {
+        count = syscall(__NR_io_uring_enter, ring_fd_, to_submit, wait_nr, flags, NULL, 0);
+      } while (count < 0 && EINTR == errno);
+
+      if (OB_UNLIKELY(count < 0)) {
+        ret = ob_get_sys_errno();
+        LOG_WDIAG("fail to io_uring_enter", K_(ring_fd), K(to_submit), K(wait_nr), KERRMSGS, K(ret));
+      } else {
+        submitted = count;
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObIOUring::next_completion(uint64_t &user_data, int32_t &res)
+{
+  bool bret = false;
+  if (OB_LIKELY(is_inited())) {
+    const uint32_t head = *cq_head_;
+    // the kernel advances cq tail when it posts cqes
+    if (head != ATOMIC_LOAD_ACQ(cq_tail_)) {
+      const struct io_uring_cqe *cqe = static_cast<struct io_uring_cqe *>(cqes_) + (head & *cq_ring_mask_);
+      user_data = cqe->user_data;
+      res = cqe->res;
+      ATOMIC_STORE_REL(cq_head_, head + 1);
+      bret = true;
+    }
+  }
+  return bret;
+}
+
+bool ObIOUring::is_supported()
+{
+  ObIOUring ring;
+  return OB_SUCCESS == ring.init(1);
+}
+
+#else // OB_HAVE_IO_URING
+
+int ObIOUring::init(const uint32_t entries)
+{
+  UNUSED(entries);
+  return OB_NOT_SUPPORTED;
+}
+
+void ObIOUring::destroy()
+{
+}
+
+int ObIOUring::prep_readv(const int fd, const struct iovec *iov, const int32_t niov, const uint64_t user_data)
+{
+  UNUSED(fd);
+  UNUSED(iov);
+  UNUSED(niov);
+  UNUSED(user_data);
+  return OB_NOT_SUPPORTED;
+}
+
+int ObIOUring::prep_writev(const int fd, const struct iovec *iov, const int32_t niov, const uint64_t user_data)
+{
+  UNUSED(fd);
+  UNUSED(iov);
+  UNUSED(niov);
+  UNUSED(user_data);
+  return OB_NOT_SUPPORTED;
+}
+
+int ObIOUring::submit_and_wait(const uint32_t wait_nr, int64_t &submitted)
+{
+  UNUSED(wait_nr);
+  submitted = 0;
+  return OB_NOT_SUPPORTED;
+}
+
+bool ObIOUring::next_completion(uint64_t &user_data, int32_t &res)
+{
+  UNUSED(user_data);
+  UNUSED(res);
+  return false;
+}
+
+bool ObIOUring::is_supported()
+{
+  return false;
+}
+
+#endif // OB_HAVE_IO_URING
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_IO_URING_H
+#define OBPROXY_IO_URING_H
+
+#include <sys/uio.h>
+#include "utils/ob_proxy_lib.h"
+
+// io_uring is driven through raw syscalls, so that we needn't link liburing.
+// the build host may have old kernel headers (el7), in which case the ring
+// is compiled out and ObIOUring::init() always returns OB_NOT_SUPPORTED.
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define OB_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+// A minimal single-issuer io_uring used by one ethread.
+// all methods must be called from the thread which owns the ring.
+class ObIOUring
+{
+public:
+  ObIOUring();
+  ~ObIOUring() { destroy(); }
+
+  int init(const uint32_t entries);
+  void destroy();
+  bool is_inited() const { return ring_fd_ >= 0; }
+
+  // queue a readv/writev, return OB_SIZE_OVERFLOW if the submission queue is full
+  int prep_readv(const int fd, const struct iovec *iov, const int32_t niov, const uint64_t user_data);
+  int prep_writev(const int fd, const struct iovec *iov, const int32_t niov, const uint64_t user_data);
+
+  // submit all queued sqes and wait until at least wait_nr cqes are ready
+  int submit_and_wait(const uint32_t wait_nr, int64_t &submitted);
+
+  // fetch the next completion, return false if completion queue is empty
+  bool next_completion(uint64_t &user_data, int32_t &res);
+
+  int64_t get_pending_count() const { return sqe_tail_ - sqe_head_; }
+  uint32_t get_entries() const { return sq_entries_; }
+
+  // try to create and destroy a tiny ring, used to decide whether to fall back to epoll
+  static bool is_supported();
+
+private:
+#ifdef OB_HAVE_IO_URING
+  struct io_uring_sqe *get_sqe();
+  int prep_rw(const uint8_t opcode, const int fd, const struct iovec *iov,
+              const int32_t niov, const uint64_t user_data);
+#endif
+
+private:
+  int ring_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+
+  // sqes queued by get_sqe() but not yet published to the kernel
+  uint32_t sqe_head_;
+  uint32_t sqe_tail_;
+
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  void *sqes_ptr_;
+  int64_t sqes_size_;
+
+  uint32_t *sq_head_;
+  uint32_t *sq_tail_;
+  uint32_t *sq_ring_mask_;
+  uint32_t *sq_array_;
+  uint32_t *cq_head_;
+  uint32_t *cq_tail_;
+  uint32_t *cq_ring_mask_;
+  void *cqes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_IO_URING_H
@@ -264,6 +264,75 @@ int ObNetAccept::init_accept_per_thread()
   return ret;
 }
 
+// Initialize one ObNetAccept for each net thread, each of them listens on
+// its own SO_REUSEPORT socket registered in the net poll of its thread.
+// The kernel hashes new connections among these sockets and a connection
+// is handled by the thread which accepted it, without any handoff.
+int ObNetAccept::init_accept_per_thread_reuse_port()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObEThread *t = NULL;
+
+  reuse_port_ = true;
+  server_.reuse_port_ = true;
+  if (OB_FAIL(do_listen(NON_BLOCKING))) {
+    PROXY_NET_LOG(EDIAG, "fail to listen", K(ret));
+  } else {
+    SET_HANDLER((NetAcceptHandler)&ObNetAccept::accept_fast_event);
+    period_ = ACCEPT_PERIOD;
+    ObNetAccept *na = NULL;
+    int64_t n = g_event_processor.thread_count_for_type_[ET_NET];
+    NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, n);
+
+    for (int64_t i = 0; i < n && OB_SUCC(ret); ++i) {
+      if (i < n - 1) {
+        if (OB_ISNULL(na = new (std::nothrow) ObNetAccept())) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          PROXY_NET_LOG(EDIAG, "fail to new ObNetAccept");
+        } else if (OB_FAIL(na->deep_copy(*this))) {
+          NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, -1);
+          PROXY_NET_LOG(EDIAG, "fail to deep_copy", K(i), K(ret));
+        } else {
+          na->server_.fd_ = NO_FD;
+          if (OB_SUCCESS != (tmp_ret = na->server_.listen_reuse_port(server_.addr_, NON_BLOCKING,
+                                                                     recv_bufsize_, send_bufsize_))) {
+            // e.g. the inherited listen socket was created without SO_REUSEPORT,
+            // this thread shares the first listen socket like frequent accept
+            PROXY_NET_LOG(WDIAG, "fail to listen on reuse port socket, share the first listen socket",
+                          K(i), K(server_.addr_), K(tmp_ret));
+            na->server_.fd_ = server_.fd_;
+            na->own_reuse_port_fd_ = false;
+          } else {
+            na->own_reuse_port_fd_ = true;
+            PROXY_NET_LOG(INFO, "succ to listen on reuse port socket", K(i), K(na->server_.fd_), K(server_.addr_));
+          }
+        }
+      } else {
+        na = this;
+      }
+
+      if (OB_SUCC(ret)) {
+        t = g_event_processor.event_thread_[ET_NET][i];
+        if (OB_ISNULL(t)) {
+          ret = OB_ERR_UNEXPECTED;
+          PROXY_NET_LOG(EDIAG, "g_event_processor fail to get ET_NET ObEThread", K(ret));
+        } else {
+          na->mutex_ = t->get_net_handler().mutex_;
+          if(OB_FAIL(na->ep_->start(t->get_net_poll().get_poll_descriptor(),
+                                    *na, EVENTIO_READ))) {
+            PROXY_NET_LOG(EDIAG, "fail to start ObEventIO", K(ret));
+          } else if (OB_ISNULL(t->schedule_every(na, period_, etype_))) {
+            ret = OB_ERR_UNEXPECTED;
+            PROXY_NET_LOG(EDIAG, "fail to schedule_every", K(ret));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObNetAccept::do_listen(const bool non_blocking)
 {
   int ret = OB_SUCCESS;
@@ -496,6 +565,7 @@ int ObNetAccept::do_blocking_accept()
         PROXY_NET_LOG(EDIAG, "fail to get_shedule_ethread", K(ret));
       } else {
         NET_ATOMIC_INCREMENT_DYN_STAT(ethread, NET_CLIENT_CONNECTIONS_CURRENTLY_OPEN);
+        NET_ATOMIC_INCREMENT_DYN_STAT(ethread, NET_ACCEPTED_CONNECTIONS);
         if (OB_ISNULL(ethread->schedule_imm_signal(vc))) {
           ret = OB_ERR_UNEXPECTED;
           PROXY_NET_LOG(EDIAG, "fail to schedule_imm_signal vc", K(ret));
@@ -715,7 +785,12 @@ int ObNetAccept::accept_fast_event(int event, void *ep)
     ret = OB_INVALID_ARGUMENT;
     PROXY_NET_LOG(WDIAG, "invalid argument", K(ep), K(ret));
   } else if (OB_UNLIKELY(!info.need_conn_accept_)) {
-    //do nothing
+    if (own_reuse_port_fd_) {
+      // the kernel keeps dispatching connections to this socket, they would
+      // wait in its backlog forever, so leave the reuse port group now
+      close_reuse_port_listener(*reinterpret_cast<ObEvent *>(ep));
+      event_ret = EVENT_DONE;
+    }
   } else {
     ObEvent *e = reinterpret_cast<ObEvent *>(ep);
     bool need_close_vc = false;
@@ -726,7 +801,7 @@ int ObNetAccept::accept_fast_event(int event, void *ep)
       PROXY_NET_LOG(EDIAG, "fail to get ethread", K(ret));
     } else {
       while (loop && OB_SUCC(ret)) {
-        if (!accept_balance(e->ethread_)) { // for balance
+        if (!reuse_port_ && !accept_balance(e->ethread_)) { // for balance
           ret = OB_SYS_EAGAIN;
           net_ret = ret;
           con.fd_ = NO_FD;
@@ -750,6 +825,7 @@ int ObNetAccept::accept_fast_event(int event, void *ep)
 
           NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_CONNECTIONS_CURRENTLY_OPEN, 1);
           NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_CLIENT_CONNECTIONS_CURRENTLY_OPEN, 1);
+          NET_ATOMIC_INCREMENT_DYN_STAT(e->ethread_, NET_ACCEPTED_CONNECTIONS);
 
           SET_CONTINUATION_HANDLER(vc, reinterpret_cast<NetVConnHandler>(&ObUnixNetVConnection::main_event));
 
@@ -913,6 +989,8 @@ ObNetAccept::ObNetAccept()
       accept_fn_(NULL),
       callback_on_open_(false),
       backdoor_(false),
+      reuse_port_(false),
+      own_reuse_port_fd_(false),
       recv_bufsize_(0),
       send_bufsize_(0),
       sockopt_flags_(0),
@@ -951,6 +1029,23 @@ void ObNetAccept::cancel()
   }
 }
 
+void ObNetAccept::close_reuse_port_listener(ObEvent &e)
+{
+  int tmp_ret = OB_SUCCESS;
+  PROXY_NET_LOG(INFO, "stop accept, close reuse port listen socket", K(server_.fd_), K(server_.addr_));
+  if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = ep_->stop()))) {
+    PROXY_NET_LOG(WDIAG, "fail to stop ObEventIO", K(tmp_ret));
+  }
+  if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = server_.close()))) {
+    PROXY_NET_LOG(WDIAG, "failed to close server connection", K(tmp_ret));
+  }
+  if (OB_UNLIKELY(OB_SUCCESS != (tmp_ret = e.cancel()))) {
+    PROXY_NET_LOG(WDIAG, "fail to cancel ObEvent", K(tmp_ret));
+  }
+  NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, -1);
+  delete this;
+}
+
 int ObNetAccept::deep_copy(const ObNetAccept &na)
 {
   int ret = OB_SUCCESS;
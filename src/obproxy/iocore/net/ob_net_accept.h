@@ -101,6 +101,8 @@ public:
   int deep_copy(const ObNetAccept &na);
   int init_accept_loop(const char *thread_name, const int64_t stacksize);
   int init_accept_per_thread();
+  // every net thread listens on its own SO_REUSEPORT socket
+  int init_accept_per_thread_reuse_port();
 
   int init_accept();
 
@@ -118,6 +120,8 @@ private:
   int accept_event(int event, void *e);
 
   void cancel();
+  // close the private reuse port socket when this process stops accepting
+  void close_reuse_port_listener(event::ObEvent &e);
   // for loading balance, get the ethread which has minimal client connections
   event::ObEThread *get_schedule_ethread();
   event::ObEThread *get_schedule_vip_ethread();
@@ -137,6 +141,12 @@ public:
   AcceptFunctionPtr accept_fn_;
   bool callback_on_open_;
   bool backdoor_;
+  // the kernel balances connections among SO_REUSEPORT sockets,
+  // so accept_balance() is skipped
+  bool reuse_port_;
+  // this ObNetAccept owns a private SO_REUSEPORT socket which is
+  // not inherited by the new process on hot upgrade
+  bool own_reuse_port_fd_;
   common::ObPtr<ObNetAcceptAction> action_;
   int32_t recv_bufsize_;
   int32_t send_bufsize_;
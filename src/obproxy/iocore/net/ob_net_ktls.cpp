@@ -0,0 +1,230 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_NET
+
+#include "iocore/net/ob_net_ktls.h"
+#include <netinet/in.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/crypto.h>
+#include "iocore/net/ob_socket_manager.h"
+
+// the build host may have old kernel headers (el7) without linux/tls.h
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+static const int KTLS_TX = 1;
+static const int KTLS_RX = 2;
+static const uint16_t KTLS_VERSION_1_2 = 0x0303;
+static const uint16_t KTLS_CIPHER_AES_GCM_128 = 51;
+static const uint16_t KTLS_CIPHER_AES_GCM_256 = 52;
+static const int64_t KTLS_SALT_SIZE = 4;
+static const int64_t KTLS_IV_SIZE = 8;
+static const int64_t KTLS_SEQ_SIZE = 8;
+static const int64_t KTLS_RANDOM_SIZE = 32;
+static const int64_t KTLS_MAX_KEY_SIZE = 32;
+
+// same layout as tls12_crypto_info_aes_gcm_128/256 in linux/tls.h
+template <int64_t KEY_SIZE>
+struct ObKTLSCryptoInfo
+{
+  uint16_t version_;
+  uint16_t cipher_type_;
+  unsigned char iv_[KTLS_IV_SIZE];
+  unsigned char key_[KEY_SIZE];
+  unsigned char salt_[KTLS_SALT_SIZE];
+  unsigned char rec_seq_[KTLS_SEQ_SIZE];
+};
+
+// what openssl used for one direction before the handoff
+struct ObKTLSDirection
+{
+  const unsigned char *key_;
+  const unsigned char *salt_;
+  const unsigned char *seq_;
+};
+
+// P_hash of the TLS 1.2 PRF (RFC 5246 5), the seed includes the label
+static int tls12_prf(const EVP_MD *md, const unsigned char *secret, const int secret_len,
+                     const unsigned char *seed, const int seed_len,
+                     unsigned char *out, const int64_t out_len)
+{
+  int ret = OB_SUCCESS;
+  unsigned char a[EVP_MAX_MD_SIZE];
+  unsigned char buf[EVP_MAX_MD_SIZE + 128];
+  unsigned char chunk[EVP_MAX_MD_SIZE];
+  unsigned int a_len = 0;
+  unsigned int chunk_len = 0;
+  int64_t pos = 0;
+  if (OB_ISNULL(md) || OB_UNLIKELY(seed_len > 128)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == HMAC(md, secret, secret_len, seed, seed_len, a, &a_len)) {
+    ret = OB_ERR_UNEXPECTED;
+  }
+  while (OB_SUCC(ret) && pos < out_len) {
+    // chunk = HMAC(secret, A(i) + seed), A(i + 1) = HMAC(secret, A(i))
+    MEMCPY(buf, a, a_len);
+    MEMCPY(buf + a_len, seed, seed_len);
+    if (NULL == HMAC(md, secret, secret_len, buf, a_len + seed_len, chunk, &chunk_len)
+        || NULL == HMAC(md, secret, secret_len, a, a_len, a, &a_len)) {
+      ret = OB_ERR_UNEXPECTED;
+    } else {
+      const int64_t len = std::min(out_len - pos, static_cast<int64_t>(chunk_len));
+      MEMCPY(out + pos, chunk, len);
+      pos += len;
+    }
+  }
+  OPENSSL_cleanse(a, sizeof(a));
+  OPENSSL_cleanse(buf, sizeof(buf));
+  OPENSSL_cleanse(chunk, sizeof(chunk));
+  return ret;
+}
+
+template <int64_t KEY_SIZE>
+static int set_crypto_info(const int fd, const int direction, const uint16_t cipher_type,
+                           const ObKTLSDirection &dir)
+{
+  int ret = OB_SUCCESS;
+  ObKTLSCryptoInfo<KEY_SIZE> info;
+  memset(&info, 0, sizeof(info));
+  info.version_ = KTLS_VERSION_1_2;
+  info.cipher_type_ = cipher_type;
+  // the explicit nonce only has to be unique, start it from the record sequence
+  MEMCPY(info.iv_, dir.seq_, KTLS_IV_SIZE);
+  MEMCPY(info.key_, dir.key_, KEY_SIZE);
+  MEMCPY(info.salt_, dir.salt_, KTLS_SALT_SIZE);
+  MEMCPY(info.rec_seq_, dir.seq_, KTLS_SEQ_SIZE);
+  ret = ObSocketManager::setsockopt(fd, SOL_TLS, direction, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  return ret;
+}
+
+static int set_crypto_info(const int fd, const int direction, const int64_t key_size,
+                           const ObKTLSDirection &dir)
+{
+  return 16 == key_size
+      ? set_crypto_info<16>(fd, direction, KTLS_CIPHER_AES_GCM_128, dir)
+      : set_crypto_info<32>(fd, direction, KTLS_CIPHER_AES_GCM_256, dir);
+}
+
+static bool has_suffix(const char *str, const char *suffix)
+{
+  const size_t len = strlen(str);
+  const size_t suffix_len = strlen(suffix);
+  return len >= suffix_len && 0 == strcmp(str + len - suffix_len, suffix);
+}
+
+int ObNetKTLS::enable(const int fd, SSL *ssl, const bool is_server)
+{
+  int ret = OB_SUCCESS;
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+  const SSL_CIPHER *cipher = NULL;
+  const char *cipher_name = NULL;
+  SSL_SESSION *session = NULL;
+  const EVP_MD *md = NULL;
+  int64_t key_size = 0;
+
+  if (OB_ISNULL(ssl) || OB_UNLIKELY(fd < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid argument", K(fd), K(ssl), K(ret));
+  } else if (TLS1_2_VERSION != SSL_version(ssl)
+             || OB_ISNULL(cipher = SSL_get_current_cipher(ssl))
+             || OB_ISNULL(cipher_name = SSL_CIPHER_get_name(cipher))
+             || OB_ISNULL(session = SSL_get_session(ssl))
+             || OB_ISNULL(ssl->s3)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (has_suffix(cipher_name, "AES128-GCM-SHA256")) {
+    md = EVP_sha256();
+    key_size = 16;
+  } else if (has_suffix(cipher_name, "AES256-GCM-SHA384")) {
+    md = EVP_sha384();
+    key_size = 32;
+  } else {
+    ret = OB_NOT_SUPPORTED;
+  }
+
+  if (OB_FAIL(ret)) {
+    LOG_DEBUG("ssl connection can not be offloaded", K(fd), "version", SSL_version(ssl),
+              "cipher", NULL == cipher_name ? "" : cipher_name);
+  } else if (0 != ssl->s3->rbuf.left || 0 != ssl->s3->wbuf.left || SSL_pending(ssl) > 0) {
+    // records already read or not sent by openssl would be lost
+    ret = OB_NOT_SUPPORTED;
+    LOG_DEBUG("ssl connection has buffered records, keep it in openssl", K(fd));
+  } else if (OB_FAIL(ObSocketManager::setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")))) {
+    // no tls module in the kernel, the socket is unchanged
+    ret = OB_NOT_SUPPORTED;
+    LOG_DEBUG("fail to set tls ulp", K(fd));
+  } else {
+    // key_block = PRF(master_secret, "key expansion", server_random + client_random), AEAD
+    // ciphers have no mac keys: client key, server key, client salt, server salt
+    static const char LABEL[] = "key expansion";
+    const int64_t label_len = sizeof(LABEL) - 1;
+    unsigned char seed[label_len + 2 * KTLS_RANDOM_SIZE];
+    unsigned char key_block[2 * (KTLS_MAX_KEY_SIZE + KTLS_SALT_SIZE)];
+    MEMCPY(seed, LABEL, label_len);
+    MEMCPY(seed + label_len, ssl->s3->server_random, KTLS_RANDOM_SIZE);
+    MEMCPY(seed + label_len + KTLS_RANDOM_SIZE, ssl->s3->client_random, KTLS_RANDOM_SIZE);
+    if (OB_FAIL(tls12_prf(md, session->master_key, session->master_key_length,
+                          seed, static_cast<int>(sizeof(seed)),
+                          key_block, 2 * (key_size + KTLS_SALT_SIZE)))) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WDIAG("fail to derive ktls keys", K(fd), K(ret));
+    } else {
+      ObKTLSDirection client_dir;
+      ObKTLSDirection server_dir;
+      client_dir.key_ = key_block;
+      server_dir.key_ = key_block + key_size;
+      client_dir.salt_ = key_block + 2 * key_size;
+      server_dir.salt_ = key_block + 2 * key_size + KTLS_SALT_SIZE;
+      ObKTLSDirection &tx_dir = is_server ? server_dir : client_dir;
+      ObKTLSDirection &rx_dir = is_server ? client_dir : server_dir;
+      tx_dir.seq_ = ssl->s3->write_sequence;
+      rx_dir.seq_ = ssl->s3->read_sequence;
+      // rx first, kernels which have tls rx always have tx, so a failure
+      // here still leaves the socket to openssl
+      if (OB_FAIL(set_crypto_info(fd, KTLS_RX, key_size, rx_dir))) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_DEBUG("fail to set ktls rx", K(fd));
+      } else if (OB_FAIL(set_crypto_info(fd, KTLS_TX, key_size, tx_dir))) {
+        LOG_WDIAG("fail to set ktls tx after rx", K(fd), K(ret));
+      }
+    }
+    OPENSSL_cleanse(key_block, sizeof(key_block));
+  }
+#else
+  // the record sequences are opaque since openssl 1.1.0, which offloads by
+  // itself with SSL_OP_ENABLE_KTLS from 3.0
+  UNUSED(fd);
+  UNUSED(ssl);
+  UNUSED(is_server);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
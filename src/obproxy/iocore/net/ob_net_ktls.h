@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_NET_KTLS_H
+#define OBPROXY_NET_KTLS_H
+
+#include <openssl/ssl.h>
+#include "utils/ob_proxy_lib.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+// Kernel TLS offload of an established ssl connection.
+//
+// After the handshake the record keys are derived from the master secret,
+// the same way openssl does, and handed to the kernel with TLS_RX and TLS_TX.
+// From then on the socket carries plain text for the process, so the plain
+// read/readv/write paths are used and the SSL object is no longer needed.
+// Only TLS 1.2 with AES-GCM is offloaded, which every kernel with kTLS supports.
+class ObNetKTLS
+{
+public:
+  // OB_NOT_SUPPORTED if the cipher, the kernel or openssl can not do it, the
+  // connection is left untouched and openssl keeps doing the records.
+  // Any other error means the connection is unusable and must be closed.
+  static int enable(const int fd, SSL *ssl, const bool is_server);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObNetKTLS);
+};
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_NET_KTLS_H
@@ -100,6 +100,11 @@ public:
     // Are frequent accepts expected?
     // Default: true.
     bool frequent_accept_;
+
+    // If true with frequent_accept_, every net thread listens on its own
+    // SO_REUSEPORT socket and keeps the connections it accepts.
+    // Default: false.
+    bool reuse_port_;
     bool backdoor_;
 
     // tcp defer accept timeout, if it set, accept until there is
@@ -55,7 +55,8 @@ struct ObNetState
     vio_(event::ObVIO::NONE),
     active_count_(0),
     in_enabled_list_(false),
-    triggered_(false)
+    triggered_(false),
+    in_batch_(false)
   { }
   ~ObNetState() { }
 
@@ -66,6 +67,8 @@ struct ObNetState
   int32_t active_count_;
   bool in_enabled_list_;
   bool triggered_;
+  // set while a batched io of this channel is submitted to io_uring
+  bool in_batch_;
 };
 
 } // end of namespace net
@@ -415,6 +415,18 @@ public:
   // Set the TCP initial congestion window
   virtual int set_tcp_init_cwnd(const int32_t init_cwnd) = 0;
 
+  // Move the connection to another thread while no IO is in progress.
+  // detach_from_thread() is called on the current thread and returns
+  // OB_EAGAIN if the connection can not leave it now, attach_to_thread()
+  // is called on the target thread. The connection must be closed if
+  // attach fails.
+  virtual int detach_from_thread() { return common::OB_NOT_SUPPORTED; }
+  virtual int attach_to_thread(event::ObEThread &ethread)
+  {
+    UNUSED(ethread);
+    return common::OB_NOT_SUPPORTED;
+  }
+
 protected:
   virtual int get_socket() = 0;
 
@@ -450,7 +462,7 @@ public:
 
   // for OBAPI
   bool get_is_force_timeout() const { return is_force_timeout_; }
-  void set_is_force_timeout(const bool force_timeout) { is_force_timeout_ = force_timeout;}
+  virtual void set_is_force_timeout(const bool force_timeout) { is_force_timeout_ = force_timeout;}
 
 public:
   // Structure holding user options
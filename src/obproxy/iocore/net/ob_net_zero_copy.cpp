@@ -0,0 +1,165 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_NET
+
+#include "iocore/net/ob_net_zero_copy.h"
+#include <time.h>
+#include <linux/errqueue.h>
+#include "iocore/net/ob_socket_manager.h"
+
+// the build host may have old kernel headers (el7)
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+using namespace oceanbase::common;
+using namespace oceanbase::obproxy::event;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+ObNetZeroCopy::ObNetZeroCopy()
+    : fd_(NO_FD), linger_deadline_(0), send_seq_(0), done_seq_(0), is_copied_(false)
+{
+}
+
+int ObNetZeroCopy::enable(const int fd)
+{
+  int ret = OB_SUCCESS;
+  const int32_t on = 1;
+  if (OB_FAIL(ObSocketManager::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY,
+      reinterpret_cast<const void *>(&on), sizeof(on)))) {
+    LOG_DEBUG("fail to set sockopt SO_ZEROCOPY", K(fd), K(ret));
+  }
+  return ret;
+}
+
+int ObNetZeroCopy::send(const int fd, const struct iovec *iov, const int32_t niov,
+                        ObIOBufferBlock *const *blocks, int64_t &count)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  if (OB_ISNULL(iov) || OB_ISNULL(blocks) || OB_UNLIKELY(niov <= 0) || OB_UNLIKELY(niov > MAX_IOV)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid argument", K(iov), K(blocks), K(niov), K(ret));
+  } else if (OB_UNLIKELY(!can_send())) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = niov;
+    if (OB_SUCC(ObSocketManager::sendmsg(fd, &msg, MSG_ZEROCOPY, count)) && count > 0) {
+      ObPendingSend &pending = pending_[send_seq_ % MAX_PENDING_SENDS];
+      pending.done_ = false;
+      pending.count_ = niov;
+      for (int32_t i = 0; i < niov; ++i) {
+        pending.data_[i] = blocks[i]->data_;
+      }
+      ++send_seq_;
+    }
+  }
+  return ret;
+}
+
+void ObNetZeroCopy::finish_sends(const uint32_t lo, const uint32_t hi)
+{
+  // ids are unsigned 32 bit and may wrap around
+  for (uint32_t seq = lo; seq - done_seq_ < send_seq_ - done_seq_; ++seq) {
+    pending_[seq % MAX_PENDING_SENDS].done_ = true;
+    if (seq == hi) {
+      break;
+    }
+  }
+
+  while (done_seq_ != send_seq_ && pending_[done_seq_ % MAX_PENDING_SENDS].done_) {
+    ObPendingSend &pending = pending_[done_seq_ % MAX_PENDING_SENDS];
+    for (int32_t i = 0; i < pending.count_; ++i) {
+      pending.data_[i].release();
+    }
+    pending.count_ = 0;
+    pending.done_ = false;
+    ++done_seq_;
+  }
+}
+
+int ObNetZeroCopy::reap(const int fd)
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  char control[128];
+  struct msghdr msg;
+  struct cmsghdr *cm = NULL;
+  struct sock_extended_err *serr = NULL;
+
+  while (OB_SUCC(ret) && has_pending()) {
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (OB_FAIL(ObSocketManager::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT, count))) {
+      if (OB_SYS_EAGAIN == ret) {
+        ret = OB_SUCCESS;
+        break;
+      }
+      LOG_WDIAG("fail to read socket error queue", K(fd), K(ret));
+    } else {
+      for (cm = CMSG_FIRSTHDR(&msg); NULL != cm; cm = CMSG_NXTHDR(&msg, cm)) {
+        if ((SOL_IP == cm->cmsg_level && IP_RECVERR == cm->cmsg_type)
+            || (SOL_IPV6 == cm->cmsg_level && IPV6_RECVERR == cm->cmsg_type)) {
+          serr = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cm));
+          if (SO_EE_ORIGIN_ZEROCOPY == serr->ee_origin && 0 == serr->ee_errno) {
+            if (SO_EE_CODE_ZEROCOPY_COPIED & serr->ee_code) {
+              // pinning pages costs more than copy in this case, stop using zero copy
+              is_copied_ = true;
+            }
+            finish_sends(serr->ee_info, serr->ee_data);
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+void ObNetZeroCopy::reset()
+{
+  for (int64_t i = 0; i < MAX_PENDING_SENDS; ++i) {
+    for (int32_t j = 0; j < pending_[i].count_; ++j) {
+      pending_[i].data_[j].release();
+    }
+    pending_[i].count_ = 0;
+    pending_[i].done_ = false;
+  }
+  send_seq_ = 0;
+  done_seq_ = 0;
+  is_copied_ = false;
+  fd_ = NO_FD;
+  linger_deadline_ = 0;
+}
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
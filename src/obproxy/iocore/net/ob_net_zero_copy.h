@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBPROXY_NET_ZERO_COPY_H
+#define OBPROXY_NET_ZERO_COPY_H
+
+#include <sys/uio.h>
+#include "utils/ob_proxy_lib.h"
+#include "lib/list/ob_intrusive_list.h"
+#include "iocore/eventsystem/ob_io_buffer.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace net
+{
+
+// MSG_ZEROCOPY send state of one socket.
+//
+// The kernel sends directly from the user pages of a zero copy send, so the
+// ObIOBufferData behind every iovec is pinned until the completion of the
+// send is read from the socket error queue. Each successful sendmsg() gets
+// the next notification id from the kernel, which is also the index of its
+// pinned data here.
+class ObNetZeroCopy
+{
+public:
+  static const int64_t MAX_IOV = 16;
+  static const int64_t MAX_PENDING_SENDS = 64;
+
+  ObNetZeroCopy();
+  ~ObNetZeroCopy() { reset(); }
+
+  // turn on SO_ZEROCOPY, fail if the kernel does not support it
+  static int enable(const int fd);
+
+  // send with MSG_ZEROCOPY, the data of blocks is pinned if any byte is sent
+  int send(const int fd, const struct iovec *iov, const int32_t niov,
+           event::ObIOBufferBlock *const *blocks, int64_t &count);
+
+  // read all completion notifications and unpin the finished sends
+  int reap(const int fd);
+
+  bool can_send() const { return !is_copied_ && send_seq_ - done_seq_ < MAX_PENDING_SENDS; }
+  bool has_pending() const { return send_seq_ != done_seq_; }
+  int64_t get_pending_count() const { return send_seq_ - done_seq_; }
+  // the kernel copied the data instead of pinning pages, e.g. loopback or no SG support
+  bool is_copied() const { return is_copied_; }
+  void reset();
+
+public:
+  // fd and deadline are used only after the vc is closed, when this object
+  // lingers on the net handler until the pending sends are finished
+  int fd_;
+  ObHRTime linger_deadline_;
+  LINK(ObNetZeroCopy, link_);
+
+private:
+  void finish_sends(const uint32_t lo, const uint32_t hi);
+
+private:
+  struct ObPendingSend
+  {
+    ObPendingSend() : done_(false), count_(0) { }
+    ~ObPendingSend() { }
+
+    bool done_;
+    int32_t count_;
+    common::ObPtr<event::ObIOBufferData> data_[MAX_IOV];
+  };
+
+  // notification id of the next successful send
+  uint32_t send_seq_;
+  // all sends before done_seq_ have been unpinned
+  uint32_t done_seq_;
+  bool is_copied_;
+  ObPendingSend pending_[MAX_PENDING_SENDS];
+
+  DISALLOW_COPY_AND_ASSIGN(ObNetZeroCopy);
+};
+
+} // end of namespace net
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OBPROXY_NET_ZERO_COPY_H
@@ -36,6 +36,10 @@
 #include "iocore/net/ob_timerfd_manager.h"
 #include "obutils/ob_resource_pool_processor.h"
 
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL 46
+#endif
+
 using namespace oceanbase::common;
 using namespace oceanbase::obproxy::event;
 using namespace oceanbase::obproxy::obutils;
@@ -220,7 +224,9 @@ ObNetPoll::ObNetPoll(ObNetHandler &nh)
     : poll_descriptor_(NULL),
       nh_(nh),
       timer_fd_(OB_INVALID_INDEX),
-      ep_(NULL)
+      ep_(NULL),
+      io_uring_(NULL),
+      batch_io_(NULL)
 {
 }
 
@@ -235,6 +241,8 @@ ObNetPoll::~ObNetPoll()
   }
 
   ObTimerFdManager::timerfd_close(timer_fd_);
+
+  disable_io_uring();
 }
 
 int ObNetPoll::init()
@@ -269,10 +277,48 @@ int ObNetPoll::init()
         PROXY_NET_LOG(WDIAG, "fail to epoll_ctl, op is EPOLL_CTL_ADD", K(poll_descriptor_->epoll_fd_), K_(timer_fd), K(ret));
       }
     }
+
+    if (OB_SUCC(ret) && get_global_proxy_config().enable_io_uring) {
+      // io_uring is an optimization, any failure falls back to the epoll read path
+      if (OB_SUCCESS != init_io_uring()) {
+        disable_io_uring();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObNetPoll::init_io_uring()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(io_uring_ = new (std::nothrow) ObIOUring())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PROXY_NET_LOG(WDIAG, "fail to new ObIOUring", K(ret));
+  } else if (OB_ISNULL(batch_io_ = new (std::nothrow) ObNetBatchIO[IO_URING_BATCH_SIZE])) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PROXY_NET_LOG(WDIAG, "fail to new ObNetBatchIO", K(ret));
+  } else if (OB_FAIL(io_uring_->init(static_cast<uint32_t>(IO_URING_BATCH_SIZE)))) {
+    PROXY_NET_LOG(WDIAG, "fail to init io_uring, use epoll read path instead", K(ret));
+  } else if (OB_UNLIKELY(io_uring_->get_entries() < IO_URING_BATCH_SIZE)) {
+    ret = OB_ERR_UNEXPECTED;
+    PROXY_NET_LOG(WDIAG, "io_uring entries is less than batch size",
+                  "entries", io_uring_->get_entries(), K(IO_URING_BATCH_SIZE), K(ret));
   }
   return ret;
 }
 
+void ObNetPoll::disable_io_uring()
+{
+  if (NULL != io_uring_) {
+    delete io_uring_;
+    io_uring_ = NULL;
+  }
+  if (NULL != batch_io_) {
+    delete []batch_io_;
+    batch_io_ = NULL;
+  }
+}
+
 int ObNetPoll::timerfd_settime()
 {
   int ret = OB_SUCCESS;
@@ -284,7 +330,8 @@ int ObNetPoll::timerfd_settime()
 
 ObInactivityCop::ObInactivityCop(ObProxyMutex *m)
     : ObContinuation(m), default_inactivity_timeout_(1800),
-      total_connections_in_(0), max_connections_in_(0), connections_per_thread_in_(0)
+      total_connections_in_(0), max_connections_in_(0), connections_per_thread_in_(0),
+      next_full_sweep_at_(0)
 {
   SET_HANDLER(&ObInactivityCop::check_inactivity);
   PROXY_NET_LOG(DEBUG, "new ObInactivityCop", K(default_inactivity_timeout_));
@@ -335,14 +382,19 @@ int ObInactivityCop::check_inactivity(int event, ObEvent *e)
       info.graceful_exit_end_time_ = 0;
     }
 
-    // Copy the list and use pop() to catch any closes caused by callbacks.
-    forl_LL(ObUnixNetVConnection, vc, nh.open_list_) {
-      if (vc->thread_ == ethread) {
-        if (ObUnixNetVConnection::VC_ACCEPT == vc->source_type_) {
-          ++total_connections_in_;
+    if (need_full_sweep(nh, now)) {
+      NET_INCREMENT_DYN_STAT(INACTIVITY_COP_FULL_SWEEP);
+      // Copy the list and use pop() to catch any closes caused by callbacks.
+      forl_LL(ObUnixNetVConnection, vc, nh.open_list_) {
+        if (vc->thread_ == ethread) {
+          if (ObUnixNetVConnection::VC_ACCEPT == vc->source_type_) {
+            ++total_connections_in_;
+          }
+          nh.cop_list_.push(vc);
         }
-        nh.cop_list_.push(vc);
       }
+    } else {
+      NET_THREAD_READ_DYN_SUM(ethread, NET_CLIENT_CONNECTIONS_CURRENTLY_OPEN, total_connections_in_);
     }
 
     ObUnixNetVConnection *vc = NULL;
@@ -410,10 +462,69 @@ int ObInactivityCop::check_inactivity(int event, ObEvent *e)
     if (OB_SUCC(ret) && OB_FAIL(keep_alive_lru(nh, now, e))) {
       PROXY_NET_LOG(WDIAG, "fail to keep_alive_lru", K(e), K(ret));
     }
+
+    if (!nh.zero_copy_linger_list_.empty()) {
+      close_zero_copy_linger(nh, now);
+    }
   }
   return (OB_SUCCESS == ret) ? EVENT_DONE : EVENT_ERROR;
 }
 
+bool ObInactivityCop::need_full_sweep(ObNetHandler &nh, const ObHRTime now)
+{
+  bool bret = true;
+  if (nh.inactivity_wheel_.is_inited()) {
+    // the wheel knows nothing about force timeout, graceful exit, dead servers
+    // and vcs which have no inactivity timeout yet
+    ObHotUpgraderInfo &info = get_global_hot_upgrade_info();
+    bret = ATOMIC_BCAS(&nh.need_full_sweep_, true, false)
+           || now >= next_full_sweep_at_
+           || (info.graceful_exit_end_time_ >= info.graceful_exit_start_time_
+               && info.graceful_exit_end_time_ > 0
+               && info.graceful_exit_end_time_ < now)
+           || (0 < get_global_proxy_config().server_detect_mode
+               && get_global_resource_pool_processor().ip_set_.size() > 0);
+    if (bret) {
+      next_full_sweep_at_ = now + INACTIVITY_COP_FULL_SWEEP_INTERVAL;
+    }
+  }
+  return bret;
+}
+
+void ObInactivityCop::close_zero_copy_linger(ObNetHandler &nh, const ObHRTime now)
+{
+  int ret = OB_SUCCESS;
+  ObNetZeroCopy *zc = NULL;
+  ObNetZeroCopy *next = NULL;
+  for (zc = nh.zero_copy_linger_list_.head_; NULL != zc; zc = next) {
+    next = zc->link_.next_;
+    if (OB_FAIL(zc->reap(zc->fd_))) {
+      PROXY_NET_LOG(WDIAG, "fail to reap zero copy sends", K(zc->fd_), K(ret));
+    }
+    if (zc->has_pending() && zc->linger_deadline_ > now) {
+      // keep waiting, the peer may be slow to ack
+    } else {
+      if (zc->has_pending()) {
+        // reset the connection, so the kernel drops the queued data before the pages are reused
+        struct linger lin;
+        lin.l_onoff = 1;
+        lin.l_linger = 0;
+        PROXY_NET_LOG(INFO, "zero copy sends are not finished before deadline, reset connection",
+                      K(zc->fd_), "pending_count", zc->get_pending_count());
+        if (OB_FAIL(ObSocketManager::setsockopt(zc->fd_, SOL_SOCKET, SO_LINGER,
+            reinterpret_cast<const void *>(&lin), sizeof(lin)))) {
+          PROXY_NET_LOG(WDIAG, "fail to set SO_LINGER", K(zc->fd_), K(ret));
+        }
+      }
+      if (OB_FAIL(ObSocketManager::close(zc->fd_))) {
+        PROXY_NET_LOG(WDIAG, "fail to close fd", K(zc->fd_), K(ret));
+      }
+      nh.zero_copy_linger_list_.remove(zc);
+      delete zc;
+    }
+  }
+}
+
 int ObInactivityCop::keep_alive_lru(ObNetHandler &nh, const ObHRTime now, ObEvent *e)
 {
   int ret = OB_SUCCESS;
@@ -502,7 +613,20 @@ int ObInactivityCop::keep_alive_lru(ObNetHandler &nh, const ObHRTime now, ObEven
 ObNetHandler::ObNetHandler()
     : ObContinuation(NULL),
       trigger_event_(NULL),
-      keep_alive_lru_size_(0)
+      keep_alive_lru_size_(0),
+      need_full_sweep_(false),
+      busy_permille_(0),
+      load_window_start_(0),
+      load_window_idle_(0),
+      last_migrate_at_(0),
+      busy_poll_max_(0),
+      busy_poll_budget_(0),
+      last_active_at_(0),
+      last_poll_end_(0),
+      in_busy_poll_(false),
+      last_spin_idle_(false),
+      spin_time_(0),
+      work_time_(0)
 {
   SET_HANDLER(reinterpret_cast<NetContHandler>(&ObNetHandler::start_net_event));
 }
@@ -520,6 +644,12 @@ int ObNetHandler::start_net_event(int event, ObEvent *e)
     SET_HANDLER(reinterpret_cast<NetContHandler>(&ObNetHandler::main_net_event));
     e->schedule_every(NET_PERIOD);
     trigger_event_ = e;
+    if (get_global_proxy_config().enable_inactivity_timing_wheel
+        && OB_FAIL(inactivity_wheel_.init(INACTIVITY_WHEEL_TICK, get_hrtime()))) {
+      // the inactivity cop checks all vcs every second as before
+      PROXY_NET_LOG(WDIAG, "fail to init inactivity wheel", K(ret));
+      ret = OB_SUCCESS;
+    }
   }
   return (OB_SUCCESS == ret) ? EVENT_CONT : EVENT_ERROR;
 }
@@ -551,6 +681,192 @@ inline void ObNetHandler::process_enabled_list()
   }
 }
 
+// read the prepared vc synchronously when it can't go through io_uring
+static inline void sync_read_from_net(ObEThread &ethread, ObNetBatchIO &io)
+{
+  int64_t nread = 0;
+  int read_ret = ObSocketManager::readv(io.vc_->con_.fd_, io.iov_, io.niov_, nread);
+  // map the sys error code back to -errno
+  io.vc_->finish_read_from_net(ethread, io, OB_SUCCESS == read_ret ? nread : read_ret - OBPROXY_SYS_ERRNO_START);
+}
+
+// the client and server vcs of one sm share the vio mutex, the handler of one
+// may reset the read of the other one, so they are not read in the same batch
+static inline bool is_mutex_in_batch(const ObNetBatchIO *batch_io, const int64_t count,
+                                     const ObProxyMutex *mutex)
+{
+  bool bret = false;
+  for (int64_t i = 0; !bret && i < count; ++i) {
+    bret = (batch_io[i].mutex_.ptr_ == mutex);
+  }
+  return bret;
+}
+
+// Read all ready vcs through io_uring.
+// Each round prepares one readv per vc, submits the whole batch with a single
+// io_uring_enter() and then consumes the results in order. A plain socket is
+// O_NONBLOCK and sqes carry RWF_NOWAIT, so every readv completes inline and
+// waiting for all of them never blocks.
+void ObNetHandler::batch_read_from_net(ObEThread &ethread, ObIOUring &ring)
+{
+  int ret = OB_SUCCESS;
+  int close_ret = OB_SUCCESS;
+  ObNetPoll &net_poll = ethread.get_net_poll();
+  ObNetBatchIO *batch_io = net_poll.get_batch_io();
+  ObUnixNetVConnection *vc = NULL;
+  int64_t count = 0;
+  int64_t submitted = 0;
+  uint64_t user_data = 0;
+  int32_t res = 0;
+  bool is_batch_full = false;
+
+  while (OB_SUCC(ret) && !read_ready_list_.empty()) {
+    count = 0;
+    is_batch_full = false;
+    while (OB_SUCC(ret) && !is_batch_full && count < ObNetPoll::IO_URING_BATCH_SIZE
+           && NULL != (vc = read_ready_list_.dequeue())) {
+      if (vc->read_.in_batch_) {
+        // rescheduled by a handler while its read is in flight, finish_read_from_net() will handle it
+      } else if (vc->closed_) {
+        if (OB_UNLIKELY(OB_SUCCESS != (close_ret = vc->close()))) {
+          PROXY_NET_LOG(WDIAG, "fail to close unix net vconnection", K(vc), K(close_ret));
+        }
+      } else if (vc->using_ssl() && (vc->read_.enabled_ || vc->write_.enabled_)) {
+        vc->do_ssl_io(ethread);
+      } else if (vc->read_.enabled_ && vc->read_.triggered_ && !vc->using_ssl()
+                 && is_mutex_in_batch(batch_io, count, vc->read_.vio_.mutex_.ptr_)) {
+        // read it in the next round
+        read_ready_list_.in_or_enqueue(vc);
+        is_batch_full = true;
+      } else if (vc->read_.enabled_ && vc->read_.triggered_ && !vc->using_ssl()) {
+        ObNetBatchIO &io = batch_io[count];
+        if (vc->prepare_read_from_net(ethread, io)) {
+          if (OB_FAIL(ring.prep_readv(vc->con_.fd_, io.iov_, io.niov_, static_cast<uint64_t>(count)))) {
+            // no sqe for this vc, stop filling the batch
+            PROXY_NET_LOG(WDIAG, "fail to prepare io_uring readv", K(vc), K(count), K(ret));
+            sync_read_from_net(ethread, io);
+          } else {
+            ++count;
+          }
+        }
+      } else if (!vc->read_.enabled_) {
+        read_ready_list_.remove(vc);
+      }
+    }
+
+    if (count > 0) {
+      if (OB_SUCC(ret) && OB_FAIL(ring.submit_and_wait(static_cast<uint32_t>(count), submitted))) {
+        PROXY_NET_LOG(WDIAG, "fail to submit io_uring, fall back to epoll read path", K(count), K(ret));
+      } else if (OB_SUCC(ret)) {
+        NET_INCREMENT_DYN_STAT(NET_CALLS_TO_IO_URING_ENTER);
+        for (int64_t i = 0; i < count && ring.next_completion(user_data, res); ++i) {
+          if (OB_LIKELY(user_data < static_cast<uint64_t>(count) && NULL != batch_io[user_data].vc_)) {
+            batch_io[user_data].vc_->finish_read_from_net(ethread, batch_io[user_data], res);
+          }
+        }
+      }
+
+      // nothing has been submitted if failed, read the rest synchronously
+      // so that each prepared vc is finished exactly once
+      for (int64_t i = 0; i < count; ++i) {
+        if (NULL != batch_io[i].vc_) {
+          sync_read_from_net(ethread, batch_io[i]);
+        }
+      }
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    net_poll.disable_io_uring();
+  }
+}
+
+// write the prepared vc synchronously when it can't go through io_uring
+static inline void sync_write_to_net(ObEThread &ethread, ObNetBatchIO &io)
+{
+  int64_t nwrite = 0;
+  int write_ret = ObSocketManager::writev(io.vc_->con_.fd_, io.iov_, io.niov_, nwrite);
+  // map the sys error code back to -errno
+  io.vc_->finish_write_to_net(ethread, io, OB_SUCCESS == write_ret ? nwrite : write_ret - OBPROXY_SYS_ERRNO_START);
+}
+
+// Write all ready vcs through io_uring.
+// The writes enabled by handlers during this tick are collected in
+// write_ready_list_, and flushed here with one io_uring_enter() per
+// IO_URING_BATCH_SIZE vcs instead of one write()/writev() per vc.
+void ObNetHandler::batch_write_to_net(ObEThread &ethread, ObIOUring &ring)
+{
+  int ret = OB_SUCCESS;
+  int close_ret = OB_SUCCESS;
+  ObNetPoll &net_poll = ethread.get_net_poll();
+  ObNetBatchIO *batch_io = net_poll.get_batch_io();
+  ObUnixNetVConnection *vc = NULL;
+  int64_t count = 0;
+  int64_t submitted = 0;
+  uint64_t user_data = 0;
+  int32_t res = 0;
+
+  while (OB_SUCC(ret) && !write_ready_list_.empty()) {
+    count = 0;
+    while (OB_SUCC(ret) && count < ObNetPoll::IO_URING_BATCH_SIZE
+           && NULL != (vc = write_ready_list_.dequeue())) {
+      if (vc->write_.in_batch_) {
+        // rescheduled by a handler while its write is in flight, finish_write_to_net() will handle it
+      } else if (vc->closed_) {
+        if (OB_UNLIKELY(OB_SUCCESS != (close_ret = vc->close()))) {
+          PROXY_NET_LOG(WDIAG, "fail to close unix net vconnection", K(vc), K(close_ret));
+        }
+      } else if (vc->using_ssl() && (vc->read_.enabled_ || vc->write_.enabled_)) {
+        vc->do_ssl_io(ethread);
+      } else if (vc->write_.enabled_ && vc->write_.triggered_ && !vc->using_ssl()) {
+        if (INT64_MAX != vc->get_zero_copy_min_size()) {
+          // large writes may go through MSG_ZEROCOPY, which io_uring writev can't do
+          vc->write_to_net(ethread);
+        } else {
+          ObNetBatchIO &io = batch_io[count];
+          if (vc->prepare_write_to_net(ethread, io)) {
+            if (OB_FAIL(ring.prep_writev(vc->con_.fd_, io.iov_, io.niov_, static_cast<uint64_t>(count)))) {
+              // no sqe for this vc, stop filling the batch
+              PROXY_NET_LOG(WDIAG, "fail to prepare io_uring writev", K(vc), K(count), K(ret));
+              sync_write_to_net(ethread, io);
+            } else {
+              ++count;
+            }
+          }
+        }
+      } else if (!vc->write_.enabled_) {
+        write_ready_list_.remove(vc);
+      }
+    }
+
+    if (count > 0) {
+      if (OB_SUCC(ret) && OB_FAIL(ring.submit_and_wait(static_cast<uint32_t>(count), submitted))) {
+        PROXY_NET_LOG(WDIAG, "fail to submit io_uring, fall back to epoll write path", K(count), K(ret));
+      } else if (OB_SUCC(ret)) {
+        NET_INCREMENT_DYN_STAT(NET_CALLS_TO_IO_URING_ENTER);
+        NET_SUM_DYN_STAT(NET_WRITE_SYSCALLS_SAVED, count - 1);
+        for (int64_t i = 0; i < count && ring.next_completion(user_data, res); ++i) {
+          if (OB_LIKELY(user_data < static_cast<uint64_t>(count) && NULL != batch_io[user_data].vc_)) {
+            batch_io[user_data].vc_->finish_write_to_net(ethread, batch_io[user_data], res);
+          }
+        }
+      }
+
+      // nothing has been submitted if failed, write the rest synchronously
+      // so that each prepared vc is finished exactly once
+      for (int64_t i = 0; i < count; ++i) {
+        if (NULL != batch_io[i].vc_) {
+          sync_write_to_net(ethread, batch_io[i]);
+        }
+      }
+    }
+  }
+
+  if (OB_FAIL(ret)) {
+    net_poll.disable_io_uring();
+  }
+}
+
 // The main event for ObNetHandler
 // This is called every NET_PERIOD, and handles all IO operations scheduled
 // for this period.
@@ -574,18 +890,47 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
       ret = OB_ERR_UNEXPECTED;
       PROXY_NET_LOG(WDIAG, "fail to get trigger_event_'s ethread", K(trigger_event_), K(ret));
     } else {
-      if (OB_LIKELY(!read_ready_list_.empty() || !write_ready_list_.empty()
-            || !read_enable_list_.empty() || !write_enable_list_.empty())) {
+      const bool has_ready = !read_ready_list_.empty() || !write_ready_list_.empty()
+                             || !read_enable_list_.empty() || !write_enable_list_.empty();
+      bool is_spin = false;
+      if (OB_LIKELY(has_ready)) {
         poll_timeout = 0; // poll immediately returns -- we have triggered stuff to process right now
       } else {
         poll_timeout = (int32_t)(hrtime_to_msec(ethread->sleep_time_));
+        if (poll_timeout > 0 && inactivity_wheel_.get_count() > 0) {
+          poll_timeout = get_inactivity_wheel_timeout(poll_timeout);
+        }
+        // nothing to do, but the next request of a busy connection is likely
+        // to come soon, poll again instead of sleeping for a while
+        if (poll_timeout > 0 && need_busy_poll(get_hrtime_internal())) {
+          poll_timeout = 0;
+          is_spin = true;
+        }
+      }
+
+      // with coalesced wakeup, producers of external events write evfd_ only
+      // if this thread announced that it is going to sleep in epoll_wait
+      ObProtectedQueue &external_queue = ethread->event_queue_external_;
+      bool sleeping = false;
+      if (poll_timeout > 0 && external_queue.is_coalesced_wakeup()) {
+        if (external_queue.prepare_sleep()) {
+          sleeping = true;
+        } else {
+          poll_timeout = 0;
+        }
       }
 
       ObPollDescriptor &pd = ethread->get_net_poll().get_poll_descriptor();
-      if (OB_FAIL(ObSocketManager::epoll_wait(pd.epoll_fd_,
+      const ObHRTime poll_start = get_hrtime_internal();
+      ret = ObSocketManager::epoll_wait(pd.epoll_fd_,
           pd.epoll_triggered_events_,
           ObPollDescriptor::POLL_DESCRIPTOR_SIZE,
-          poll_timeout, pd.result_))) {
+          poll_timeout, pd.result_);
+      if (sleeping) {
+        external_queue.finish_sleep();
+      }
+      update_busy_poll(poll_start, get_hrtime_internal(), is_spin, has_ready || pd.result_ > 0);
+      if (OB_FAIL(ret)) {
       PROXY_NET_LOG(WDIAG, "fail to epoll_wait", K(pd.epoll_fd_),
                     K(pd.epoll_triggered_events_),
                     K(poll_timeout), K(ret));
@@ -602,6 +947,10 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
                 ret = OB_ERR_UNEXPECTED;
                 PROXY_NET_LOG(WDIAG, "fail to get ObUnixNetVConnection from epd->data_", K(ret));
               } else {
+                if ((epoll_events & EVENTIO_ERROR) && NULL != vc->zero_copy_) {
+                  // zero copy completions are reported as error events
+                  vc->reap_zero_copy();
+                }
                 if (epoll_events & (EVENTIO_READ | EVENTIO_ERROR)) {
                   vc->read_.triggered_ = true;
                   if (!read_ready_list_.in(vc)) {
@@ -641,6 +990,11 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
     if (OB_SUCC(ret)) {
       int close_ret = OB_SUCCESS;
 #if defined(USE_EDGE_TRIGGER)
+      ObIOUring *ring = ethread->get_net_poll().get_io_uring();
+      if (NULL != ring) {
+        batch_read_from_net(*ethread, *ring);
+      }
+
       // ObUnixNetVConnection *
       while (NULL != (vc = read_ready_list_.dequeue())) {
         if (vc->closed_) {
@@ -656,6 +1010,10 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
         }
       }
 
+      if (NULL != (ring = ethread->get_net_poll().get_io_uring())) {
+        batch_write_to_net(*ethread, *ring);
+      }
+
       while (NULL != (vc = write_ready_list_.dequeue())) {
         if (vc->closed_) {
           if (OB_UNLIKELY(OB_SUCCESS != (close_ret = vc->close()))) {
@@ -699,11 +1057,178 @@ int ObNetHandler::main_net_event(int event, ObEvent *e)
         }
       }
 #endif // !USE_EDGE_TRIGGER
+
+      if (inactivity_wheel_.is_inited()) {
+        process_inactivity_wheel(*ethread);
+      }
     }
   }
   return (OB_SUCCESS == ret) ? EVENT_CONT : EVENT_ERROR;
 }
 
+// Sleep in epoll_wait no longer than the next tick of the wheel which has vcs
+int32_t ObNetHandler::get_inactivity_wheel_timeout(const int32_t poll_timeout) const
+{
+  int32_t ret = poll_timeout;
+  const ObHRTime wait = inactivity_wheel_.next_expire_time() - get_hrtime();
+  if (wait <= 0) {
+    ret = 0;
+  } else if (wait < HRTIME_MSECONDS(poll_timeout)) {
+    // round up, or we would wake up a bit before the tick and poll again
+    ret = static_cast<int32_t>((wait + HRTIME_MSECOND - 1) / HRTIME_MSECOND);
+  }
+  return ret;
+}
+
+// The time out of epoll_wait and busy poll in each window is the load of
+// this thread, other threads only read the result.
+void ObNetHandler::update_load(const ObHRTime now, const ObHRTime idle)
+{
+  if (0 == load_window_start_) {
+    load_window_start_ = now - idle;
+  }
+  load_window_idle_ += idle;
+  const ObHRTime elapsed = now - load_window_start_;
+  if (elapsed >= NET_LOAD_WINDOW) {
+    const ObHRTime window_idle = std::min(load_window_idle_, elapsed);
+    ATOMIC_STORE(&busy_permille_, (elapsed - window_idle) * 1000 / elapsed);
+    load_window_start_ = now;
+    load_window_idle_ = 0;
+
+    const ObHRTime busy_poll_max = HRTIME_USECONDS(get_global_proxy_config().net_busy_poll_time.get());
+    if (busy_poll_max != busy_poll_max_) {
+      busy_poll_max_ = busy_poll_max;
+      busy_poll_budget_ = busy_poll_max;
+    }
+  }
+}
+
+// Busy poll for busy_poll_budget_ after the last poll which found work.
+// A busy poll phase which ends with nothing found halves the budget, so an
+// idle thread soon goes back to sleep in epoll_wait right away.
+bool ObNetHandler::need_busy_poll(const ObHRTime now)
+{
+  bool bret = false;
+  if (busy_poll_budget_ > 0) {
+    if (now - last_active_at_ < busy_poll_budget_) {
+      bret = true;
+    } else if (in_busy_poll_) {
+      busy_poll_budget_ = std::max(busy_poll_budget_ / 2, busy_poll_max_ >> NET_BUSY_POLL_MIN_SHIFT);
+    }
+  }
+  in_busy_poll_ = bret;
+  return bret;
+}
+
+// The time since the last poll is spin time if the last poll was a busy
+// poll which found nothing, as there was nothing to do but polling again.
+// Otherwise it is work, e.g. handling the vcs and events of this thread.
+void ObNetHandler::update_busy_poll(const ObHRTime poll_start, const ObHRTime poll_end,
+                                    const bool is_spin, const bool has_work)
+{
+  const ObHRTime outside = (last_poll_end_ > 0 && poll_start > last_poll_end_) ? poll_start - last_poll_end_ : 0;
+  ObHRTime idle = poll_end - poll_start;
+  if (last_spin_idle_) {
+    spin_time_ += outside;
+    idle += outside;
+  } else {
+    work_time_ += outside;
+  }
+  if (is_spin) {
+    spin_time_ += poll_end - poll_start;
+  }
+
+  if (has_work) {
+    if (is_spin) {
+      // the busy poll paid off, keep polling longer next time
+      busy_poll_budget_ = std::min(busy_poll_budget_ * 2, busy_poll_max_);
+    }
+    in_busy_poll_ = false;
+    last_active_at_ = poll_end;
+  }
+  last_spin_idle_ = is_spin && !has_work;
+  last_poll_end_ = poll_end;
+  update_load(poll_end, idle);
+}
+
+void ObNetHandler::set_socket_busy_poll(const int fd) const
+{
+  if (busy_poll_max_ > 0) {
+    int ret = OB_SUCCESS;
+    const int32_t usec = static_cast<int32_t>(hrtime_to_usec(busy_poll_max_));
+    if (OB_FAIL(ObSocketManager::setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+        reinterpret_cast<const void *>(&usec), sizeof(usec)))) {
+      // needs CAP_NET_ADMIN to go beyond net.core.busy_read
+      PROXY_NET_LOG(DEBUG, "fail to set sockopt SO_BUSY_POLL", K(fd), K(usec), K(ret));
+    }
+  }
+}
+
+bool ObNetHandler::need_migrate_out(const ObHRTime now) const
+{
+  return get_busy_permille() >= NET_MIGRATE_BUSY_PERMILLE
+         && now - last_migrate_at_ >= NET_MIGRATE_INTERVAL;
+}
+
+ObEThread *ObNetHandler::get_migrate_target(const ObHRTime now)
+{
+  ObEThread *target = NULL;
+  ObEThread *ethread = NULL;
+  int64_t min_busy = get_busy_permille() - NET_MIGRATE_BUSY_GAP;
+  int64_t busy = 0;
+  for (int64_t i = 0; i < g_event_processor.thread_count_for_type_[ET_NET]; ++i) {
+    ethread = g_event_processor.event_thread_[ET_NET][i];
+    if (NULL != ethread && NULL != ethread->net_handler_ && this != ethread->net_handler_
+        && (busy = ethread->net_handler_->get_busy_permille()) <= min_busy) {
+      min_busy = busy;
+      target = ethread;
+    }
+  }
+  if (NULL != target) {
+    last_migrate_at_ = now;
+  }
+  return target;
+}
+
+// The wheel keeps the timeout a vc was scheduled with, the vc is put back
+// with its current timeout if that has been extended since then.
+void ObNetHandler::process_inactivity_wheel(ObEThread &ethread)
+{
+  int ret = OB_SUCCESS;
+  const ObHRTime now = get_hrtime();
+  ObUnixNetVConnection *vc = NULL;
+  ObHRTime diff = 0;
+
+  inactivity_wheel_.advance(now, wheel_expired_list_);
+  while (NULL != (vc = wheel_expired_list_.pop())) {
+    NET_INCREMENT_DYN_STAT(INACTIVITY_WHEEL_EXPIRED);
+    MUTEX_TRY_LOCK(lock, vc->mutex_, &ethread);
+    if (!lock.is_locked()) {
+      NET_INCREMENT_DYN_STAT(INACTIVITY_COP_LOCK_ACQUIRE_FAILURE);
+      inactivity_wheel_.schedule(vc, now + NET_RETRY_DELAY);
+    } else if (vc->closed_) {
+      if (OB_FAIL(vc->close())) {
+        PROXY_NET_LOG(WDIAG, "fail to close unix net vconnection", K(vc), K(ret));
+      }
+    } else if (0 == vc->next_inactivity_timeout_at_) {
+      // timeout cancelled, scheduled again when a new one is set
+    } else if (vc->next_inactivity_timeout_at_ > now) {
+      inactivity_wheel_.schedule(vc, vc->next_inactivity_timeout_at_);
+    } else {
+      if (keep_alive_list_.in(vc)) {
+        // only stat if the connection is in keep-alive, there can be other inactivity timeouts
+        diff = (now - (vc->next_inactivity_timeout_at_ - vc->inactivity_timeout_in_)) / HRTIME_SECOND;
+        NET_SUM_DYN_STAT(KEEP_ALIVE_LRU_TIMEOUT_TOTAL, diff);
+        NET_INCREMENT_DYN_STAT(KEEP_ALIVE_LRU_TIMEOUT_COUNT);
+      }
+      PROXY_NET_LOG(DEBUG, "inactivity timeout expired in wheel", K(vc), K(vc->source_type_), K(now),
+                    "next_inactivity_timeout_at", hrtime_to_sec(vc->next_inactivity_timeout_at_),
+                    "inactivity_timeout_in", hrtime_to_sec(vc->inactivity_timeout_in_));
+      vc->handle_event(EVENT_IMMEDIATE, trigger_event_);
+    }
+  }
+}
+
 } // end of namespace net
 } // end of namespace obproxy
 } // end of namespace oceanbase
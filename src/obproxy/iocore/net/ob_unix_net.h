@@ -33,8 +33,10 @@
 #define OBPROXY_UNIX_NET_H
 
 #include "iocore/net/ob_poll_descriptor.h"
+#include "iocore/net/ob_io_uring.h"
 #include "iocore/net/ob_unix_net_processor.h"
 #include "iocore/net/ob_unix_net_vconnection.h"
+#include "iocore/eventsystem/ob_timing_wheel.h"
 
 namespace oceanbase
 {
@@ -50,9 +52,41 @@ typedef int (ObNetHandler::*NetContHandler)(int event, void *data);
 
 #define TRANSIENT_ACCEPT_ERROR_MESSAGE_EVERY      HRTIME_HOURS(24)
 #define NET_RETRY_DELAY                           HRTIME_MSECONDS(1)
+#define INACTIVITY_WHEEL_TICK                     HRTIME_MSECONDS(10)
+#define INACTIVITY_COP_FULL_SWEEP_INTERVAL        HRTIME_SECONDS(10)
+#define NET_LOAD_WINDOW                           HRTIME_MSECONDS(100)
+// a net thread this busy moves idle client sessions to a thread which is
+// at least NET_MIGRATE_BUSY_GAP less busy, one every NET_MIGRATE_INTERVAL
+#define NET_MIGRATE_BUSY_PERMILLE                 700
+#define NET_MIGRATE_BUSY_GAP                      300
+#define NET_MIGRATE_INTERVAL                      HRTIME_MSECONDS(10)
+// a busy poll phase which finds nothing halves the budget, down to
+// net_busy_poll_time >> NET_BUSY_POLL_MIN_SHIFT
+#define NET_BUSY_POLL_MIN_SHIFT                   4
 #define NET_PERIOD                               -HRTIME_MSECONDS(1)
 #define ACCEPT_PERIOD                            -HRTIME_MSECONDS(1)
 
+// One socket io prepared by a vc, submitted to io_uring together
+// with the io of other vcs in the same batch.
+struct ObNetBatchIO
+{
+  ObNetBatchIO() : vc_(NULL), mutex_(), reader_(NULL), writer_(NULL), attempted_(0), niov_(0), signalled_(false) { }
+  ~ObNetBatchIO() { }
+
+  ObUnixNetVConnection *vc_;
+  // vio mutex held from prepare to finish
+  common::ObPtr<event::ObProxyMutex> mutex_;
+  // write only, reader of the vio when the io is prepared
+  event::ObIOBufferReader *reader_;
+  // read only, writer of the vio when the io is prepared
+  event::ObMIOBuffer *writer_;
+  int64_t attempted_;
+  int32_t niov_;
+  // write only, WRITE_READY has been signalled when calculating towrite
+  bool signalled_;
+  struct iovec iov_[NET_MAX_IOV];
+};
+
 class ObNetPoll
 {
 public:
@@ -63,19 +97,34 @@ public:
   int timerfd_settime();
   int get_timer_fd() { return timer_fd_; }
 
+  // NULL if io_uring is disabled or not supported by kernel,
+  // in which case net handler reads each vc with read()/readv()
+  ObIOUring *get_io_uring() { return io_uring_; }
+  ObNetBatchIO *get_batch_io() { return batch_io_; }
+  void disable_io_uring();
+
+private:
+  int init_io_uring();
+
 public:
+  static const int64_t IO_URING_BATCH_SIZE = 64;
   ObPollDescriptor *poll_descriptor_;
 
 private:
   ObNetHandler &nh_;
   int timer_fd_;
   ObEventIO *ep_;
+  ObIOUring *io_uring_;
+  ObNetBatchIO *batch_io_;
 
   DISALLOW_COPY_AND_ASSIGN(ObNetPoll);
 };
 
 // One Inactivity cop runs on each thread once every second and
-// loops through the list of NetVCs and calls the timeouts
+// loops through the list of NetVCs and calls the timeouts.
+// If the net handler keeps inactivity timeouts in its timing wheel, the
+// cop only loops through all NetVCs every INACTIVITY_COP_FULL_SWEEP_INTERVAL,
+// or when some NetVCs must be checked, e.g. on graceful exit
 class ObInactivityCop : public event::ObContinuation
 {
 public:
@@ -90,12 +139,15 @@ public:
 
 private:
   int keep_alive_lru(ObNetHandler &nh, ObHRTime now, event::ObEvent *e);
+  bool need_full_sweep(ObNetHandler &nh, const ObHRTime now);
+  void close_zero_copy_linger(ObNetHandler &nh, const ObHRTime now);
 
 private:
   int64_t default_inactivity_timeout_;  // only used when one is not set for some bad reason
   int64_t total_connections_in_;
   int64_t max_connections_in_;
   int64_t connections_per_thread_in_;
+  ObHRTime next_full_sweep_at_;
 
   DISALLOW_COPY_AND_ASSIGN(ObInactivityCop);
 };
@@ -105,6 +157,8 @@ private:
 class ObNetHandler : public event::ObContinuation
 {
 public:
+  typedef event::ObTimingWheel<ObUnixNetVConnection, ObUnixNetVConnection::Link_wheel_link_> ObInactivityWheel;
+
   ObNetHandler();
   virtual ~ObNetHandler() {}
 
@@ -113,6 +167,29 @@ public:
 private:
   int main_net_event(int event, event::ObEvent *data);
   void process_enabled_list();
+  void batch_read_from_net(event::ObEThread &ethread, ObIOUring &ring);
+  void batch_write_to_net(event::ObEThread &ethread, ObIOUring &ring);
+  void process_inactivity_wheel(event::ObEThread &ethread);
+  int32_t get_inactivity_wheel_timeout(const int32_t poll_timeout) const;
+  void update_load(const ObHRTime now, const ObHRTime idle);
+  bool need_busy_poll(const ObHRTime now);
+  void update_busy_poll(const ObHRTime poll_start, const ObHRTime poll_end,
+                        const bool is_spin, const bool has_work);
+
+public:
+  // permille of the last load window this thread spent outside epoll_wait
+  int64_t get_busy_permille() const { return ATOMIC_LOAD(&busy_permille_); }
+  // whether this thread is busy enough to move a client session out now
+  bool need_migrate_out(const ObHRTime now) const;
+  // the least busy net thread which is clearly less busy than this one,
+  // NULL if there is none. Called on the thread of this handler.
+  event::ObEThread *get_migrate_target(const ObHRTime now);
+  // SO_BUSY_POLL on the socket if busy poll is enabled, ignore failure
+  void set_socket_busy_poll(const int fd) const;
+  // time spent in busy poll which found nothing, and outside epoll_wait
+  // on everything else. Only read on the thread of this handler.
+  ObHRTime get_spin_time() const { return spin_time_; }
+  ObHRTime get_work_time() const { return work_time_; }
 
 public:
   event::ObEvent *trigger_event_;
@@ -123,10 +200,34 @@ public:
   ASLLM(ObUnixNetVConnection, ObNetState, read_, enable_link_) read_enable_list_;
   ASLLM(ObUnixNetVConnection, ObNetState, write_, enable_link_) write_enable_list_;
   Que(ObUnixNetVConnection, keep_alive_link_) keep_alive_list_;
+  // sockets closed with unfinished zero copy sends
+  Que(ObNetZeroCopy, link_) zero_copy_linger_list_;
+  // inactivity timeouts of vcs, only inited if enable_inactivity_timing_wheel is set
+  ObInactivityWheel inactivity_wheel_;
+  Que(ObUnixNetVConnection, wheel_link_) wheel_expired_list_;
 
   int64_t keep_alive_lru_size_;
+  // set by other threads to let the inactivity cop check all vcs
+  volatile bool need_full_sweep_;
 
 private:
+  volatile int64_t busy_permille_;
+  ObHRTime load_window_start_;
+  ObHRTime load_window_idle_;
+  ObHRTime last_migrate_at_;
+
+  // net_busy_poll_time, refreshed every NET_LOAD_WINDOW
+  ObHRTime busy_poll_max_;
+  // how long to keep polling after the last work, adapted to the load
+  ObHRTime busy_poll_budget_;
+  ObHRTime last_active_at_;
+  ObHRTime last_poll_end_;
+  bool in_busy_poll_;
+  // the last poll was a busy poll which found nothing
+  bool last_spin_idle_;
+  ObHRTime spin_time_;
+  ObHRTime work_time_;
+
   DISALLOW_COPY_AND_ASSIGN(ObNetHandler);
 };
 
@@ -73,6 +73,7 @@ void ObNetProcessor::ObAcceptOptions::reset()
   f_callback_on_open_ = false;
   localhost_only_ = false;
   frequent_accept_ = true;
+  reuse_port_ = false;
   backdoor_ = false;
   defer_accept_timeout_ = 0;
   recv_bufsize_ = 0;
@@ -159,7 +160,11 @@ inline ObAction *ObUnixNetProcessor::accept_internal(ObContinuation &cont, int f
     ObNetAccept *net_accept = NULL;
     int64_t ret_len = 0;
     if (opt.frequent_accept_) {
-      if (accept_threads_ > 0) {
+      if (opt.reuse_port_) {
+        if (OB_FAIL(na->init_accept_per_thread_reuse_port())) {
+          PROXY_NET_LOG(EDIAG, "fail to init_accept_per_thread_reuse_port", K(ret));
+        }
+      } else if (accept_threads_ > 0) {
         if (OB_FAIL(na->do_listen(BLOCKING))) {
           PROXY_NET_LOG(EDIAG, "fail to do_listen BLOCKING", K(ret));
         } else {
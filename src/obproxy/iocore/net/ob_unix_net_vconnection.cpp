@@ -34,6 +34,7 @@
 #include "iocore/net/ob_event_io.h"
 #include "iocore/net/ob_vtoa_user.h"
 #include "iocore/net/ob_ssl_processor.h"
+#include "iocore/net/ob_net_ktls.h"
 #include "obutils/ob_proxy_config.h"
 
 using namespace oceanbase::common;
@@ -48,8 +49,6 @@ namespace obproxy
 namespace net
 {
 
-static const int64_t NET_MAX_IOV = 16;
-
 static inline ObNetState &get_net_state_by_vio(ObVIO &vio)
 {
   return *(reinterpret_cast<ObNetState *>(
@@ -208,11 +207,124 @@ inline void ObUnixNetVConnection::net_activity()
 {
   if (inactivity_timeout_in_ > 0) {
     next_inactivity_timeout_at_ = get_hrtime() + inactivity_timeout_in_;
+    update_inactivity_wheel();
   } else {
     next_inactivity_timeout_at_ = 0;
   }
 }
 
+void ObUnixNetVConnection::update_inactivity_wheel()
+{
+  if (OB_LIKELY(NULL != nh_) && nh_->inactivity_wheel_.is_inited() && thread_ == this_ethread()) {
+    // a closed vc is closed by the net handler at the next tick
+    const ObHRTime expire_at = (0 != closed_) ? get_hrtime() : next_inactivity_timeout_at_;
+    if (expire_at <= 0) {
+      // no inactivity timeout
+    } else if (nh_->inactivity_wheel_.in(this)) {
+      if (expire_at < wheel_expire_at_) {
+        nh_->inactivity_wheel_.schedule(this, expire_at);
+      }
+    } else if (!nh_->wheel_expired_list_.in(this)) {
+      // a vc on the expired list will be checked again with its new timeout
+      nh_->inactivity_wheel_.schedule(this, expire_at);
+    }
+  }
+}
+
+void ObUnixNetVConnection::set_is_force_timeout(const bool force_timeout)
+{
+  ObNetVConnection::set_is_force_timeout(force_timeout);
+  if (force_timeout && NULL != nh_) {
+    // the wheel belongs to the thread of the vc, let the inactivity cop check all vcs
+    ATOMIC_STORE(&nh_->need_full_sweep_, true);
+  }
+}
+
+int ObUnixNetVConnection::detach_from_thread()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(nh_) || OB_UNLIKELY(thread_ != this_ethread())) {
+    ret = OB_ERR_UNEXPECTED;
+    PROXY_NET_LOG(WDIAG, "vc must be detached on its own thread", K(this), K(ret));
+  } else if (0 != closed_ || read_.in_enabled_list_ || write_.in_enabled_list_
+             || read_.in_batch_ || write_.in_batch_
+             || (NULL != zero_copy_ && zero_copy_->has_pending())
+             || (using_ssl_ && !ssl_connected_)) {
+    // io in flight
+    ret = OB_EAGAIN;
+  } else {
+    MUTEX_TRY_LOCK(lock, nh_->mutex_, thread_);
+    if (!lock.is_locked()) {
+      ret = OB_EAGAIN;
+    } else if (OB_FAIL(ep_->stop())) {
+      PROXY_NET_LOG(WDIAG, "fail to stop event io", K(this), K(ret));
+    } else {
+      remove_from_keep_alive_lru();
+      nh_->open_list_.remove(this);
+      nh_->cop_list_.remove(this);
+      if (nh_->inactivity_wheel_.in(this)) {
+        nh_->inactivity_wheel_.remove(this);
+      } else {
+        nh_->wheel_expired_list_.remove(this);
+      }
+      nh_->read_ready_list_.remove(this);
+      nh_->write_ready_list_.remove(this);
+      // rescheduled on the new thread with the same timeout
+      if (NULL != active_timeout_action_) {
+        if (OB_SUCCESS != active_timeout_action_->cancel(this)) {
+          PROXY_NET_LOG(WDIAG, "fail to cancel active timeout action", K(this));
+        }
+        active_timeout_action_ = NULL;
+      }
+      if (VC_ACCEPT == source_type_) {
+        NET_ATOMIC_DECREMENT_DYN_STAT(thread_, NET_CLIENT_CONNECTIONS_CURRENTLY_OPEN);
+      }
+      nh_ = NULL;
+      thread_ = NULL;
+    }
+  }
+  return ret;
+}
+
+int ObUnixNetVConnection::attach_to_thread(ObEThread &ethread)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL != nh_) || OB_UNLIKELY(&ethread != this_ethread())) {
+    ret = OB_ERR_UNEXPECTED;
+    PROXY_NET_LOG(WDIAG, "vc must be attached on the target thread", K(this), K(ret));
+  } else {
+    // set first, so that the vc can be closed on this thread even if attach fails
+    thread_ = &ethread;
+    nh_ = &ethread.get_net_handler();
+    if (VC_ACCEPT == source_type_) {
+      NET_ATOMIC_INCREMENT_DYN_STAT(thread_, NET_CLIENT_CONNECTIONS_CURRENTLY_OPEN);
+    }
+    MUTEX_TRY_LOCK(lock, nh_->mutex_, thread_);
+    if (!lock.is_locked()) {
+      ret = OB_EAGAIN;
+    } else if (OB_FAIL(ep_->start(thread_->get_net_poll().get_poll_descriptor(),
+                                  *this, EVENTIO_READ | EVENTIO_WRITE))) {
+      PROXY_NET_LOG(WDIAG, "fail to start event io", K(this), K(ret));
+    } else {
+      nh_->open_list_.enqueue(this);
+      update_inactivity_wheel();
+      if (active_timeout_in_ > 0 && OB_FAIL(set_active_timeout(active_timeout_in_))) {
+        PROXY_NET_LOG(WDIAG, "fail to set_active_timeout", K(active_timeout_in_), K(this), K(ret));
+      }
+      if (get_is_force_timeout()) {
+        ATOMIC_STORE(&nh_->need_full_sweep_, true);
+      }
+      // data which arrived while detached is reported by epoll again,
+      // check it anyway in case the edge was consumed on the old thread
+      if (read_.enabled_) {
+        read_.triggered_ = true;
+        read_reschedule();
+      }
+    }
+  }
+  return ret;
+}
+
 inline bool ObUnixNetVConnection::check_read_state()
 {
   bool ret = true;
@@ -305,7 +417,8 @@ inline bool ObUnixNetVConnection::handle_read_from_net_error(ObEThread &thread,
     NET_INCREMENT_DYN_STAT(NET_CALLS_TO_READ_NODATA);
     read_.triggered_ = false;
     nh_->read_ready_list_.remove(this);
-  } else if (0 == total_read || OB_SYS_ECONNRESET == error) {
+  } else if (0 == total_read || OB_SYS_ECONNRESET == error
+             || (ktls_offloaded_ && OB_SYS_EIO == error)) {
     if (OB_SYS_ETIMEDOUT == error) {
       PROXY_NET_LOG(INFO, "recv OB_SYS_ETIMEDOUT error when read, maybe KeepAlive fail");
     }
@@ -468,7 +581,11 @@ inline int ObUnixNetVConnection::close()
     PROXY_NET_LOG(WDIAG, "fail to stop event io", "vc: ", this, K(ret));
   }
 
-  if (OB_FAIL(con_.close())) {
+  if (NULL != zero_copy_) {
+    linger_zero_copy();
+  }
+
+  if (NO_FD != con_.fd_ && OB_FAIL(con_.close())) {
     PROXY_NET_LOG(WDIAG, "fail to close connection", "vc: ", this, K(ret));
   }
 
@@ -486,6 +603,11 @@ inline int ObUnixNetVConnection::close()
   active_timeout_in_ = 0;
   nh_->open_list_.remove(this);
   nh_->cop_list_.remove(this);
+  if (nh_->inactivity_wheel_.in(this)) {
+    nh_->inactivity_wheel_.remove(this);
+  } else {
+    nh_->wheel_expired_list_.remove(this);
+  }
   nh_->read_ready_list_.remove(this);
   nh_->write_ready_list_.remove(this);
 
@@ -652,6 +774,132 @@ inline void ObUnixNetVConnection::read_from_net(ObEThread &thread)
   }
 }
 
+// Prepare one readv for a batched read.
+// If return true, the iovec is filled and the read vio mutex is held until
+// finish_read_from_net() is called, otherwise this vc has been rescheduled
+// or disabled just like read_from_net() does.
+bool ObUnixNetVConnection::prepare_read_from_net(ObEThread &thread, ObNetBatchIO &io)
+{
+  bool bret = false;
+  ObProxyMutex *mutex_ = thread.mutex_;
+  NET_INCREMENT_DYN_STAT(NET_CALLS_TO_READFROMNET);
+
+  common::ObPtr<ObProxyMutex> vio_mutex(read_.vio_.mutex_);
+  if (OB_UNLIKELY(!MUTEX_TAKE_TRY_LOCK(vio_mutex.ptr_, &thread))) {
+    read_reschedule();
+  } else if (OB_UNLIKELY(!check_read_state())) {
+    PROXY_NET_LOG(WDIAG, "fail to check_read_state", K(this));
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+  } else {
+    reenable_read_time_at_ = 0;
+    int64_t ntodo = read_.vio_.ntodo();
+    int64_t toread = 0;
+    ObMIOBuffer &writer = *(read_.vio_.buffer_.writer());
+    ObIOBufferBlock *block = writer.first_write_block();
+
+    if (0 == read_.active_count_ || (NULL != block && block->write_avail() > 0)) {
+      toread = writer.write_avail();
+    } else {
+      toread = writer.write_avail(ntodo);
+      block = writer.first_write_block();
+    }
+
+    if (toread > ntodo) {
+      toread = ntodo;
+    }
+
+    int64_t len = 0;
+    io.niov_ = 0;
+    io.attempted_ = 0;
+    while (NULL != block && io.attempted_ < toread && io.niov_ < NET_MAX_IOV) {
+      if ((len = block->write_avail()) > 0) {
+        if (len > toread - io.attempted_) {
+          len = toread - io.attempted_;
+        }
+        io.iov_[io.niov_].iov_base = block->end_;
+        io.iov_[io.niov_].iov_len = len;
+        io.attempted_ += len;
+        ++io.niov_;
+      }
+      block = block->next_;
+    }
+
+    if (io.attempted_ > 0) {
+      io.vc_ = this;
+      io.mutex_ = vio_mutex;
+      io.writer_ = &writer;
+      read_.in_batch_ = true;
+      // pin this vc, a close during the batch is deferred to finish_read_from_net()
+      ++recursion_;
+      bret = true;
+    } else {
+      // writer.write_avail() <= 0
+      if (read_.vio_.ntodo() <= 0 || !read_.enabled_ || (read_.triggered_ && 0 == writer.write_avail())) {
+        read_disable();
+      } else {
+        read_reschedule();
+      }
+      MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+    }
+  }
+  return bret;
+}
+
+// Consume the result of a batched readv, result is bytes read or -errno.
+void ObUnixNetVConnection::finish_read_from_net(ObEThread &thread, ObNetBatchIO &io, const int64_t result)
+{
+  int ret = OB_SUCCESS;
+  ObProxyMutex *mutex_ = thread.mutex_;
+  common::ObPtr<ObProxyMutex> vio_mutex(io.mutex_);
+  ObMIOBuffer *old_writer = io.writer_;
+  bool is_done = true;
+  NET_INCREMENT_DYN_STAT(NET_CALLS_TO_READ);
+
+  io.vc_ = NULL;
+  io.mutex_.release();
+  io.writer_ = NULL;
+  read_.in_batch_ = false;
+  --recursion_;
+
+  if (OB_UNLIKELY(0 != closed_)) {
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+    if (0 == recursion_ && OB_FAIL(close())) {
+      PROXY_NET_LOG(WDIAG, "fail to close unix net vconnection", K(this), K(ret));
+    }
+  } else if (OB_UNLIKELY(!read_.enabled_ || old_writer != read_.vio_.buffer_.writer())) {
+    // the read vio was reset by another handler in this batch,
+    // the bytes read belong to the old buffer which is dropped
+    PROXY_NET_LOG(WDIAG, "read vio changed during batched read", K(this), K(result));
+    read_reschedule();
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+  } else {
+    if (result > 0) {
+      ++read_.active_count_;
+      if (result < io.attempted_) {
+        // the socket is edge triggered and has been drained by this short read,
+        // new data will trigger epoll again, needn't read once more only to get EAGAIN
+        read_.triggered_ = false;
+      }
+      is_done = handle_read_from_net_success(thread, vio_mutex.ptr_, result);
+    } else {
+      const int error = (0 == result) ? OB_SUCCESS : ob_get_sys_errno(static_cast<int>(-result));
+      is_done = handle_read_from_net_error(thread, 0, error, 0);
+    }
+
+    if (!is_done) {
+      ObMIOBuffer *writer = read_.vio_.buffer_.writer();
+      if (read_.vio_.ntodo() <= 0 || !read_.enabled_
+          || (read_.triggered_ && (NULL == writer || 0 == writer->write_avail()))) {
+        read_disable();
+      } else {
+        read_reschedule();
+      }
+    }
+    // if is_done, this vc may have been freed, do not touch it any more
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+  }
+}
+
 inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
                        const int64_t towrite, int64_t &total_write, int &tmp_code)
 {
@@ -661,6 +909,10 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
   int64_t wattempted = 0;
   int32_t niov = 0;
   struct iovec tiovec[NET_MAX_IOV];
+  ObIOBufferBlock *tblocks[NET_MAX_IOV];
+  int32_t zc_niov = 0;
+  int64_t zc_bytes = 0;
+  const int64_t zc_min_size = get_zero_copy_min_size();
 
   int64_t len = -1;
   int64_t remain = 0;
@@ -699,6 +951,7 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
           tiovec[niov].iov_base = block->start() + offset;
           offset = 0;
           tiovec[niov].iov_len = len;
+          tblocks[niov] = block;
           wattempted += len;
           ++niov;
 
@@ -713,7 +966,29 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
           }
         } while (NULL != block && (0 < (len = block->read_avail())) && niov < NET_MAX_IOV);
 
-        if (using_ssl_) {
+        zc_niov = 0;
+        zc_bytes = 0;
+        if (wattempted >= zc_min_size && (zc_niov = prepare_zero_copy_send(reader, tblocks, niov)) > 0) {
+          for (int32_t i = 0; i < zc_niov; ++i) {
+            zc_bytes += tiovec[i].iov_len;
+          }
+          if (zc_bytes < zc_min_size) {
+            zc_niov = 0;
+          } else if (zc_niov < niov) {
+            // the rest blocks will be sent in the next round
+            wattempted = zc_bytes;
+            block = tblocks[zc_niov];
+            len = block->read_avail();
+          }
+        }
+
+        if (zc_niov > 0) {
+          if (OB_SUCC(zero_copy_->send(con_.fd_, &tiovec[0], zc_niov, &tblocks[0], count))) {
+            total_write += count;
+            NET_INCREMENT_DYN_STAT(NET_CALLS_TO_ZERO_COPY_SEND);
+            NET_SUM_DYN_STAT(NET_ZERO_COPY_SEND_BYTES, count);
+          }
+        } else if (using_ssl_) {
           if (OB_FAIL(ObSocketManager::ssl_write(ssl_, tiovec[0].iov_base, tiovec[0].iov_len, count, tmp_code))) {
             PROXY_NET_LOG(INFO, "ssl write failed", K(ret));
           } else if (count > 0)  {
@@ -743,6 +1018,76 @@ inline int ObUnixNetVConnection::write_to_net_internal(ObIOBufferReader &reader,
   return ret;
 }
 
+int64_t ObUnixNetVConnection::get_zero_copy_min_size() const
+{
+  int64_t min_size = INT64_MAX;
+  if (VC_ACCEPT == source_type_ && !using_ssl_ && !ktls_offloaded_ && !zero_copy_disabled_
+      && get_global_proxy_config().enable_zero_copy_send
+      && (NULL == zero_copy_ || !zero_copy_->is_copied())) {
+    min_size = get_global_proxy_config().zero_copy_send_min_size;
+  }
+  return min_size;
+}
+
+int32_t ObUnixNetVConnection::prepare_zero_copy_send(const ObIOBufferReader &reader,
+                                                     ObIOBufferBlock *const *blocks,
+                                                     const int32_t niov)
+{
+  int ret = OB_SUCCESS;
+  int32_t zc_niov = 0;
+  if (NULL == zero_copy_) {
+    if (OB_FAIL(ObNetZeroCopy::enable(con_.fd_))) {
+      zero_copy_disabled_ = true;
+    } else if (OB_ISNULL(zero_copy_ = new (std::nothrow) ObNetZeroCopy())) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      zero_copy_disabled_ = true;
+      PROXY_NET_LOG(WDIAG, "fail to alloc ObNetZeroCopy", K(ret));
+    }
+  } else {
+    reap_zero_copy();
+  }
+
+  if (OB_SUCC(ret) && zero_copy_->can_send()) {
+    // the last block with data is rewritten in place when the buffer is reset,
+    // so it can't be pinned, see ObMIOBuffer::reset()
+    const ObIOBufferBlock *writer = (NULL == reader.mbuf_) ? NULL : reader.mbuf_->writer_.ptr_;
+    while (zc_niov < niov && blocks[zc_niov] != writer) {
+      ++zc_niov;
+    }
+  }
+  return zc_niov;
+}
+
+void ObUnixNetVConnection::reap_zero_copy()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(zero_copy_->reap(con_.fd_))) {
+    PROXY_NET_LOG(WDIAG, "fail to reap zero copy sends", "vc", this, K(ret));
+  }
+}
+
+void ObUnixNetVConnection::linger_zero_copy()
+{
+  int ret = OB_SUCCESS;
+  reap_zero_copy();
+  if (zero_copy_->has_pending() && NO_FD != con_.fd_) {
+    // the kernel may still send from the pinned buffers, closing the socket now
+    // would not stop it, so keep the socket until all sends are finished
+    if (OB_FAIL(ObSocketManager::shutdown(con_.fd_, SHUT_WR))) {
+      PROXY_NET_LOG(DEBUG, "fail to shutdown socket", K(con_.fd_), K(ret));
+    }
+    PROXY_NET_LOG(DEBUG, "linger socket for zero copy sends", K(con_.fd_),
+                  "pending_count", zero_copy_->get_pending_count());
+    zero_copy_->fd_ = con_.fd_;
+    zero_copy_->linger_deadline_ = get_hrtime() + HRTIME_SECONDS(ZERO_COPY_LINGER_TIMEOUT);
+    nh_->zero_copy_linger_list_.enqueue(zero_copy_);
+    con_.is_connected_ = false;
+    con_.is_bound_ = false;
+    con_.fd_ = NO_FD;
+    zero_copy_ = NULL;
+  }
+}
+
 // Write the data for a ObUnixNetVConnection.
 // Rescheduling the ObUnixNetVConnection when necessary.
 inline void ObUnixNetVConnection::write_to_net(ObEThread &thread)
@@ -803,12 +1148,132 @@ inline void ObUnixNetVConnection::write_to_net(ObEThread &thread)
   }
 }
 
+bool ObUnixNetVConnection::prepare_write_to_net(ObEThread &thread, ObNetBatchIO &io)
+{
+  bool bret = false;
+  ObProxyMutex *mutex_ = thread.mutex_;
+  NET_INCREMENT_DYN_STAT(NET_CALLS_TO_WRITETONET);
+
+  common::ObPtr<ObProxyMutex> vio_mutex(write_.vio_.mutex_);
+  if (OB_UNLIKELY(!MUTEX_TAKE_TRY_LOCK(vio_mutex.ptr_, &thread))) {
+    write_reschedule();
+  } else if (OB_UNLIKELY(!check_write_state())) {
+    PROXY_NET_LOG(DEBUG, "fail to check_write_state", K(this));
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+  } else {
+    int64_t towrite = 0;
+    bool signalled = false;
+    if (calculate_towrite_size(towrite, signalled)) {
+      // this vc may have been freed
+    } else if (towrite > 0) {
+      ObIOBufferReader &reader = *(write_.vio_.buffer_.reader());
+      ObIOBufferBlock *block = reader.block_;
+      int64_t offset = reader.start_offset_;
+      int64_t len = 0;
+      io.niov_ = 0;
+      io.attempted_ = 0;
+      // merge all blocks with data into one writev, as write_to_net_internal() does
+      while (NULL != block && io.attempted_ < towrite && io.niov_ < NET_MAX_IOV) {
+        if ((len = block->read_avail() - offset) > 0) {
+          if (len > towrite - io.attempted_) {
+            len = towrite - io.attempted_;
+          }
+          io.iov_[io.niov_].iov_base = block->start() + offset;
+          io.iov_[io.niov_].iov_len = len;
+          io.attempted_ += len;
+          ++io.niov_;
+          offset = 0;
+        } else {
+          offset = -len;
+        }
+        block = block->next_;
+      }
+
+      if (io.attempted_ > 0) {
+        io.vc_ = this;
+        io.mutex_ = vio_mutex;
+        io.reader_ = &reader;
+        io.signalled_ = signalled;
+        write_.in_batch_ = true;
+        // pin this vc, a close during the batch is deferred to finish_write_to_net()
+        ++recursion_;
+        bret = true;
+      } else {
+        write_reschedule();
+      }
+    } else if (0 == write_.vio_.buffer_.reader()->read_avail()) {
+      write_disable();
+    } else {
+      write_reschedule();
+    }
+
+    if (!bret) {
+      MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+    }
+  }
+  return bret;
+}
+
+// Consume the result of a batched writev, result is bytes written or -errno.
+void ObUnixNetVConnection::finish_write_to_net(ObEThread &thread, ObNetBatchIO &io, const int64_t result)
+{
+  int ret = OB_SUCCESS;
+  ObProxyMutex *mutex_ = thread.mutex_;
+  common::ObPtr<ObProxyMutex> vio_mutex(io.mutex_);
+  ObIOBufferReader *old_reader = io.reader_;
+  bool is_done = true;
+  NET_INCREMENT_DYN_STAT(NET_CALLS_TO_WRITE);
+
+  io.vc_ = NULL;
+  io.mutex_.release();
+  io.reader_ = NULL;
+  write_.in_batch_ = false;
+  --recursion_;
+
+  if (OB_UNLIKELY(0 != closed_)) {
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+    if (0 == recursion_ && OB_FAIL(close())) {
+      PROXY_NET_LOG(WDIAG, "fail to close unix net vconnection", K(this), K(ret));
+    }
+  } else if (OB_UNLIKELY(!write_.enabled_ || old_reader != write_.vio_.buffer_.reader())) {
+    // the write vio was reset by another vc's handler in this batch,
+    // the bytes written belong to the old buffer which is dropped
+    PROXY_NET_LOG(DEBUG, "write vio changed during batched write", K(this), K(result));
+    write_reschedule();
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+  } else {
+    if (result > 0) {
+      if (result < io.attempted_) {
+        // the socket buffer is full, wait for epoll out instead of getting EAGAIN
+        write_.triggered_ = false;
+      }
+      is_done = handle_write_to_net_success(thread, vio_mutex.ptr_, result, io.signalled_);
+    } else {
+      const int error = (0 == result) ? OB_SUCCESS : ob_get_sys_errno(static_cast<int>(-result));
+      is_done = handle_write_to_net_error(thread, 0, error, 0);
+    }
+
+    if (!is_done) {
+      ObIOBufferReader *reader = write_.vio_.buffer_.reader();
+      if (NULL == reader || 0 == reader->read_avail()) {
+        write_disable();
+      } else {
+        write_reschedule();
+      }
+    }
+    // if is_done, this vc may have been freed, do not touch it any more
+    MUTEX_UNTAKE_LOCK(vio_mutex.ptr_, &thread);
+  }
+}
+
 ObUnixNetVConnection::ObUnixNetVConnection()
     : closed_(0),
       active_timeout_in_(0),
       active_timeout_action_(NULL),
       inactivity_timeout_in_(0),
       next_inactivity_timeout_at_(0),
+      wheel_expire_at_(0),
+      wheel_slot_(-1),
       reenable_read_time_at_(0),
       ep_(NULL),
       nh_(NULL),
@@ -818,12 +1283,15 @@ ObUnixNetVConnection::ObUnixNetVConnection()
       recursion_(0),
       submit_time_(0),
       source_type_(VC_ACCEPT),
+      zero_copy_(NULL),
+      zero_copy_disabled_(false),
       using_ssl_(false),
       ssl_connected_(false),
       ssl_type_(SSL_NONE),
       ssl_(NULL),
       can_shutdown_ssl_(true),
       ssl_err_code_(SSL_ERROR_NONE),
+      ktls_offloaded_(false),
       io_type_(IO_NONE),
       is_inited_(false)
 {
@@ -937,14 +1405,18 @@ void ObUnixNetVConnection::reenable_re(ObVIO *vio)
           do_ssl_io(ethread);
         } else if (vio == &read_.vio_) {
           ep_->modify(EVENTIO_READ);
-          if (read_.triggered_) {
+          if (read_.in_batch_) {
+            // the batched read in flight will reschedule it when finished
+          } else if (read_.triggered_) {
             read_from_net(ethread);
           } else {
             nh_->read_ready_list_.remove(this);
           }
         } else {
           ep_->modify(EVENTIO_WRITE);
-          if (write_.triggered_) {
+          if (write_.in_batch_) {
+            // the batched write in flight will reschedule it when finished
+          } else if (write_.triggered_) {
             write_to_net(ethread);
           } else {
             nh_->write_ready_list_.remove(this);
@@ -1068,6 +1540,8 @@ void ObUnixNetVConnection::do_io_close(const int alerrno /* = -1 */)
     if (OB_FAIL(close())) {
       PROXY_NET_LOG(WDIAG, "fail to close unix net vconnection", K(this), K(ret));
     }
+  } else {
+    update_inactivity_wheel();
   }
 }
 
@@ -1336,6 +1810,16 @@ inline void ObUnixNetVConnection::free()
     op_reclaim_free(ep_);
     ep_ = NULL;
   }
+  if (NULL != zero_copy_) {
+    delete zero_copy_;
+    zero_copy_ = NULL;
+  }
+  zero_copy_disabled_ = false;
+  if (ktls_offloaded_) {
+    NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_KTLS_CONNECTIONS_CURRENTLY_OPEN, -1);
+    ktls_offloaded_ = false;
+    ssl_connected_ = false;
+  }
   is_inited_ = false;
 
   // clear variables for reuse
@@ -1440,6 +1924,7 @@ int ObUnixNetVConnection::accept_event(int event, ObEvent *e)
 
       if (EVENT_DONE != event_ret) {
         nh_->open_list_.enqueue(this);
+        nh_->set_socket_busy_poll(con_.fd_);
 
         if (inactivity_timeout_in_ > 0) {
           set_inactivity_timeout(inactivity_timeout_in_);
@@ -1498,6 +1983,9 @@ int ObUnixNetVConnection::main_event(int event, ObEvent *e)
         if (OB_FAIL(e->schedule_in(NET_RETRY_DELAY))) {
           PROXY_NET_LOG(WDIAG, "ObEvent fail to schedule_in", K(this), K(ret));
         }
+      } else if (EVENT_IMMEDIATE == event) {
+        // retry the inactivity timeout at the next tick of the wheel
+        update_inactivity_wheel();
       }
       event_ret = EVENT_CONT;
     } else if (e->cancelled_) {
@@ -1513,6 +2001,7 @@ int ObUnixNetVConnection::main_event(int event, ObEvent *e)
 
       if (EVENT_IMMEDIATE == event) {
         if (0 == inactivity_timeout_in_ || next_inactivity_timeout_at_ > get_hrtime()) {
+          update_inactivity_wheel();
           event_ret = EVENT_CONT;
         } else {
           signal_event = VC_EVENT_INACTIVITY_TIMEOUT;
@@ -1588,6 +2077,8 @@ int ObUnixNetVConnection::connect_up(ObEThread &ethread, int fd)
       SET_HANDLER(&ObUnixNetVConnection::main_event);
       nh_ = &(thread_->get_net_handler());
       nh_->open_list_.enqueue(this);
+      nh_->set_socket_busy_poll(con_.fd_);
+      update_inactivity_wheel();
       action_.continuation_->handle_event(NET_EVENT_OPEN, this);
     }
   }
@@ -1752,7 +2243,15 @@ int ObUnixNetVConnection::ssl_server_handshake(ObEThread &thread)
     PROXY_NET_LOG(WDIAG, "ssl accepte failed", K(ret), K(tmp_code));
     read_signal_done(VC_EVENT_EOS);
   } else if (ssl_connected_) {
-    reenable(&read_.vio_);
+    if (OB_FAIL(enable_ktls())) {
+      read_.triggered_ = false;
+      write_.triggered_ = false;
+      nh_->read_ready_list_.remove(this);
+      nh_->write_ready_list_.remove(this);
+      read_signal_done(VC_EVENT_EOS);
+    } else {
+      reenable(&read_.vio_);
+    }
   } else if (SSL_ERROR_WANT_READ == tmp_code || SSL_ERROR_WANT_WRITE == tmp_code) {
     read_.triggered_ = false;
     read_reschedule();
@@ -1784,7 +2283,15 @@ int ObUnixNetVConnection::ssl_client_handshake(ObEThread &thread)
     PROXY_NET_LOG(WDIAG, "ssl connect failed", K(ret), K(tmp_code));
     write_signal_done(VC_EVENT_EOS);
   } else if (ssl_connected_) {
-    reenable(&write_.vio_);
+    if (OB_FAIL(enable_ktls())) {
+      write_.triggered_ = false;
+      read_.triggered_ = false;
+      nh_->read_ready_list_.remove(this);
+      nh_->write_ready_list_.remove(this);
+      write_signal_done(VC_EVENT_EOS);
+    } else {
+      reenable(&write_.vio_);
+    }
   } else if (SSL_ERROR_WANT_READ == tmp_code || SSL_ERROR_WANT_WRITE == tmp_code) {
     read_.triggered_ = false;
     read_reschedule();
@@ -1795,6 +2302,39 @@ int ObUnixNetVConnection::ssl_client_handshake(ObEThread &thread)
   return ret;
 }
 
+// Called once the handshake is done. On success the SSL object is released and
+// the vc goes on as a plain one, records are encrypted by the kernel. The
+// enabled vios are made ready again, data which has arrived during the handoff
+// would not be reported by epoll again.
+int ObUnixNetVConnection::enable_ktls()
+{
+  int ret = OB_SUCCESS;
+  if (get_global_proxy_config().enable_ktls) {
+    if (OB_FAIL(ObNetKTLS::enable(con_.fd_, ssl_, SSL_SERVER == ssl_type_))) {
+      if (OB_NOT_SUPPORTED == ret) {
+        // keep doing records in openssl
+        ret = OB_SUCCESS;
+      } else {
+        // openssl can not send or read the records anymore
+        can_shutdown_ssl_ = false;
+        PROXY_NET_LOG(WDIAG, "fail to offload ssl connection to ktls", K(this), K(ret));
+      }
+    } else {
+      g_ssl_processor.release_ssl(ssl_, false);
+      ssl_ = NULL;
+      using_ssl_ = false;
+      ktls_offloaded_ = true;
+      NET_SUM_GLOBAL_DYN_STAT(NET_GLOBAL_KTLS_CONNECTIONS_CURRENTLY_OPEN, 1);
+      PROXY_NET_LOG(DEBUG, "ssl connection offloaded to ktls", K(this), K(con_.fd_));
+      read_.triggered_ = true;
+      write_.triggered_ = true;
+      nh_->read_ready_list_.in_or_enqueue(this);
+      nh_->write_ready_list_.in_or_enqueue(this);
+    }
+  }
+  return ret;
+}
+
 void ObUnixNetVConnection::handle_ssl_err_code(const int err_code)
 {
   ssl_err_code_ = err_code;
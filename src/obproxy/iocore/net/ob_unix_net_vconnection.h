@@ -36,6 +36,7 @@
 #include "iocore/net/ob_net_vconnection.h"
 #include "iocore/net/ob_net_state.h"
 #include "iocore/net/ob_connection.h"
+#include "iocore/net/ob_net_zero_copy.h"
 #include "lib/string/ob_string.h"
 
 namespace oceanbase
@@ -47,6 +48,11 @@ namespace net
 
 class ObNetHandler;
 struct ObEventIO;
+struct ObNetBatchIO;
+
+static const int64_t NET_MAX_IOV = 16;
+// max seconds to keep a closed socket for its unfinished zero copy sends
+static const int64_t ZERO_COPY_LINGER_TIMEOUT = 60;
 
 class ObUnixNetVConnection : public ObNetVConnection
 {
@@ -94,6 +100,9 @@ public:
   virtual void set_inactivity_timeout(const ObHRTime timeout_in);
   virtual void cancel_inactivity_timeout();
 
+  // may be called from any thread
+  virtual void set_is_force_timeout(const bool force_timeout);
+
   virtual void add_to_keep_alive_lru();
   virtual void remove_from_keep_alive_lru();
 
@@ -105,6 +114,9 @@ public:
 
   virtual int get_conn_fd() { return con_.fd_; }
 
+  virtual int detach_from_thread();
+  virtual int attach_to_thread(event::ObEThread &ethread);
+
 
 private:
   virtual bool get_data(const int32_t id, void *data); // unused !!!
@@ -131,6 +143,16 @@ public:
   void write_to_net(event::ObEThread &thread);
   void read_from_net(event::ObEThread &thread);
 
+  // batched read through io_uring, see ObNetHandler::batch_read_from_net()
+  bool prepare_read_from_net(event::ObEThread &thread, ObNetBatchIO &io);
+  void finish_read_from_net(event::ObEThread &thread, ObNetBatchIO &io, const int64_t result);
+  // batched write through io_uring, see ObNetHandler::batch_write_to_net()
+  bool prepare_write_to_net(event::ObEThread &thread, ObNetBatchIO &io);
+  void finish_write_to_net(event::ObEThread &thread, ObNetBatchIO &io, const int64_t result);
+
+  // min bytes of one send to use MSG_ZEROCOPY, INT64_MAX if zero copy can't be used
+  int64_t get_zero_copy_min_size() const;
+
 private:
   int start_event(int event, event::ObEvent *e);
 
@@ -146,6 +168,9 @@ private:
   int read_signal_error(const int lerrno);
   int write_signal_error(const int lerrno);
   void net_activity();
+  // put the vc into the timing wheel of net handler if its inactivity
+  // timeout is earlier than the time it is waiting for in the wheel
+  void update_inactivity_wheel();
 
   bool check_read_state();
   bool check_write_state();
@@ -161,6 +186,16 @@ private:
   int read_from_net_internal(event::ObMIOBuffer &iobuf, const int64_t toread, int64_t &total_read, int &tmp_code);
   int write_to_net_internal(event::ObIOBufferReader &reader, const int64_t towrite, int64_t &total_write, int &tmp_code);
 
+  // return the number of leading iovecs which can be sent by MSG_ZEROCOPY
+  int32_t prepare_zero_copy_send(const event::ObIOBufferReader &reader,
+                                 event::ObIOBufferBlock *const *blocks, const int32_t niov);
+  // hand over the socket to net handler if some zero copy sends are unfinished
+  void linger_zero_copy();
+
+public:
+  // read zero copy completions, called when the socket reports an error event
+  void reap_zero_copy();
+
 public:
   enum ObVCSourceType {
     VC_ACCEPT = 0,
@@ -186,12 +221,17 @@ public:
 
   LINK(ObUnixNetVConnection, cop_link_);
   LINK(ObUnixNetVConnection, keep_alive_link_);
+  LINK(ObUnixNetVConnection, wheel_link_);
 
   ObHRTime active_timeout_in_;
   event::ObEvent *active_timeout_action_;
 
   ObHRTime inactivity_timeout_in_;
   ObHRTime next_inactivity_timeout_at_;
+  // the inactivity timeout is checked lazily, the vc stays in the wheel at
+  // wheel_expire_at_ even if next_inactivity_timeout_at_ is extended later
+  ObHRTime wheel_expire_at_;
+  int32_t wheel_slot_;
 
   ObHRTime reenable_read_time_at_;
 
@@ -220,6 +260,11 @@ public:
   ObHRTime submit_time_;
   ObVCSourceType source_type_;
 
+  // created on the first zero copy send of this connection
+  ObNetZeroCopy *zero_copy_;
+  // SO_ZEROCOPY is not supported by this socket
+  bool zero_copy_disabled_;
+
 public:
   enum SSLType
   {
@@ -238,8 +283,12 @@ public:
 
   int ssl_init(const SSLType ssL_type, const common::ObString &cluster_name,
                const common::ObString &tenant_name, const uint64_t options = 0);
+  // using_ssl() means openssl does the io, it is false once the records are
+  // offloaded to the kernel, while the connection is still an ssl one
   inline bool using_ssl() const { return using_ssl_; }
+  inline bool is_ssl_connection() const { return using_ssl_ || ktls_offloaded_; }
   inline bool ssl_connected() const { return ssl_connected_; }
+  inline bool ktls_offloaded() const { return ktls_offloaded_; }
   inline bool get_ssl_err_code() const { return ssl_err_code_; }
   void do_ssl_io(event::ObEThread &thread);
   void close_ssl();
@@ -249,6 +298,7 @@ private:
   int ssl_server_handshake(event::ObEThread &thread);
   int ssl_client_handshake(event::ObEThread &thread);
   void handle_ssl_err_code(const int err_code);
+  int enable_ktls();
   void handle_ssl_want_read();
   void handle_ssl_want_write();
 private:
@@ -258,6 +308,7 @@ private:
   SSL *ssl_;
   bool can_shutdown_ssl_;
   int ssl_err_code_;
+  bool ktls_offloaded_;
   IOType io_type_;
 
 private:
@@ -294,6 +345,7 @@ inline void ObUnixNetVConnection::set_inactivity_timeout(const ObHRTime timeout)
   PROXY_NET_LOG(DEBUG, "set inactive timeout", K(timeout), K(this));
   inactivity_timeout_in_ = timeout;
   next_inactivity_timeout_at_ = event::get_hrtime() + timeout;
+  update_inactivity_wheel();
 }
 
 inline void ObUnixNetVConnection::cancel_inactivity_timeout()
@@ -18,6 +18,7 @@
 #include "iocore/eventsystem/ob_buf_allocator.h"
 #include "iocore/eventsystem/ob_event_system.h"
 #include "lib/lock/ob_drw_lock.h"
+#include "lib/allocator/ob_retire_station.h"
 
 namespace oceanbase
 {
@@ -31,6 +32,91 @@ static const int64_t MT_HASHTABLE_PARTITIONS        = 1 << MT_HASHTABLE_PARTITIO
 static const uint64_t MT_HASHTABLE_PARTITION_MASK   = MT_HASHTABLE_PARTITIONS - 1;
 static const int64_t MT_HASHTABLE_MAX_CHAIN_AVG_LEN = 4;
 
+// the memory which lock free readers may still see is retired here, and freed
+// after all the readers which entered before the retirement have left
+class ObMTHashTableReclaimer
+{
+public:
+  typedef void (*FreeFunc)(void *ptr, const int64_t size);
+  static const int64_t RETIRE_LIMIT = 64;
+
+  struct ObRetireNode
+  {
+    common::ObLink retire_link_;
+    void *ptr_;
+    int64_t size_;
+    FreeFunc free_func_;
+  };
+
+  class ReadGuard
+  {
+  public:
+    ReadGuard() { get_qclock().enter_critical(); }
+    ~ReadGuard() { get_qclock().leave_critical(); }
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ReadGuard);
+  };
+
+  static common::QClock &get_qclock()
+  {
+    static common::QClock qclock;
+    return qclock;
+  }
+
+  static common::RetireStation &get_retire_station()
+  {
+    static common::RetireStation retire_station(get_qclock());
+    return retire_station;
+  }
+
+  static void free_fixed_mem(void *ptr, const int64_t size)
+  {
+    op_fixed_mem_free(ptr, size);
+  }
+
+  // never call it inside ReadGuard, or it may wait for itself
+  static void retire(void *ptr, const int64_t size, FreeFunc free_func)
+  {
+    ObRetireNode *node = NULL;
+    if (NULL == ptr || NULL == free_func) {
+      // do nothing
+    } else if (OB_ISNULL(node = op_alloc(ObRetireNode))) {
+      // no memory to delay it, wait all the current readers to leave
+      PROXY_LOG(WDIAG, "fail to alloc retire node, wait quiescent", KP(ptr), K(size));
+      get_qclock().wait_quiescent(get_qclock().get_clock());
+      free_func(ptr, size);
+    } else {
+      node->ptr_ = ptr;
+      node->size_ = size;
+      node->free_func_ = free_func;
+      common::HazardList retire_list;
+      common::HazardList reclaim_list;
+      retire_list.push(&node->retire_link_);
+      get_retire_station().retire(reclaim_list, retire_list, RETIRE_LIMIT);
+      reclaim(reclaim_list);
+    }
+  }
+
+  static void purge()
+  {
+    common::HazardList reclaim_list;
+    get_retire_station().purge(reclaim_list);
+    reclaim(reclaim_list);
+  }
+
+private:
+  static void reclaim(common::HazardList &reclaim_list)
+  {
+    common::ObLink *link = NULL;
+    ObRetireNode *node = NULL;
+    while (NULL != (link = reclaim_list.pop())) {
+      node = CONTAINER_OF(link, ObRetireNode, retire_link_);
+      node->free_func_(node->ptr_, node->size_);
+      op_free(node);
+    }
+  }
+};
+
 template <class Key, class Value>
 struct ObHashTableEntry
 {
@@ -73,10 +159,12 @@ public:
   typedef ObHashTableEntry<Key, Value> HashTableEntry;
 
   ObIMTHashTable(bool (*a_gc_func)(Value) = NULL,
-                 void (*a_pre_gc_func)(void) = NULL)
+                 void (*a_pre_gc_func)(void) = NULL,
+                 const bool lock_free_read = false)
   {
     gc_func = a_gc_func;
     pre_gc_func = a_pre_gc_func;
+    lock_free_read_ = lock_free_read;
     buckets_ = NULL;
     cur_size_ = 0;
     bucket_num_ = 0;
@@ -144,6 +232,7 @@ public:
   Value insert_entry(const uint64_t hash, const Key &key, Value data);
   Value remove_entry(const uint64_t hash, const Key &key);
   Value lookup_entry(const uint64_t hash, const Key &key);
+  Value lock_free_lookup_entry(const uint64_t hash, const Key &key);
 
   Value first_entry(const int64_t bucket_id, IteratorState &s);
   static Value next_entry(IteratorState &s);
@@ -168,12 +257,12 @@ public:
           next = cur->next_;
           if (gc_func(cur->data_)) {
             if (NULL != prev) {
-              prev->next_ = next;
+              ATOMIC_STORE(&prev->next_, next);
             } else {
-              buckets_[i] = next;
+              ATOMIC_STORE(&buckets_[i], next);
             }
 
-            HashTableEntry::free(cur);
+            free_entry(cur);
             --cur_size_;
           } else {
             prev = cur;
@@ -206,26 +295,56 @@ public:
         while (NULL != cur) {
           next = cur->next_;
           new_id = bucket_id(cur->hash_, new_bucket_num);
-          cur->next_ = new_buckets[new_id];
+          ATOMIC_STORE(&cur->next_, new_buckets[new_id]);
           new_buckets[new_id] = cur;
           cur = next;
         }
 
-        buckets_[i] = NULL;
+        if (!lock_free_read_) {
+          buckets_[i] = NULL;
+        }
       }
 
-      op_fixed_mem_free(buckets_, bucket_num_ * sizeof(HashTableEntry *));
-      buckets_ = new_buckets;
-      bucket_num_ = new_bucket_num;
+      HashTableEntry **old_buckets = buckets_;
+      const int64_t old_bucket_num = bucket_num_;
+      // lock free readers load bucket_num_ before buckets_, and the bucket num only
+      // grows, so they never index out of the buckets they see
+      ATOMIC_STORE(&buckets_, new_buckets);
+      ATOMIC_STORE(&bucket_num_, new_bucket_num);
+      if (lock_free_read_) {
+        ObMTHashTableReclaimer::retire(old_buckets, old_bucket_num * sizeof(HashTableEntry *),
+                                       ObMTHashTableReclaimer::free_fixed_mem);
+      } else {
+        op_fixed_mem_free(old_buckets, old_bucket_num * sizeof(HashTableEntry *));
+      }
     }
     return ret;
   }
 
+  bool is_lock_free_read() const { return lock_free_read_; }
+
 private:
   ObIMTHashTable();
 
+  static void free_retired_entry(void *ptr, const int64_t size)
+  {
+    UNUSED(size);
+    HashTableEntry::free(static_cast<HashTableEntry *>(ptr));
+  }
+
+  // the removed entry may be still traversed by lock free readers
+  void free_entry(HashTableEntry *entry)
+  {
+    if (lock_free_read_) {
+      ObMTHashTableReclaimer::retire(entry, sizeof(HashTableEntry), free_retired_entry);
+    } else {
+      HashTableEntry::free(entry);
+    }
+  }
+
   bool (*gc_func)(Value);
   void (*pre_gc_func)(void);
+  bool lock_free_read_;
 
 private:
   HashTableEntry **buckets_;
@@ -240,14 +359,33 @@ inline Value ObIMTHashTable<Key, Value>::insert_entry(const uint64_t hash, const
   Value ret = static_cast<Value>(0);
   int64_t id = bucket_id(hash);
   HashTableEntry *cur = buckets_[id];
+  HashTableEntry *prev = NULL;
 
   while (NULL != cur && (hash != cur->hash_ || cur->key_ != key)) {
+    prev = cur;
     cur = cur->next_;
   }
 
   if (NULL != cur) {
     if (data == cur->data_) {
       // return NULL;
+    } else if (lock_free_read_) {
+      // copy on write, lock free readers see either the old entry or the new one
+      HashTableEntry *new_entry = HashTableEntry::alloc();
+      if (OB_LIKELY(NULL != new_entry)) {
+        ret = cur->data_;
+        new_entry->hash_ = hash;
+        new_entry->key_ = key;
+        new_entry->data_ = data;
+        new_entry->next_ = cur->next_;
+        if (NULL != prev) {
+          ATOMIC_STORE(&prev->next_, new_entry);
+        } else {
+          ATOMIC_STORE(&buckets_[id], new_entry);
+        }
+        free_entry(cur);
+        cur = NULL;
+      }
     } else {
       ret = cur->data_;
       cur->data_ = data;
@@ -261,7 +399,7 @@ inline Value ObIMTHashTable<Key, Value>::insert_entry(const uint64_t hash, const
       new_entry->key_ = key;
       new_entry->data_ = data;
       new_entry->next_ = buckets_[id];
-      buckets_[id] = new_entry;
+      ATOMIC_STORE(&buckets_[id], new_entry);
       ++cur_size_;
       if (cur_size_ / bucket_num_ > MT_HASHTABLE_MAX_CHAIN_AVG_LEN) {
         gc();
@@ -292,13 +430,13 @@ inline Value ObIMTHashTable<Key, Value>::remove_entry(const uint64_t hash, const
 
   if (NULL != cur) {
     if (NULL != prev) {
-      prev->next_ = cur->next_;
+      ATOMIC_STORE(&prev->next_, cur->next_);
     } else {
-      buckets_[id] = cur->next_;
+      ATOMIC_STORE(&buckets_[id], cur->next_);
     }
 
     ret = cur->data_;
-    HashTableEntry::free(cur);
+    free_entry(cur);
     cur = NULL;
     --cur_size_;
   }
@@ -324,6 +462,31 @@ inline Value ObIMTHashTable<Key, Value>::lookup_entry(const uint64_t hash, const
   return ret;
 }
 
+// without partition lock, must be called inside ObMTHashTableReclaimer::ReadGuard,
+// and the returned value is only valid before leaving the guard. it may miss the
+// entry which is being resized, the caller should look it up again with lock
+template <class Key, class Value>
+inline Value ObIMTHashTable<Key, Value>::lock_free_lookup_entry(const uint64_t hash, const Key &key)
+{
+  Value ret = static_cast<Value>(0);
+  const int64_t bucket_num = ATOMIC_LOAD(&bucket_num_);
+  HashTableEntry **buckets = ATOMIC_LOAD(&buckets_);
+  HashTableEntry *cur = NULL;
+
+  if (OB_LIKELY(NULL != buckets && bucket_num > 0)) {
+    cur = ATOMIC_LOAD(&buckets[bucket_id(hash, bucket_num)]);
+    while (NULL != cur && (hash != cur->hash_ || cur->key_ != key)) {
+      cur = ATOMIC_LOAD(&cur->next_);
+    }
+  }
+
+  if (NULL != cur) {
+    ret = cur->data_;
+  }
+
+  return ret;
+}
+
 template <class Key, class Value>
 inline Value ObIMTHashTable<Key, Value>::first_entry(const int64_t bucket_id, IteratorState &s)
 {
@@ -368,8 +531,8 @@ inline Value ObIMTHashTable<Key, Value>::remove_entry(IteratorState &s)
   HashTableEntry *entry = *(s.ppcur_);
   if (NULL != entry) {
     ret = entry->data_;
-    *(s.ppcur_) = entry->next_;
-    HashTableEntry::free(entry);
+    ATOMIC_STORE(s.ppcur_, entry->next_);
+    free_entry(entry);
     entry = NULL;
     --cur_size_;
   }
@@ -406,8 +569,11 @@ public:
     }
   }
 
+  // lock_free_read: removed entries and old buckets are retired, so that the
+  // readers can use lock_free_lookup_entry() without partition lock
   int init(const int64_t size, const event::ObLockStats lock_stats = event::COMMON_LOCK,
-           bool (*gc_func)(Value) = NULL, void (*pre_gc_func)(void) = NULL)
+           bool (*gc_func)(Value) = NULL, void (*pre_gc_func)(void) = NULL,
+           const bool lock_free_read = false)
   {
     int ret = common::OB_SUCCESS;
     if (OB_UNLIKELY(is_inited_)) {
@@ -418,7 +584,7 @@ public:
         if (OB_ISNULL(locks_[i] = event::new_proxy_mutex(lock_stats))) {
           ret = common::OB_ALLOCATE_MEMORY_FAILED;
           PROXY_LOG(EDIAG, "fail to alloc mem for proxymutex", K(ret));
-        } else if (OB_ISNULL(hash_tables_[i] = op_alloc_args(IMTHashTable, gc_func, pre_gc_func))) {
+        } else if (OB_ISNULL(hash_tables_[i] = op_alloc_args(IMTHashTable, gc_func, pre_gc_func, lock_free_read))) {
           ret = common::OB_ALLOCATE_MEMORY_FAILED;
           PROXY_LOG(EDIAG, "fail to alloc mem for hash table", K(ret));
         } else if (OB_FAIL(hash_tables_[i]->init(size))) {
@@ -493,6 +659,11 @@ public:
     return hash_tables_[part_num(hash)]->lookup_entry(hash, key);
   }
 
+  Value lock_free_lookup_entry(const uint64_t hash, const Key &key)
+  {
+    return hash_tables_[part_num(hash)]->lock_free_lookup_entry(hash, key);
+  }
+
   Value first_entry(const int64_t part_id, IteratorState &s)
   {
     Value ret = static_cast<Value>(0);
@@ -23,6 +23,7 @@
 #include "obutils/ob_proxy_create_server_conn_cont.h"
 #include "proxy/mysql/ob_mysql_global_session_manager.h"
 #include "obutils/ob_session_pool_processor.h"
+#include "stat/ob_mysql_stats.h"
 
 
 
@@ -121,11 +122,13 @@ int ObProxyConnNumCheckCont::handle_one_schema_key_num_check()
   if (OB_ISNULL(schema_server_addr_info)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WDIAG("should not null here", K(schema_key_.dbkey_));
-  } else if (schema_key_.logic_tenant_name_.config_string_.empty() ||
-    schema_key_.logic_tenant_name_.config_string_.compare(DEFAULT_LOGIC_TENANT_NAME) == 0) {
+  } else if (!get_global_proxy_config().enable_server_conn_prewarm
+             && (schema_key_.logic_tenant_name_.config_string_.empty() ||
+                 schema_key_.logic_tenant_name_.config_string_.compare(DEFAULT_LOGIC_TENANT_NAME) == 0)) {
     LOG_DEBUG("not logic tenant", K(schema_key_));
   } else {
     // check conn num ,if less than min will create conn
+    const bool enable_prewarm = get_global_proxy_config().enable_server_conn_prewarm;
     int64_t min_count = ObMysqlSessionUtils::get_session_min_conn(schema_key_);
     int64_t max_count = ObMysqlSessionUtils::get_session_max_conn(schema_key_);
     ObMysqlSchemaServerAddrInfo::ServerAddrHashTable::iterator last =
@@ -146,7 +149,13 @@ int ObProxyConnNumCheckCont::handle_one_schema_key_num_check()
       int64_t cur_count = get_global_session_manager().get_current_session_conn_count(
                           schema_key_.dbkey_.config_string_,
                           common_addr);
-      if (cur_count < min_count) {
+      // with prewarm, keep the spare conns beyond the ones in use as well
+      int64_t target_count = min_count;
+      if (enable_prewarm) {
+        target_count = get_global_session_manager().get_prewarm_target_count(
+                         schema_key_.dbkey_.config_string_, common_addr);
+      }
+      if (cur_count < target_count) {
         // less than min shoud create conn, only shard need create
         if (TYPE_SHARD_CONNECTOR == schema_key_.get_connector_type()) {
           SchemaKeyConnInfo* schema_key_info = op_alloc(SchemaKeyConnInfo);
@@ -156,11 +165,12 @@ int ObProxyConnNumCheckCont::handle_one_schema_key_num_check()
           }
           schema_key_info->schema_key_ = schema_key_;
           schema_key_info->addr_ = addr_info->addr_;
-          schema_key_info->conn_count_ = min_count - cur_count;
+          schema_key_info->conn_count_ = target_count - cur_count;
+          schema_key_info->target_count_ = target_count;
           get_global_server_conn_job_list().push(schema_key_info);
           int32_t count = get_global_server_conn_job_list().count();
           LOG_DEBUG("add a server conn job", K(schema_key_), K(schema_key_info), KPC(schema_key_info),
-            K(cur_count), K(min_count), K(common_addr), K(count));
+            K(cur_count), K(min_count), K(target_count), K(common_addr), K(count));
         } else {
           LOG_DEBUG("not shard, do nothing", K(schema_key_));
         }
@@ -185,6 +195,10 @@ int ObProxyConnNumCheckCont::handle_conn_num_check()
   ObHRTime start_time_us = hrtime_to_usec(get_hrtime_internal());
   ObSEArray<ObMysqlServerSessionListPool*, 1024> all_session_list_pool_array;
   get_global_session_manager().get_all_session_list_pool(all_session_list_pool_array);
+  if (OB_FAIL(handle_leader_switch(all_session_list_pool_array))) {
+    LOG_WDIAG("fail to handle leader switch", K(ret));
+    ret = OB_SUCCESS;
+  }
   for (int64_t i = 0; i < all_session_list_pool_array.count(); i++) {
     ObMysqlServerSessionListPool* session_list_pool = all_session_list_pool_array.at(i);
     schema_key_ = session_list_pool->schema_key_;
@@ -202,6 +216,88 @@ int ObProxyConnNumCheckCont::handle_conn_num_check()
   return ret;
 }
 
+int ObProxyConnNumCheckCont::handle_leader_switch(
+    ObIArray<ObMysqlServerSessionListPool*> &all_session_list_pool)
+{
+  int ret = OB_SUCCESS;
+  // many partitions usually move together, handle each pair of leaders once
+  ObSEArray<ObLeaderSwitchInfo*, 16> leader_switch_infos;
+  ObLeaderSwitchInfo* leader_switch_info = NULL;
+  while (NULL != (leader_switch_info = get_global_leader_switch_job_list().pop())) {
+    bool is_handled = false;
+    for (int64_t i = 0; !is_handled && i < leader_switch_infos.count(); i++) {
+      is_handled = (leader_switch_infos.at(i)->old_leader_ == leader_switch_info->old_leader_
+                    && leader_switch_infos.at(i)->new_leader_ == leader_switch_info->new_leader_);
+    }
+    if (is_handled || OB_SUCCESS != leader_switch_infos.push_back(leader_switch_info)) {
+      op_free(leader_switch_info);
+      leader_switch_info = NULL;
+    } else if (OB_FAIL(handle_one_leader_switch(*leader_switch_info, all_session_list_pool))) {
+      LOG_WDIAG("fail to handle one leader switch", KPC(leader_switch_info), K(ret));
+      ret = OB_SUCCESS;
+    }
+  }
+  for (int64_t i = 0; i < leader_switch_infos.count(); i++) {
+    op_free(leader_switch_infos.at(i));
+  }
+  return ret;
+}
+
+int ObProxyConnNumCheckCont::handle_one_leader_switch(
+    const ObLeaderSwitchInfo &leader_switch_info,
+    ObIArray<ObMysqlServerSessionListPool*> &all_session_list_pool)
+{
+  int ret = OB_SUCCESS;
+  ObCommonAddr old_addr;
+  ObCommonAddr new_addr;
+  if (OB_FAIL(old_addr.assign(net::ops_ip_sa_cast(leader_switch_info.old_leader_.get_sockaddr())))) {
+    LOG_WDIAG("fail to assign old leader addr", K(leader_switch_info), K(ret));
+  } else if (OB_FAIL(new_addr.assign(net::ops_ip_sa_cast(leader_switch_info.new_leader_.get_sockaddr())))) {
+    LOG_WDIAG("fail to assign new leader addr", K(leader_switch_info), K(ret));
+  }
+  // the pools which have sessions on the old leader serve the tenant of the
+  // partition, their traffic is going to move to the new leader
+  for (int64_t i = 0; OB_SUCC(ret) && i < all_session_list_pool.count(); i++) {
+    ObMysqlServerSessionListPool* session_list_pool = all_session_list_pool.at(i);
+    const ObProxySchemaKey& schema_key = session_list_pool->schema_key_;
+    ObMysqlServerSessionList* old_ss_list = NULL;
+    if (TYPE_SHARD_CONNECTOR != schema_key.get_connector_type()
+        || (DB_OB_MYSQL != schema_key.get_db_server_type()
+            && DB_OB_ORACLE != schema_key.get_db_server_type())) {
+      // only shard connector has the password to create conn
+    } else if (OB_SUCCESS != session_list_pool->accquire_server_seession_list(old_addr, old_ss_list)) {
+      // no session on the old leader
+    } else {
+      int64_t target_count = old_ss_list->calc_prewarm_target_count(
+                               ObMysqlSessionUtils::get_session_min_conn(schema_key),
+                               ObMysqlSessionUtils::get_session_max_conn(schema_key),
+                               get_global_proxy_config().server_conn_prewarm_max_spare);
+      old_ss_list->dec_ref();
+      old_ss_list = NULL;
+      int64_t cur_count = session_list_pool->get_current_session_conn_count(new_addr);
+      SchemaKeyConnInfo* schema_key_info = NULL;
+      if (cur_count >= target_count) {
+        LOG_DEBUG("new leader is warm already", K(schema_key.dbkey_), K(new_addr), K(cur_count), K(target_count));
+      } else if (OB_ISNULL(schema_key_info = op_alloc(SchemaKeyConnInfo))) {
+        LOG_WDIAG("alloc SchemaKeyConnInfo failed", K(schema_key.dbkey_));
+      } else {
+        // keep checking the new leader with the other addrs of this pool
+        session_list_pool->add_server_addr_if_not_exist(new_addr);
+        schema_key_info->schema_key_ = schema_key;
+        schema_key_info->addr_ = new_addr;
+        schema_key_info->conn_count_ = target_count - cur_count;
+        schema_key_info->target_count_ = target_count;
+        schema_key_info->is_leader_switch_ = true;
+        get_global_server_conn_job_list().push(schema_key_info);
+        MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_LEADER_SWITCH_PREWARMS);
+        LOG_DEBUG("add a server conn job for new leader", K(schema_key.dbkey_), KPC(schema_key_info),
+                  K(leader_switch_info), K(cur_count), K(target_count));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObProxyConnNumCheckCont::schedule_check_conn_num_cont(bool imm)
 {
   int ret = OB_SUCCESS;
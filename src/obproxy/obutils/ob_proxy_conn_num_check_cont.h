@@ -16,6 +16,7 @@
 #include "obutils/ob_async_common_task.h"
 #include "lib/string/ob_string.h"
 #include "lib/lock/tbrwlock.h"
+#include "lib/container/ob_iarray.h"
 #include "proxy/mysql/ob_mysql_global_session_utils.h"
 
 #define CONN_NUM_CHECK_ENTRY_START_EVENT (CONN_NUM_CHECK_EVENT_EVENTS_START + 1)
@@ -25,6 +26,11 @@ namespace oceanbase
 {
 namespace obproxy
 {
+namespace proxy
+{
+class ObMysqlServerSessionListPool;
+class ObLeaderSwitchInfo;
+}
 namespace obutils
 {
 class ObClusterResource;
@@ -40,6 +46,12 @@ public:
   int stop_check_conn_num();
   int handle_conn_num_check();
   int handle_one_schema_key_num_check();
+  // prewarm the new leaders pushed by the partition cache
+  int handle_leader_switch(
+      common::ObIArray<obproxy::proxy::ObMysqlServerSessionListPool*> &all_session_list_pool);
+  int handle_one_leader_switch(
+      const obproxy::proxy::ObLeaderSwitchInfo &leader_switch_info,
+      common::ObIArray<obproxy::proxy::ObMysqlServerSessionListPool*> &all_session_list_pool);
   int handle_detroy_self();
   const char *get_event_name(const int64_t event);
 
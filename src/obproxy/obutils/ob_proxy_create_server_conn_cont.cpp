@@ -21,6 +21,7 @@
 #include "proxy/mysql/ob_mysql_global_session_manager.h"
 #include "proxy/mysql/ob_mysql_transact.h"
 #include "obutils/ob_session_pool_processor.h"
+#include "stat/ob_mysql_stats.h"
 
 
 using namespace oceanbase::obproxy::event;
@@ -106,13 +107,14 @@ int ObProxyCreateServerConnCont::handle_get_one_conn_info()
       int32_t list_count = get_global_server_conn_job_list().count();
       ObCommonAddr& addr = schema_key_conn_info_->addr_;
       ObProxySchemaKey& schema_key = schema_key_conn_info_->schema_key_;
-      int64_t min_count = ObMysqlSessionUtils::get_session_min_conn(schema_key);
+      int64_t min_count = std::max(ObMysqlSessionUtils::get_session_min_conn(schema_key),
+                                   schema_key_conn_info_->target_count_);
       int64_t cur_count = get_global_session_manager().get_current_session_conn_count(
                             schema_key.dbkey_.config_string_,
                             addr);
       create_count_ = 0;
       if (cur_count >= min_count) {
-        // reach min no need create
+        // reach min or prewarm target no need create
         continue;
       }
       conn_count_ = min_count - cur_count;
@@ -193,6 +195,10 @@ int ObProxyCreateServerConnCont::main_handler(int event, void *data)
       get_global_session_manager().incr_fail_count(schema_key.dbkey_.config_string_,
           schema_key_conn_info_->addr_);
     } else {
+      if (schema_key_conn_info_->is_leader_switch_) {
+        // the min conn precreation is not counted
+        MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_PREWARMED_CONNS);
+      }
       get_global_session_manager().reset_fail_count(schema_key.dbkey_.config_string_, schema_key_conn_info_->addr_);
       if (create_count_ < conn_count_) {
         if (OB_ISNULL(pending_action_ = self_ethread().schedule_imm(this, CONN_ENTRY_CREATE_SERVER_SESSION_EVENT, NULL))) {
@@ -68,14 +68,15 @@ void ObConnTableProcessor::destroy()
 }
 
 bool ObConnTableProcessor::check_and_inc_conn(
-    ObString& cluster_name, ObString& tenant_name, ObString& ip_name)
+    ObString& cluster_name, ObString& tenant_name, ObString& ip_name, const bool is_waiter)
 {
   int ret = OB_SUCCESS;
   bool throttle = false;
   ObVipTenantConn* vt_conn = NULL;
   int64_t cur_used_connections = 0;
+  int64_t cur_waiting_connections = 0;
 
-  if (OB_FAIL(inc_conn(cluster_name, tenant_name, ip_name, cur_used_connections))) {
+  if (OB_FAIL(inc_conn(cluster_name, tenant_name, ip_name, cur_used_connections, cur_waiting_connections))) {
     throttle = true;
     LOG_WDIAG("fail to get or create used conn", K(cluster_name), K(tenant_name), K(ip_name), K(ret));
   }
@@ -92,10 +93,17 @@ bool ObConnTableProcessor::check_and_inc_conn(
         throttle = true;
       }
     } else {
-      if (cur_used_connections <= vt_conn->max_connections_) {
-        LOG_DEBUG("vip tenant connect info", K(cur_used_connections), KPC(vt_conn));
+      if (cur_used_connections <= vt_conn->max_connections_
+          && (is_waiter || 0 == cur_waiting_connections)) {
+        LOG_DEBUG("vip tenant connect info", K(cur_used_connections), K(cur_waiting_connections), KPC(vt_conn));
       } else {
-        LOG_WDIAG("used connections reach throttle", K(cur_used_connections), K(vt_conn->max_connections_), KPC(vt_conn));
+        if (is_waiter) {
+          LOG_DEBUG("used connections reach throttle, continue waiting", K(cur_used_connections),
+                    K(cur_waiting_connections), KPC(vt_conn));
+        } else {
+          LOG_WDIAG("used connections reach throttle", K(cur_used_connections), K(cur_waiting_connections),
+                    K(vt_conn->max_connections_), KPC(vt_conn));
+        }
         dec_conn(cluster_name, tenant_name, ip_name);
         throttle = true;
       }
@@ -106,7 +114,7 @@ bool ObConnTableProcessor::check_and_inc_conn(
 }
 
 int ObConnTableProcessor::inc_conn(ObString& cluster_name, ObString& tenant_name, ObString& ip_name,
-    int64_t& cur_used_connections)
+    int64_t& cur_used_connections, int64_t& cur_waiting_connections)
 {
   int ret = OB_SUCCESS;
   ObString key_name;
@@ -119,6 +127,7 @@ int ObConnTableProcessor::inc_conn(ObString& cluster_name, ObString& tenant_name
     if (OB_FAIL(get_or_create_used_conn(key_name, used_conn, cur_used_connections))) {
       LOG_WDIAG("create used conn failed", K(key_name), K(ret));
     } else {
+      cur_waiting_connections = ATOMIC_LOAD(&used_conn->waiting_connections_);
       used_conn->dec_ref();
     }
   }
@@ -145,7 +154,8 @@ void ObConnTableProcessor::dec_conn(
           LOG_DEBUG("dec conn", KPC(used_conn));
         } else {
           DRWLock::WRLockGuard guard(used_conn_rwlock_);
-          if (0 == used_conn->max_used_connections_ && used_conn->is_in_map_) {
+          if (0 == used_conn->max_used_connections_ && 0 == used_conn->waiting_connections_
+              && used_conn->is_in_map_) {
             erase_used_conn(key_name, used_conn);
             LOG_DEBUG("erase used conn", K(key_name));
           }
@@ -156,6 +166,59 @@ void ObConnTableProcessor::dec_conn(
   }
 }
 
+int ObConnTableProcessor::inc_waiting_conn(ObString& cluster_name, ObString& tenant_name, ObString& ip_name,
+    const int64_t max_waiting_connections, int64_t& cur_waiting_connections)
+{
+  int ret = OB_SUCCESS;
+  ObUsedConn* used_conn = NULL;
+  common::ObFixedLengthString<OB_PROXY_MAX_TENANT_CLUSTER_NAME_LENGTH + common::MAX_IP_ADDR_LENGTH> key_string;
+  if (OB_FAIL(build_tenant_cluster_vip_name(tenant_name, cluster_name, ip_name, key_string))) {
+    LOG_WDIAG("build tenant cluster vip name failed", K(tenant_name), K(cluster_name), K(ip_name), K(ret));
+  } else {
+    ObString key_name = ObString::make_string(key_string.ptr());
+    if (OB_FAIL(create_used_conn(key_name, used_conn, cur_waiting_connections, true))) {
+      LOG_WDIAG("fail to get or create used conn", K(key_name), K(ret));
+    } else {
+      if (cur_waiting_connections > max_waiting_connections) {
+        ret = OB_SIZE_OVERFLOW;
+        LOG_WDIAG("waiting connections reach limit", K(cur_waiting_connections),
+                  K(max_waiting_connections), KPC(used_conn), K(ret));
+      }
+      used_conn->dec_ref();
+      used_conn = NULL;
+      if (OB_FAIL(ret)) {
+        dec_waiting_conn(cluster_name, tenant_name, ip_name);
+      }
+    }
+  }
+  return ret;
+}
+
+void ObConnTableProcessor::dec_waiting_conn(
+    ObString& cluster_name, ObString& tenant_name, ObString& ip_name)
+{
+  int ret = OB_SUCCESS;
+  ObUsedConn* used_conn = NULL;
+  common::ObFixedLengthString<OB_PROXY_MAX_TENANT_CLUSTER_NAME_LENGTH + common::MAX_IP_ADDR_LENGTH> key_string;
+
+  if (OB_FAIL(build_tenant_cluster_vip_name(tenant_name, cluster_name, ip_name, key_string))) {
+    LOG_WDIAG("build tenant cluster vip name failed", K(ret), K(tenant_name), K(cluster_name), K(ip_name));
+  } else {
+    ObString key_name = ObString::make_string(key_string.ptr());
+    DRWLock::WRLockGuard guard(used_conn_rwlock_);
+    if (OB_FAIL(used_conn_cache_.get(key_name, used_conn))) {
+      LOG_WDIAG("fail to get used conn in map", K(key_name), K(ret));
+    } else if (OB_NOT_NULL(used_conn)) {
+      (void)ATOMIC_FAA(&used_conn->waiting_connections_, -1);
+      if (0 == used_conn->max_used_connections_ && 0 == used_conn->waiting_connections_
+          && used_conn->is_in_map_) {
+        erase_used_conn(key_name, used_conn);
+        LOG_DEBUG("erase used conn", K(key_name));
+      }
+    }
+  }
+}
+
 int ObConnTableProcessor::get_vt_conn_object(
     ObString& cluster_name, ObString& tenant_name, ObString& vip_name, ObVipTenantConn*& vt_conn)
 {
@@ -363,7 +426,7 @@ int ObConnTableProcessor::conn_rollback()
 }
 
 int ObConnTableProcessor::create_used_conn(ObString& key_name,
-    ObUsedConn*& used_conn, int64_t& cur_used_connections)
+    ObUsedConn*& used_conn, int64_t& cur_used_connections, const bool is_waiting_conn)
 {
   int ret = OB_SUCCESS;
   DRWLock::WRLockGuard guard(used_conn_rwlock_);
@@ -387,7 +450,8 @@ int ObConnTableProcessor::create_used_conn(ObString& key_name,
 
       if (OB_SUCC(ret)) {
         used_conn->inc_ref();
-        cur_used_connections  = ATOMIC_AAF(&used_conn->max_used_connections_, 1);
+        cur_used_connections  = ATOMIC_AAF(is_waiting_conn ? &used_conn->waiting_connections_
+                                                           : &used_conn->max_used_connections_, 1);
       } else if (OB_NOT_NULL(used_conn)) {
         used_conn->dec_ref();
         used_conn = NULL;
@@ -396,7 +460,8 @@ int ObConnTableProcessor::create_used_conn(ObString& key_name,
   } else {
     used_conn = tmp_used_conn;
     used_conn->inc_ref();
-    cur_used_connections  = ATOMIC_AAF(&used_conn->max_used_connections_, 1);
+    cur_used_connections  = ATOMIC_AAF(is_waiting_conn ? &used_conn->waiting_connections_
+                                                       : &used_conn->max_used_connections_, 1);
   }
 
   return ret;
@@ -51,11 +51,21 @@ public:
   void destroy();
   int commit(bool is_success);
 
+  // is_waiter means the login is already waiting for a free connection. others are throttled
+  // when there are waiters, so that they can not overtake them. the waiters poll and are not
+  // ordered among themselves
   bool check_and_inc_conn(common::ObString& cluster_name,
-      common::ObString& tenant_name, common::ObString& ip_name);
+      common::ObString& tenant_name, common::ObString& ip_name, const bool is_waiter = false);
 
   int inc_conn(common::ObString& cluster_name, common::ObString& tenant_name, common::ObString& ip_name,
-      int64_t& cur_used_connections);
+      int64_t& cur_used_connections, int64_t& cur_waiting_connections);
+
+  // return OB_SIZE_OVERFLOW if there are max_waiting_connections waiters already
+  int inc_waiting_conn(common::ObString& cluster_name, common::ObString& tenant_name,
+      common::ObString& ip_name, const int64_t max_waiting_connections, int64_t& cur_waiting_connections);
+
+  void dec_waiting_conn(common::ObString& cluster_name,
+      common::ObString& tenant_name, common::ObString& ip_name);
 
   void dec_conn(common::ObString& cluster_name,
       common::ObString& tenant_name, common::ObString& ip_name);
@@ -82,7 +92,9 @@ public:
   ObVipTenantConnCache::VTHashMap* get_conn_map() { return vt_conn_cache_.get_conn_map(); }
   ObVipTenantConnCache::VTHashMap& get_conn_map_replica() { return vt_conn_cache_.get_conn_map_replica(); }
 
-  int create_used_conn(common::ObString& key_name, ObUsedConn*& used_conn, int64_t& cur_used_connections);
+  // if is_waiting_conn is true, inc the waiting connections instead of the used ones
+  int create_used_conn(common::ObString& key_name, ObUsedConn*& used_conn, int64_t& cur_used_connections,
+      const bool is_waiting_conn = false);
   int get_used_conn(common::ObString& key_name, bool is_need_inc_used_connections, ObUsedConn*& used_conn, int64_t& cur_used_connections);
   int erase_used_conn(common::ObString& key_name, ObUsedConn* used_conn);
   int get_or_create_used_conn(common::ObString& key_name, ObUsedConn*& used_conn, int64_t& cur_used_connections);
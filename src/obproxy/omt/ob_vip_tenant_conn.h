@@ -131,7 +131,7 @@ private:
 
 class ObUsedConn : public common::ObSharedRefCount {
 public:
-  ObUsedConn(common::ObString& full_name) : max_used_connections_(0), is_in_map_(false) {
+  ObUsedConn(common::ObString& full_name) : max_used_connections_(0), waiting_connections_(0), is_in_map_(false) {
     if (full_name.length() < OB_PROXY_MAX_TENANT_CLUSTER_NAME_LENGTH + common::MAX_IP_ADDR_LENGTH) {
       MEMCPY(full_name_str_, full_name.ptr(), full_name.length());
       full_name_.assign_ptr(full_name_str_, (int32_t)full_name.length());
@@ -147,14 +147,17 @@ public:
   void reset() {
     full_name_.reset();
     max_used_connections_ = 0;
+    waiting_connections_ = 0;
     is_in_map_ = false;
   }
-  TO_STRING_KV(K_(full_name), K_(max_used_connections), K_(is_in_map));
+  TO_STRING_KV(K_(full_name), K_(max_used_connections), K_(waiting_connections), K_(is_in_map));
   LINK(ObUsedConn, used_conn_link_);
 
 public:
   common::ObString full_name_;
   volatile int64_t max_used_connections_;
+  // logins which are throttled and waiting for a free connection slot
+  volatile int64_t waiting_connections_;
   bool is_in_map_;
 
 private:
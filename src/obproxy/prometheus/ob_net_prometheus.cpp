@@ -96,6 +96,22 @@ int ObNetPrometheus::handle_prometheus(const ObString &logic_tenant_name,
     break;
 
   }
+  case PROMETHEUS_NET_THREAD_TIME:
+  {
+    int64_t thread_id = va_arg(args, int64_t);
+    bool is_spin = va_arg(args, int);
+    int64_t value = va_arg(args, int64_t);
+    char thread_id_buf[32];
+    int64_t len = snprintf(thread_id_buf, sizeof(thread_id_buf), "%ld", thread_id);
+
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_THREAD, ObString(len, thread_id_buf));
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_TIME_TYPE, is_spin ? LABEL_TIME_SPIN : LABEL_TIME_WORK, false);
+
+    if (OB_FAIL(g_ob_prometheus_processor.handle_counter(NET_THREAD_TIME, NET_THREAD_TIME_HELP, label_vector, value))) {
+      LOG_WDIAG("fail to handle counter with NET_THREAD_TIME", K(thread_id), K(value), K(ret));
+    }
+    break;
+  }
   default:
     break;
   }
@@ -54,6 +54,11 @@ enum ObPrometheusMetrics
   PROMETHEUS_ENTRY_LOOKUP_COUNT,
   PROMETHEUS_REQUEST_BYTE,
   PROMETHEUS_RPC_REQUEST_BYTE,
+  PROMETHEUS_NET_THREAD_TIME,
+  PROMETHEUS_CONN_ADMISSION_WAITERS,
+  PROMETHEUS_CONN_ADMISSION_WAIT_TIME,
+  PROMETHEUS_CONN_ADMISSION_RESULT,
+  PROMETHEUS_PROXY_CPU_TIME,
   PROMETHEUS_METRIC_COUNT
 };
 
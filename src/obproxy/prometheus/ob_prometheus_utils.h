@@ -52,6 +52,19 @@ namespace prometheus
 #define REQUEST_RPC_BYTE "odp_rpc_request_byte"
 #define REQUEST_RPC_BYTE_HELP "The num of rpc request byte"
 
+#define NET_THREAD_TIME "odp_net_thread_time"
+#define NET_THREAD_TIME_HELP "The time net thread spent in busy poll finding nothing and in work, in microseconds"
+
+#define CONN_ADMISSION_WAITERS "odp_conn_admission_waiters"
+#define CONN_ADMISSION_WAITERS_HELP "The num of logins waiting for a free vip tenant connection"
+#define CONN_ADMISSION_WAIT_TIME "odp_conn_admission_wait_time"
+#define CONN_ADMISSION_WAIT_TIME_HELP "The time logins waited for a free vip tenant connection, in microseconds"
+#define CONN_ADMISSION_TOTAL "odp_conn_admission_total"
+#define CONN_ADMISSION_TOTAL_HELP "The num of logins waited for a free vip tenant connection"
+
+#define PROXY_CPU_TIME "odp_proxy_cpu_time"
+#define PROXY_CPU_TIME_HELP "The cpu time proxy spent on the requests, in microseconds"
+
 #define ENTRY_TOTAL "odp_entry_total"
 #define ENTRY_TOTAL_HELP "The num of entry lookup"
 
@@ -79,11 +92,15 @@ namespace prometheus
 #define LABEL_ROUTE_HIT "routeHit"
 #define LABEL_ROUTE_RESULT "routeResult"
 #define LABEL_CONNECT_RESULT "connectionResult"
+#define LABEL_ADMISSION_RESULT "admissionResult"
 #define LABEL_FAIL "fail"
 #define LABEL_SUCC "success"
 #define LABEL_FALSE "false"
 #define LABEL_TRUE "true"
 #define LABEL_VIP "vip"
+#define LABEL_THREAD "thread"
+#define LABEL_TIME_SPIN "spin"
+#define LABEL_TIME_WORK "work"
 
 class ObProxyPrometheusUtils
 {
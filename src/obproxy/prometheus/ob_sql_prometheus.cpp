@@ -192,6 +192,61 @@ int ObSQLPrometheus::handle_prometheus(const ObString &logic_tenant_name,
     }
     break;
   }
+  case PROMETHEUS_CONN_ADMISSION_WAITERS:
+  {
+    int32_t value = va_arg(args, int32_t);
+
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_VIP, vip_addr_name, true);
+
+    if (OB_FAIL(g_ob_prometheus_processor.handle_gauge(CONN_ADMISSION_WAITERS, CONN_ADMISSION_WAITERS_HELP,
+                                                       label_vector, value, false))) {
+      LOG_WDIAG("fail to handle gauge with CONN_ADMISSION_WAITERS", K(ret));
+    }
+    break;
+  }
+  case PROMETHEUS_CONN_ADMISSION_WAIT_TIME:
+  {
+    int64_t value = va_arg(args, int64_t);
+
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_VIP, vip_addr_name, true);
+
+    // 1ms, 10ms, 100ms, 1s, in microseconds
+    ObSortedVector<int64_t> buckets;
+    buckets.push_back(1000);
+    buckets.push_back(10 * 1000);
+    buckets.push_back(100 * 1000);
+    buckets.push_back(1000 * 1000);
+    if (OB_FAIL(g_ob_prometheus_processor.handle_histogram(CONN_ADMISSION_WAIT_TIME, CONN_ADMISSION_WAIT_TIME_HELP,
+                                                           label_vector, value, buckets))) {
+      LOG_WDIAG("fail to handle histogram with CONN_ADMISSION_WAIT_TIME", K(ret));
+    }
+    break;
+  }
+  case PROMETHEUS_CONN_ADMISSION_RESULT:
+  {
+    int32_t is_admitted = va_arg(args, int32_t);
+
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_VIP, vip_addr_name, true);
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_ADMISSION_RESULT, is_admitted ? LABEL_SUCC : LABEL_FAIL, false);
+
+    if (OB_FAIL(g_ob_prometheus_processor.handle_counter(CONN_ADMISSION_TOTAL, CONN_ADMISSION_TOTAL_HELP,
+                                                         label_vector))) {
+      LOG_WDIAG("fail to handle counter with CONN_ADMISSION_TOTAL", K(ret));
+    }
+    break;
+  }
+  case PROMETHEUS_PROXY_CPU_TIME:
+  {
+    int64_t value = va_arg(args, int64_t);
+
+    ObProxyPrometheusUtils::build_label(label_vector, LABEL_SCHEMA, database_name);
+
+    if (OB_FAIL(g_ob_prometheus_processor.handle_counter(PROXY_CPU_TIME, PROXY_CPU_TIME_HELP,
+                                                         label_vector, value))) {
+      LOG_WDIAG("fail to handle counter with PROXY_CPU_TIME", K(ret));
+    }
+    break;
+  }
   default:
     break;
   }
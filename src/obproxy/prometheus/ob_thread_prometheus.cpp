@@ -34,10 +34,12 @@
 #include "obutils/ob_proxy_config.h"
 #include "utils/ob_proxy_hot_upgrader.h"
 #include "iocore/net/ob_net_def.h"
+#include "iocore/net/ob_unix_net.h"
 #include "opsql/parser/ob_proxy_parse_result.h"
 #include "prometheus/ob_prometheus_info.h"
 #include "prometheus/ob_sql_prometheus.h"
 #include "prometheus/ob_rpc_prometheus.h"
+#include "prometheus/ob_net_prometheus.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::common::hash;
@@ -323,6 +325,18 @@ int ObSQLMonitorInfoCont::main_handler(int event, void *data)
   }
   thread_prometheus_->rpc_monitor_info_hash_map_.reuse();
 
+  //handle net thread time, the net handler keeps the total
+  if (NULL != thread_->net_handler_) {
+    const ObHRTime spin_time = thread_->net_handler_->get_spin_time();
+    const ObHRTime work_time = thread_->net_handler_->get_work_time();
+    NET_PROMETHEUS_STAT("", "", "", "", "", PROMETHEUS_NET_THREAD_TIME, thread_->id_, true,
+        hrtime_to_usec(spin_time - thread_prometheus_->net_spin_time_));
+    NET_PROMETHEUS_STAT("", "", "", "", "", PROMETHEUS_NET_THREAD_TIME, thread_->id_, false,
+        hrtime_to_usec(work_time - thread_prometheus_->net_work_time_));
+    thread_prometheus_->net_spin_time_ = spin_time;
+    thread_prometheus_->net_work_time_ = work_time;
+  }
+
   if (OB_FAIL(schedule_report_prometheus_info())) {
     LOG_WDIAG("schedule report prometheus info failed", K(ret));
   }
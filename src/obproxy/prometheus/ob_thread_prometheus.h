@@ -236,7 +236,7 @@ class ObThreadPrometheus
 {
 public:
   int init(event::ObEThread *thread);
-  ObThreadPrometheus() : monitor_info_used_(0), monitor_info_hash_map_(), rpc_monitor_info_used_(0), rpc_monitor_info_hash_map_(), sql_monitor_info_cont_(NULL), thread_(NULL) {}
+  ObThreadPrometheus() : monitor_info_used_(0), monitor_info_hash_map_(), rpc_monitor_info_used_(0), rpc_monitor_info_hash_map_(), net_spin_time_(0), net_work_time_(0), sql_monitor_info_cont_(NULL), thread_(NULL) {}
   ~ObThreadPrometheus() {}
   int set_sql_monitor_info(const common::ObString &tenant_name, const common::ObString &cluster_name, const SQLMonitorInfo &info, const ObProxyRequestType type = OBPROXY_SQL_REQUEST);
 
@@ -257,6 +257,10 @@ public:
   SQLMonitorInfo rpc_monitor_info_array_[SQL_MONITOR_INFO_ARRAY_SIZE]; //size of array must be same with monitor_info_array_, used by set_sql_monitor_info_using_array
   int64_t rpc_monitor_info_used_;
   MonitorInfoHashMap rpc_monitor_info_hash_map_;
+
+  // net thread spin and work time which has been reported
+  ObHRTime net_spin_time_;
+  ObHRTime net_work_time_;
 private:
   ObSQLMonitorInfoCont *sql_monitor_info_cont_;
   event::ObEThread *thread_;
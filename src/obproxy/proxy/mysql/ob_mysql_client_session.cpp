@@ -77,14 +77,16 @@ ObMysqlClientSession::ObMysqlClientSession()
       inner_request_param_(NULL), is_request_transferring_(false), timeout_event_(OB_TIMEOUT_UNKNOWN_EVENT),
       timeout_record_(0), conn_record_(), tcp_init_cwnd_set_(false), half_close_(false),
       conn_decrease_(false), conn_prometheus_decrease_(false), vip_connection_decrease_(false),
+      vip_connection_waiting_(false),
       magic_(MYSQL_CS_MAGIC_DEAD), create_thread_(NULL), is_local_connection_(false),
       client_vc_(NULL), in_list_stat_(LIST_INIT), current_tid_(-1),
       cs_id_(0), proxy_sessid_(0), bound_ss_(NULL), cur_ss_(NULL), lii_ss_(NULL), last_bound_ss_(NULL),
       lock_ss_(NULL), closed_key_ss_(NULL), sharding_txn_ss_addr_(), trans_coordinator_ss_addr_(), read_buffer_(NULL),
       buffer_reader_(NULL), mysql_sm_(NULL), read_state_(MCS_INIT), ka_vio_(NULL),
-      server_ka_vio_(NULL), trace_stats_(NULL), select_plan_(NULL),
+      server_ka_vio_(NULL), migrate_event_(NULL), is_migrating_(false),
+      hibernate_event_(NULL), hibernated_bytes_(0), trace_stats_(NULL), select_plan_(NULL),
       ps_id_(0), cursor_id_(CURSOR_ID_START), using_ldg_(false), using_service_name_(false),
-      cs_id_version_(CLIENT_SESSION_ID_V1), connected_time_(0)
+      cs_id_version_(CLIENT_SESSION_ID_V1), connected_time_(0), cpu_time_(0)
 {
   SET_HANDLER(&ObMysqlClientSession::main_handler);
   bool enable_session_pool = get_global_proxy_config().is_pool_mode
@@ -144,6 +146,9 @@ void ObMysqlClientSession::destroy()
     decrease_used_connections();
     vip_connection_decrease_ = false;
   }
+  if (vip_connection_waiting_) {
+    leave_vip_connection_waiting();
+  }
 
   test_server_addr_.reset();
   session_info_.destroy();
@@ -170,6 +175,10 @@ void ObMysqlClientSession::destroy()
   compressed_seq_ = 0;
   lock_ss_ = NULL;
   closed_key_ss_ = NULL;
+  migrate_event_ = NULL;
+  is_migrating_ = false;
+  hibernate_event_ = NULL;
+  hibernated_bytes_ = 0;
   sharding_txn_ss_addr_.reset();
   trans_coordinator_ss_addr_.reset();
   schema_key_.reset();
@@ -178,15 +187,13 @@ void ObMysqlClientSession::destroy()
   using_ldg_ = false;
   using_service_name_ = false;
   cs_id_version_ = CLIENT_SESSION_ID_V1;
+  cpu_time_ = 0;
   op_reclaim_free(this);
 }
 
-inline void ObMysqlClientSession::decrease_used_connections()
+void ObMysqlClientSession::get_vip_tenant_conn_name(ObString &cluster_name, ObString &tenant_name,
+                                                    ObString &ip_name)
 {
-  ObString cluster_name;
-  ObString tenant_name;
-  ObString ip_name;
-
   if (is_need_convert_vip_to_tname() && is_vip_lookup_success()) {
     cluster_name = get_vip_cluster_name();
     tenant_name  = get_vip_tenant_name();
@@ -195,11 +202,60 @@ inline void ObMysqlClientSession::decrease_used_connections()
     session_info_.get_cluster_name(cluster_name);
     session_info_.get_tenant_name(tenant_name);
   }
+}
 
+inline void ObMysqlClientSession::decrease_used_connections()
+{
+  ObString cluster_name;
+  ObString tenant_name;
+  ObString ip_name;
+
+  get_vip_tenant_conn_name(cluster_name, tenant_name, ip_name);
   get_global_conn_table_processor().dec_conn(
     cluster_name, tenant_name, ip_name);
 }
 
+int ObMysqlClientSession::enter_vip_connection_waiting()
+{
+  int ret = OB_SUCCESS;
+  ObString cluster_name;
+  ObString tenant_name;
+  ObString ip_name;
+  int64_t cur_waiting_connections = 0;
+
+  get_vip_tenant_conn_name(cluster_name, tenant_name, ip_name);
+  if (OB_UNLIKELY(vip_connection_waiting_)) {
+    ret = OB_ERR_UNEXPECTED;
+    PROXY_CS_LOG(WDIAG, "client session is already waiting for vip connection", K_(cs_id), K(ret));
+  } else if (OB_FAIL(get_global_conn_table_processor().inc_waiting_conn(
+             cluster_name, tenant_name, ip_name,
+             get_global_proxy_config().client_conn_admission_max_waiters, cur_waiting_connections))) {
+    PROXY_CS_LOG(DEBUG, "fail to wait for vip connection", K_(cs_id), K(ret));
+  } else {
+    vip_connection_waiting_ = true;
+    MYSQL_INCREMENT_DYN_STAT(CURRENT_CLIENT_CONN_ADMISSION_WAITERS);
+    MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_CONN_ADMISSION_WAITS);
+    SESSION_PROMETHEUS_STAT(session_info_, PROMETHEUS_CONN_ADMISSION_WAITERS, 1);
+    PROXY_CS_LOG(DEBUG, "succ to wait for vip connection", K_(cs_id), K(cur_waiting_connections));
+  }
+  return ret;
+}
+
+void ObMysqlClientSession::leave_vip_connection_waiting()
+{
+  if (vip_connection_waiting_) {
+    ObString cluster_name;
+    ObString tenant_name;
+    ObString ip_name;
+
+    get_vip_tenant_conn_name(cluster_name, tenant_name, ip_name);
+    get_global_conn_table_processor().dec_waiting_conn(cluster_name, tenant_name, ip_name);
+    MYSQL_DECREMENT_DYN_STAT(CURRENT_CLIENT_CONN_ADMISSION_WAITERS);
+    SESSION_PROMETHEUS_STAT(session_info_, PROMETHEUS_CONN_ADMISSION_WAITERS, -1);
+    vip_connection_waiting_ = false;
+  }
+}
+
 int ObMysqlClientSession::ssn_hook_append(ObMysqlHookID id, ObContInternal *cont)
 {
   int ret = OB_SUCCESS;
@@ -238,6 +294,7 @@ int ObMysqlClientSession::new_transaction(const bool is_new_conn/* = false*/)
     // Defensive programming, make sure nothing persists across
     // connection re-use
     half_close_ = false;
+    cancel_hibernation();
 
     read_state_ = MCS_ACTIVE_READER;
     if (OB_ISNULL(mysql_sm_ = ObMysqlSM::allocate())) {
@@ -822,6 +879,19 @@ void ObMysqlClientSession::do_io_close(const int alerrno)
   int ret = OB_SUCCESS;
   // Prevent double closing
   if (MCS_CLOSED != read_state_) {
+    if (NULL != migrate_event_) {
+      migrate_event_->cancel();
+      migrate_event_ = NULL;
+    }
+    cancel_hibernation();
+    if (is_migrating_) {
+      // the net vcs must belong to a thread to be closed
+      is_migrating_ = false;
+      if (OB_FAIL(attach_net_vcs(self_ethread()))) {
+        PROXY_CS_LOG(WDIAG, "fail to attach net vcs before close", K_(cs_id), K(ret));
+        ret = OB_SUCCESS;
+      }
+    }
     if (NULL != mysql_sm_) {
       mysql_sm_->set_detect_server_info(mysql_sm_->trans_state_.server_info_.addr_, -1, 0);
       if (mysql_sm_->connection_diagnosis_trace_ != NULL
@@ -910,9 +980,12 @@ void ObMysqlClientSession::do_io_close(const int alerrno)
       }
     }
 
-    ObClientSessionIDList &cs_id_list = get_client_session_id_list(*mutex_->thread_holding_);
-    if (OB_FAIL(cs_id_list.erase_cs_id(cs_id_))) {
-      PROXY_CS_LOG(WDIAG, "fail to record cs_id and thread_id map", K_(cs_id), "thread_id", self_ethread().id_, K(ret));
+    // the cs_id is recorded on the create thread, erase it when closing there
+    if (this_ethread() == create_thread_ || is_proxy_mysql_client_) {
+      ObClientSessionIDList &cs_id_list = get_client_session_id_list(*mutex_->thread_holding_);
+      if (OB_FAIL(cs_id_list.erase_cs_id(cs_id_))) {
+        PROXY_CS_LOG(WDIAG, "fail to record cs_id and thread_id map", K_(cs_id), "thread_id", self_ethread().id_, K(ret));
+      }
     }
 
     // in 2 situations we will delete cluster (cluster rslist and resource)
@@ -1235,6 +1308,10 @@ int ObMysqlClientSession::main_handler(int event, void *data)
       }
     } else if (is_proxy_mysql_client_ && CLIENT_VC_DISCONNECT_LAST_USED_SS_EVENT == event) {
       close_last_used_ss();
+    } else if (CLIENT_SESSION_MIGRATE_EVENT == event) {
+      event_ret = handle_migrate(static_cast<ObEvent *>(data));
+    } else if (CLIENT_SESSION_HIBERNATE_EVENT == event) {
+      event_ret = handle_hibernate(static_cast<ObEvent *>(data));
     } else {
       event_ret = (this->*cs_default_handler_)(event, data); // others
     }
@@ -1327,6 +1404,7 @@ int ObMysqlClientSession::release(ObIOBufferReader *r)
       // IO to wait for new data
       if (buffer_reader_->read_avail() > 0) {
         PROXY_CS_LOG(DEBUG, "data already in buffer, starting new transaction", K_(cs_id));
+        MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_PIPELINED_REQUESTS);
         if (OB_FAIL(new_transaction())) {
           PROXY_CS_LOG(WDIAG, "fail to start new transaction", K(ret));
         }
@@ -1336,6 +1414,8 @@ int ObMysqlClientSession::release(ObIOBufferReader *r)
         if (OB_LIKELY(server_ka_vio_ != ka_vio_)) {
           client_vc_->add_to_keep_alive_lru();
           set_wait_timeout();
+          try_hibernate();
+          try_migrate();
         }
       }
     } else {
@@ -1346,6 +1426,217 @@ int ObMysqlClientSession::release(ObIOBufferReader *r)
   return ret;
 }
 
+inline void ObMysqlClientSession::try_migrate()
+{
+  // not from inside the io callbacks of the vcs, they are still used when
+  // the callbacks return
+  if (OB_UNLIKELY(get_global_proxy_config().enable_client_session_migration)
+      && NULL == migrate_event_
+      && self_ethread().get_net_handler().need_migrate_out(get_hrtime())) {
+    migrate_event_ = self_ethread().schedule_imm_local(this, CLIENT_SESSION_MIGRATE_EVENT);
+  }
+}
+
+bool ObMysqlClientSession::can_migrate() const
+{
+  // an idle session with nothing bound to the current thread
+  return !is_proxy_mysql_client_
+         && MCS_KEEP_ALIVE == read_state_
+         && NULL == mysql_sm_
+         && LIST_ADDED == in_list_stat_
+         && NULL != client_vc_
+         && 0 == buffer_reader_->read_avail()
+         && server_ka_vio_ != ka_vio_
+         && NULL == lock_ss_
+         && NULL == last_bound_ss_
+         && !vc_ready_killed_
+         && !session_info_.is_session_pool_client_
+         && 0 == const_cast<ObMysqlSessionManagerNew &>(session_manager_new_).get_svr_session_count();
+}
+
+int64_t ObMysqlClientSession::get_migrate_vcs(ObNetVConnection **vcs, const int64_t max_count)
+{
+  int64_t count = 0;
+  ObMysqlServerSession *ss = NULL;
+  if (count < max_count && NULL != client_vc_) {
+    vcs[count++] = client_vc_;
+  }
+  if (count < max_count && NULL != bound_ss_ && NULL != bound_ss_->get_netvc()) {
+    vcs[count++] = bound_ss_->get_netvc();
+  }
+  for (int64_t i = 0; i < session_manager_.get_svr_session_count() && count < max_count; ++i) {
+    if (NULL != (ss = session_manager_.get_server_session(i)) && NULL != ss->get_netvc()) {
+      vcs[count++] = ss->get_netvc();
+    }
+  }
+  return count;
+}
+
+int ObMysqlClientSession::detach_net_vcs(ObEThread &ethread, bool &is_broken)
+{
+  int ret = OB_SUCCESS;
+  is_broken = false;
+  ObNetVConnection *vcs[MAX_MIGRATE_VC_COUNT];
+  const int64_t count = get_migrate_vcs(vcs, MAX_MIGRATE_VC_COUNT);
+  int64_t detached = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+    if (OB_FAIL(vcs[i]->detach_from_thread())) {
+      PROXY_CS_LOG(DEBUG, "net vc can not be detached now", K_(cs_id), K(i), K(ret));
+    } else {
+      ++detached;
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // stay on this thread
+    for (int64_t i = 0; i < detached; ++i) {
+      if (OB_SUCCESS != vcs[i]->attach_to_thread(ethread)) {
+        is_broken = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMysqlClientSession::attach_net_vcs(ObEThread &ethread)
+{
+  int ret = OB_SUCCESS;
+  ObNetVConnection *vcs[MAX_MIGRATE_VC_COUNT];
+  const int64_t count = get_migrate_vcs(vcs, MAX_MIGRATE_VC_COUNT);
+  // attach all of them, so that all can be closed if one fails
+  for (int64_t i = 0; i < count; ++i) {
+    if (NULL == vcs[i]->thread_) {
+      int tmp_ret = vcs[i]->attach_to_thread(ethread);
+      if (OB_SUCCESS != tmp_ret) {
+        PROXY_CS_LOG(WDIAG, "fail to attach net vc", K_(cs_id), K(i), K(tmp_ret));
+        ret = tmp_ret;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObMysqlClientSession::handle_migrate(ObEvent *e)
+{
+  int ret = OB_SUCCESS;
+  ObEThread &ethread = self_ethread();
+  if (OB_UNLIKELY(e != migrate_event_)) {
+    PROXY_CS_LOG(WDIAG, "unexpected migrate event", K(e), K_(migrate_event), K_(cs_id));
+  }
+  migrate_event_ = NULL;
+
+  if (!is_migrating_) {
+    // 1. on the busy thread, detach from it
+    ObEThread *target = NULL;
+    bool is_broken = false;
+    if (!can_migrate()) {
+      // a new transaction has started, or the session is not movable
+    } else if (NULL == (target = ethread.get_net_handler().get_migrate_target(get_hrtime()))) {
+      // no thread is idle enough
+    } else if (FALSE_IT(cancel_hibernation())) {
+    } else if (OB_FAIL(detach_net_vcs(ethread, is_broken))) {
+      if (is_broken) {
+        PROXY_CS_LOG(WDIAG, "fail to keep net vcs on current thread, close client session", K_(cs_id), K(ret));
+        do_io_close();
+      }
+    } else {
+      is_migrating_ = true;
+      if (OB_ISNULL(migrate_event_ = target->schedule_imm(this, CLIENT_SESSION_MIGRATE_EVENT))) {
+        ret = OB_ERR_UNEXPECTED;
+        PROXY_CS_LOG(WDIAG, "fail to schedule client session migration", K_(cs_id), K(ret));
+        is_migrating_ = false;
+        if (OB_FAIL(attach_net_vcs(ethread))) {
+          do_io_close();
+        }
+      } else {
+        PROXY_CS_LOG(DEBUG, "client session migrate out", K_(cs_id), "from", ethread.id_, "to", target->id_);
+      }
+    }
+  } else {
+    // 2. on the idle thread, attach to it
+    MUTEX_TRY_LOCK(lock, ethread.get_net_handler().mutex_, &ethread);
+    if (!lock.is_locked()) {
+      if (OB_ISNULL(migrate_event_ = ethread.schedule_in(this, NET_RETRY_DELAY, CLIENT_SESSION_MIGRATE_EVENT))) {
+        ret = OB_ERR_UNEXPECTED;
+        PROXY_CS_LOG(WDIAG, "fail to schedule client session migration", K_(cs_id), K(ret));
+        do_io_close();
+      }
+    } else {
+      is_migrating_ = false;
+      if (OB_FAIL(attach_net_vcs(ethread))) {
+        PROXY_CS_LOG(WDIAG, "fail to attach net vcs, close client session", K_(cs_id), K(ret));
+        do_io_close();
+      } else {
+        client_vc_->add_to_keep_alive_lru();
+        current_tid_ = GETTID();
+        try_hibernate();
+        MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_SESSION_MIGRATIONS);
+        PROXY_CS_LOG(DEBUG, "client session migrate in", K_(cs_id), "thread", ethread.id_);
+      }
+    }
+  }
+  return VC_EVENT_CONT;
+}
+
+void ObMysqlClientSession::try_hibernate()
+{
+  const int64_t idle_time = get_global_proxy_config().client_session_hibernate_idle_time;
+  if (idle_time > 0 && NULL == hibernate_event_ && 0 == hibernated_bytes_ && !is_proxy_mysql_client_) {
+    if (OB_ISNULL(hibernate_event_ = self_ethread().schedule_in(this, HRTIME_USECONDS(idle_time),
+                                                                 CLIENT_SESSION_HIBERNATE_EVENT))) {
+      PROXY_CS_LOG(WDIAG, "fail to schedule client session hibernation", K_(cs_id));
+    }
+  }
+}
+
+bool ObMysqlClientSession::can_hibernate() const
+{
+  return MCS_KEEP_ALIVE == read_state_
+         && NULL == mysql_sm_
+         && !is_migrating_
+         && NULL != read_buffer_
+         && NULL != buffer_reader_
+         && 0 == buffer_reader_->read_avail()
+         && server_ka_vio_ != ka_vio_;
+}
+
+int ObMysqlClientSession::handle_hibernate(ObEvent *e)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(e != hibernate_event_)) {
+    PROXY_CS_LOG(WDIAG, "unexpected hibernate event", K(e), K_(hibernate_event), K_(cs_id));
+  }
+  hibernate_event_ = NULL;
+
+  if (can_hibernate() && 0 == hibernated_bytes_) {
+    int64_t freed_bytes = 0;
+    for (ObIOBufferBlock *block = read_buffer_->writer_; NULL != block; block = block->next_) {
+      freed_bytes += block->get_block_size();
+    }
+    // the read vio only keeps the mio buffer, the net read adds a new block into it
+    if (freed_bytes > 0 && OB_SUCC(reset_read_buffer())) {
+      hibernated_bytes_ = freed_bytes;
+      MYSQL_INCREMENT_DYN_STAT(CURRENT_HIBERNATED_CLIENT_SESSIONS);
+      MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_SESSION_HIBERNATIONS);
+      MYSQL_SUM_DYN_STAT(CURRENT_HIBERNATED_CLIENT_SESSION_BYTES, freed_bytes);
+      PROXY_CS_LOG(DEBUG, "client session hibernate", K_(cs_id), K(freed_bytes));
+    }
+  }
+  return VC_EVENT_CONT;
+}
+
+void ObMysqlClientSession::cancel_hibernation()
+{
+  if (NULL != hibernate_event_) {
+    hibernate_event_->cancel();
+    hibernate_event_ = NULL;
+  }
+  if (hibernated_bytes_ > 0) {
+    MYSQL_DECREMENT_DYN_STAT(CURRENT_HIBERNATED_CLIENT_SESSIONS);
+    MYSQL_SUM_DYN_STAT(CURRENT_HIBERNATED_CLIENT_SESSION_BYTES, -hibernated_bytes_);
+    hibernated_bytes_ = 0;
+  }
+}
+
 int ObMysqlClientSession::init_session_pool_info()
 {
   int ret = OB_SUCCESS;
@@ -1374,15 +1665,35 @@ int ObMysqlClientSession::acquire_svr_session_in_session_pool(const sockaddr &ad
   } else if (OB_FAIL(common_addr.assign(addr))) {
     PROXY_CS_LOG(WDIAG, "assign addr failed", K(ret));
   }
+  const uint64_t session_vars_fingerprint = session_info_.get_session_vars_fingerprint();
   if (OB_SUCC(ret) && OB_SUCC(get_global_session_manager().acquire_server_session(
     schema_key_,
     common_addr,
     session_info_.get_full_username(),
-    svr_session))) {
+    svr_session,
+    true,
+    session_vars_fingerprint))) {
+    if (NULL == svr_session) {
+      MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_ACQUIRE_MISSES);
+    } else {
+      // the lent session was used by other clients, count the sync requests
+      // which it does not need as it already has our session state
+      const ObServerSessionInfo &server_info = svr_session->get_session_info();
+      MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_ACQUIRE_HITS);
+      if (server_info.get_session_vars_fingerprint() == session_vars_fingerprint) {
+        MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_FINGERPRINT_HITS);
+      }
+      if (!session_info_.need_reset_database(server_info)) {
+        MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_SYNC_SAVED);
+      }
+      if (!session_info_.need_reset_session_vars(server_info)) {
+        MYSQL_INCREMENT_DYN_STAT(SESSION_POOL_SYNC_SAVED);
+      }
+    }
     PROXY_CS_LOG(DEBUG, "[acquire server session] succ to acquire session in global session pool", K_(cs_id),
       K(session_info_.get_login_req().get_hsr_result().full_name_),
       K(schema_key_),
-      K(common_addr));
+      K(common_addr), KP(svr_session), K(session_vars_fingerprint));
   } else {
     PROXY_CS_LOG(DEBUG, "[acquire server session] fail to acquire session in global session pool", K_(cs_id),
       K(session_info_.get_login_req().get_hsr_result().full_name_),
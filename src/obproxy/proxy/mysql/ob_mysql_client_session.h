@@ -50,6 +50,8 @@ namespace proxy
 {
 #define CLIENT_SESSION_ERASE_FROM_MAP_EVENT (CLIENT_SESSION_EVENT_EVENTS_START + 1)
 #define CLIENT_SESSION_ACQUIRE_SERVER_SESSION_EVENT (CLIENT_SESSION_EVENT_EVENTS_START + 2)
+#define CLIENT_SESSION_MIGRATE_EVENT (CLIENT_SESSION_EVENT_EVENTS_START + 3)
+#define CLIENT_SESSION_HIBERNATE_EVENT (CLIENT_SESSION_EVENT_EVENTS_START + 4)
 
 extern ObMutex g_debug_cs_list_mutex;
 
@@ -296,6 +298,12 @@ public:
   int reset_read_buffer();
   event::ObIOBufferReader *get_reader() { return buffer_reader_; }
   event::ObEThread *get_create_thread() { return create_thread_; }
+  // the thread the client net vc runs on, differs from the create thread
+  // after the session has been migrated
+  event::ObEThread *get_net_thread()
+  {
+    return (NULL != client_vc_ && NULL != client_vc_->thread_) ? client_vc_->thread_ : create_thread_;
+  }
 
   int64_t get_cluster_id() const { return session_info_.get_cluster_id(); }
   const common::ObString &get_real_cluster_name() const
@@ -357,6 +365,12 @@ public:
   void set_user_identity(const ObProxyLoginUserType identity) { session_info_.set_user_identity(identity); }
   void set_conn_prometheus_decrease(bool conn_prometheus_decrease) { conn_prometheus_decrease_ = conn_prometheus_decrease; }
   void set_vip_connection_decrease(bool vip_connection_decrease) { vip_connection_decrease_ = vip_connection_decrease; }
+  bool is_vip_connection_waiting() const { return vip_connection_waiting_; }
+  // the login reached vip tenant connection throttle and waits for a free connection
+  int enter_vip_connection_waiting();
+  void leave_vip_connection_waiting();
+  void get_vip_tenant_conn_name(common::ObString &cluster_name, common::ObString &tenant_name,
+                                common::ObString &ip_name);
   void record_sess_killed(uint32_t cs_id);
   optimizer::ObShardingSelectLogPlan* get_sharding_select_log_plan() const { return select_plan_; }
   void set_sharding_select_log_plan(optimizer::ObShardingSelectLogPlan *plan) {
@@ -408,6 +422,9 @@ public:
   bool is_cs_id_v2() const { return cs_id_version_ == CLIENT_SESSION_ID_V2; }
   void set_connected_time(const int64_t connected_time) { connected_time_ = connected_time; }
   int64_t  get_connected_time() const { return  connected_time_; }
+  // cpu time proxy spent on this session, summed when each transaction completes
+  void add_cpu_time(const ObHRTime cpu_time) { cpu_time_ += cpu_time; }
+  ObHRTime get_cpu_time() const { return cpu_time_; }
 
 private:
   static uint32_t get_next_ps_stmt_id();
@@ -418,6 +435,21 @@ private:
 
   int handle_delete_cluster();
 
+  // move an idle session with its server connections to a less busy net thread
+  void try_migrate();
+  int handle_migrate(event::ObEvent *e);
+  bool can_migrate() const;
+  int64_t get_migrate_vcs(net::ObNetVConnection **vcs, const int64_t max_count);
+  int detach_net_vcs(event::ObEThread &ethread, bool &is_broken);
+  int attach_net_vcs(event::ObEThread &ethread);
+
+  // free the read buffer of a session which has been idle for a while, it is
+  // allocated again by the net read when the next packet comes
+  void try_hibernate();
+  int handle_hibernate(event::ObEvent *e);
+  bool can_hibernate() const;
+  void cancel_hibernation();
+
   void set_tcp_init_cwnd();
 
   int fetch_tenant_by_vip();
@@ -430,6 +462,8 @@ private:
 public:
   static const int64_t OP_LOCAL_NUM = 32;
   static const int64_t SCRAMBLE_SIZE = 20;
+  // the client vc, the bound server vc and the pooled server vcs
+  static const int64_t MAX_MIGRATE_VC_COUNT = ObMysqlSessionManager::MAX_SERVER_SESSION_COUNT + 2;
 
   bool can_direct_ok_;
   bool is_proxy_mysql_client_; // used for ObMysqlClient
@@ -504,6 +538,7 @@ private:
   bool conn_decrease_;
   bool conn_prometheus_decrease_;
   bool vip_connection_decrease_;
+  bool vip_connection_waiting_;
   int magic_;
 
   event::ObEThread *create_thread_;
@@ -550,6 +585,14 @@ private:
   event::ObVIO *ka_vio_;
   event::ObVIO *server_ka_vio_;
 
+  // the net vcs are detached while the session moves to another thread
+  event::ObEvent *migrate_event_;
+  bool is_migrating_;
+
+  event::ObEvent *hibernate_event_;
+  // bytes of read buffer freed by hibernation
+  int64_t hibernated_bytes_;
+
   ObConnTenantInfo ct_info_;
 
   //session info
@@ -565,6 +608,7 @@ private:
   bool using_service_name_;
   ObClientSessionIDVersion cs_id_version_;
   int64_t connected_time_;
+  ObHRTime cpu_time_;
 private:
   int acquire_client_session_id_v1();
   int acquire_client_session_id_v2();
@@ -118,6 +118,10 @@ const char *ObMysqlDebugNames::get_event_name(const int event)
       ret = "CLIENT_SESSION_ERASE_FROM_MAP__EVENT";
       break;
 
+    case CLIENT_SESSION_MIGRATE_EVENT:
+      ret = "CLIENT_SESSION_MIGRATE_EVENT";
+      break;
+
     //  MysqlTunnel Events
     case MYSQL_TUNNEL_EVENT_DONE:
       ret = "MYSQL_TUNNEL_EVENT_DONE";
@@ -44,6 +44,13 @@ void ObMysqlServerSessionList::reset()
   create_count_ = 0;
   destroy_count_ = 0;
   last_log_time_ = 0;
+  acquire_count_ = 0;
+  acquire_miss_count_ = 0;
+  last_acquire_count_ = 0;
+  last_acquire_miss_count_ = 0;
+  recent_acquire_count_ = 0;
+  recent_acquire_miss_count_ = 0;
+  last_prewarm_time_ = 0;
 }
 ObMysqlServerSessionList::~ObMysqlServerSessionList() {
   local_ip_pool_.reset();
@@ -230,10 +237,37 @@ int ObMysqlServerSessionList::remove_server_session_internal(const ObMysqlServer
   return ret;
 }
 
-ObMysqlServerSession* ObMysqlServerSessionList::acquire_from_list()
+ObMysqlServerSession* ObMysqlServerSessionList::acquire_from_list(const uint64_t session_vars_fingerprint)
 {
   DRWLock::RDLockGuard guard(rwlock_);
-  ObMysqlServerSession* ss = (ObMysqlServerSession*)server_session_list_.pop();
+  ObMysqlServerSession* ss = NULL;
+  if (0 == session_vars_fingerprint) {
+    ss = (ObMysqlServerSession*)server_session_list_.pop();
+  } else {
+    // any free session of this list can serve the client after syncing the diffs,
+    // but the one which has the same session vars needs no sync at all. only
+    // look at the latest released ones and push the others back in order, the
+    // main_handler can not remove them meanwhile as it needs the write lock
+    ObMysqlServerSession* probed[MAX_FINGERPRINT_PROBE_COUNT];
+    int64_t probed_count = 0;
+    int64_t start = 0;
+    ObMysqlServerSession* tmp = NULL;
+    while (NULL == ss && probed_count < MAX_FINGERPRINT_PROBE_COUNT
+           && NULL != (tmp = (ObMysqlServerSession*)server_session_list_.pop())) {
+      if (tmp->get_session_info().get_session_vars_fingerprint() == session_vars_fingerprint) {
+        ss = tmp;
+      } else {
+        probed[probed_count++] = tmp;
+      }
+    }
+    if (NULL == ss && probed_count > 0) {
+      ss = probed[0];
+      start = 1;
+    }
+    for (int64_t i = probed_count - 1; i >= start; --i) {
+      server_session_list_.push(probed[i]);
+    }
+  }
   if (ss != NULL) {
     ATOMIC_DEC(&free_count_);
     using_count_ = total_count_ - free_count_;
@@ -244,11 +278,38 @@ ObMysqlServerSession* ObMysqlServerSessionList::acquire_from_list()
     ss->state_ = MSS_ACTIVE;
     LOG_DEBUG("acquire_from_list", K(ss->server_ip_), K(ss->auth_user_), K(free_count_), K(using_count_), K(max_used_));
   } else {
+    ATOMIC_INC(&acquire_miss_count_);
     LOG_DEBUG("acquire_from_list is null", K(free_count_));
   }
+  ATOMIC_INC(&acquire_count_);
   return ss;
 }
 
+int64_t ObMysqlServerSessionList::calc_prewarm_target_count(const int64_t min_conn,
+    const int64_t max_conn, const int64_t max_spare)
+{
+  const int64_t now_time = event::get_hrtime();
+  if (now_time - last_prewarm_time_ >= PREWARM_RATE_WINDOW) {
+    const int64_t acquire_count = ATOMIC_LOAD(&acquire_count_);
+    const int64_t acquire_miss_count = ATOMIC_LOAD(&acquire_miss_count_);
+    // average with the last windows, so one burst does not keep spares forever
+    recent_acquire_count_ = (recent_acquire_count_ + acquire_count - last_acquire_count_) / 2;
+    recent_acquire_miss_count_ = (recent_acquire_miss_count_ + acquire_miss_count - last_acquire_miss_count_) / 2;
+    last_acquire_count_ = acquire_count;
+    last_acquire_miss_count_ = acquire_miss_count;
+    last_prewarm_time_ = now_time;
+  }
+  // each miss of the recent windows paid a full handshake, keep as many spare
+  // sessions, and at least one while the list is still being acquired from
+  int64_t spare_count = recent_acquire_miss_count_;
+  if (0 == spare_count && recent_acquire_count_ > 0) {
+    spare_count = 1;
+  }
+  spare_count = std::min(spare_count, max_spare);
+  int64_t target_count = std::max(min_conn, total_count_ - free_count_ + spare_count);
+  return std::min(target_count, max_conn);
+}
+
 // just release, if fail outer will close the session, do not close here
 int ObMysqlServerSessionList::release_to_list(ObMysqlServerSession& server_session)
 {
@@ -321,18 +382,23 @@ int ObMysqlServerSessionList::do_pool_log(const ObProxySchemaKey& schema_key, bo
   int64_t max_used = max_used_;
   int64_t create_count = create_count_;
   int64_t destroy_count = destroy_count_;
+  int64_t acquire_count = acquire_count_;
+  // percent of the acquires which skipped the handshake
+  int64_t acquire_hit_rate = acquire_count > 0 ? (acquire_count - acquire_miss_count_) * 100 / acquire_count : 0;
   if (force_log) {
     int64_t now_time = event::get_hrtime();
     last_log_time_ = now_time;
     OBPROXY_POOL_STAT_LOG(INFO, "session_pool_stat:", K(dbkey), K(max_conn), K(min_conn), K(total_count), K(free_count),
-        K(using_count), K(max_used), K(create_count),K(destroy_count), K(common_addr_), K(force_log));
+        K(using_count), K(max_used), K(create_count),K(destroy_count), K(acquire_count), K(acquire_hit_rate),
+        K(common_addr_), K(force_log));
   } else if (used_conn >= max_conn * ratio / 10000) {
     int64_t now_time = event::get_hrtime();
     int64_t interval_time = HRTIME_USECONDS(get_global_proxy_config().session_pool_stat_log_interval);
     if (now_time - last_log_time_ >= interval_time) {
       last_log_time_ = now_time;
       OBPROXY_POOL_STAT_LOG(INFO, "session_pool_stat:", K(dbkey), K(max_conn), K(min_conn), K(total_count), K(free_count),
-        K(using_count), K(max_used), K(create_count),K(destroy_count), K(common_addr_), K(force_log));
+        K(using_count), K(max_used), K(create_count),K(destroy_count), K(acquire_count), K(acquire_hit_rate),
+        K(common_addr_), K(force_log));
     } else {
       LOG_DEBUG("reach ratio and no need log", K(interval_time), K(last_log_time_),
         K(now_time), K(used_conn), K(max_conn), K(min_conn), K(schema_key));
@@ -379,6 +445,21 @@ int64_t ObMysqlServerSessionListPool::get_current_session_conn_count(
   return conn_count;
 }
 
+int64_t ObMysqlServerSessionListPool::get_prewarm_target_count(const ObCommonAddr& key)
+{
+  int ret = OB_SUCCESS;
+  int64_t target_count = ObMysqlSessionUtils::get_session_min_conn(schema_key_);
+  ObMysqlServerSessionList* ss_list = NULL;
+  if (OB_FAIL(accquire_server_seession_list(key, ss_list))) {
+  } else {
+    target_count = ss_list->calc_prewarm_target_count(target_count,
+                     ObMysqlSessionUtils::get_session_max_conn(schema_key_),
+                     get_global_proxy_config().server_conn_prewarm_max_spare);
+    ss_list->dec_ref();
+  }
+  return target_count;
+}
+
 int64_t ObMysqlServerSessionListPool::incr_client_session_count()
 {
   int64_t old_count = client_session_count_;
@@ -431,7 +512,8 @@ int ObMysqlServerSessionListPool::accquire_server_seession_list(const ObCommonAd
  int ObMysqlServerSessionListPool::acquire_server_session(
   const ObCommonAddr &key,
   ObMysqlServerSession* &server_session,
-  bool new_client)
+  bool new_client,
+  const uint64_t session_vars_fingerprint)
 {
   int ret = OB_SUCCESS;
   ObMysqlServerSessionList* ss_list = NULL;
@@ -447,7 +529,7 @@ int ObMysqlServerSessionListPool::accquire_server_seession_list(const ObCommonAd
   }
   if (OB_SUCC(ret)) {
     if (OB_FAIL(accquire_server_seession_list(key, ss_list))) {
-    } else if (NULL != (server_session = (ObMysqlServerSession*)ss_list->acquire_from_list())) {
+    } else if (NULL != (server_session = (ObMysqlServerSession*)ss_list->acquire_from_list(session_vars_fingerprint))) {
       LOG_DEBUG("acquire_session succ", K(schema_key_.dbkey_),
                 K(key), K(client_session_count_), KP(server_session));
     }
@@ -467,10 +549,11 @@ int ObMysqlServerSessionListPool::accquire_server_seession_list(const ObCommonAd
 int ObMysqlServerSessionListPool::acquire_server_session(const ObCommonAddr &addr,
     const ObString &auth_user,
     ObMysqlServerSession* &server_session,
-    bool new_client)
+    bool new_client,
+    const uint64_t session_vars_fingerprint)
 {
   UNUSED(auth_user);
-  return acquire_server_session(addr, server_session, new_client);
+  return acquire_server_session(addr, server_session, new_client, session_vars_fingerprint);
 }
 
 int ObMysqlServerSessionListPool::release_session(ObMysqlServerSession &ss)
@@ -864,7 +947,8 @@ int ObMysqlGlobalSessionManager::acquire_server_session(const ObProxySchemaKey&
     const ObCommonAddr &addr,
     const ObString &auth_user,
     ObMysqlServerSession *&server_session,
-    bool new_client)
+    bool new_client,
+    const uint64_t session_vars_fingerprint)
 {
   int ret = OB_SUCCESS;
   const common::ObString& dbkey = schema_key.dbkey_.config_string_;
@@ -878,7 +962,8 @@ int ObMysqlGlobalSessionManager::acquire_server_session(const ObProxySchemaKey&
     ret = OB_ERR_UNEXPECTED;
     LOG_WDIAG("should not null here", K(dbkey), K(auth_user));
   } else {
-    ret = server_session_list_pool->acquire_server_session(addr, auth_user, server_session, new_client);
+    ret = server_session_list_pool->acquire_server_session(addr, auth_user, server_session,
+                                                            new_client, session_vars_fingerprint);
     server_session_list_pool->dec_ref();
   }
   return ret;
@@ -920,6 +1005,19 @@ int64_t ObMysqlGlobalSessionManager::get_current_session_conn_count(const common
   }
   return conn_count;
 }
+int64_t ObMysqlGlobalSessionManager::get_prewarm_target_count(const common::ObString& dbkey,
+    const ObCommonAddr& common_addr)
+{
+  int64_t target_count = 0;
+  ObMysqlServerSessionListPool* server_session_list_pool = get_server_session_list_pool(dbkey);
+  if (OB_ISNULL(server_session_list_pool)) {
+    LOG_WDIAG("server_session_list_pool is null, should not here", K(dbkey));
+  } else {
+    target_count = server_session_list_pool->get_prewarm_target_count(common_addr);
+    server_session_list_pool->dec_ref();
+  }
+  return target_count;
+}
 int ObMysqlGlobalSessionManager::add_server_addr_if_not_exist(const ObProxySchemaKey& schema_key,
     const common::ObString& server_ip,
     int32_t server_port,
@@ -1026,7 +1124,7 @@ DEF_TO_STRING(SchemaKeyConnInfo)
 {
   int64_t pos = 0;
   J_OBJ_START();
-  J_KV(K_(schema_key), K_(addr),K_(conn_count));
+  J_KV(K_(schema_key), K_(addr),K_(conn_count), K_(target_count), K_(is_leader_switch));
   J_OBJ_END();
   return pos;
 }
@@ -1041,6 +1139,11 @@ ObMysqlContJobList<SchemaKeyConnInfo>& get_global_server_conn_job_list()
   static ObMysqlContJobList<SchemaKeyConnInfo> g_schema_key_conn_list;
   return g_schema_key_conn_list;
 }
+ObMysqlContJobList<ObLeaderSwitchInfo>& get_global_leader_switch_job_list()
+{
+  static ObMysqlContJobList<ObLeaderSwitchInfo> g_leader_switch_list;
+  return g_leader_switch_list;
+}
 
 } // end of namespace proxy
 } // end of namespace obproxy
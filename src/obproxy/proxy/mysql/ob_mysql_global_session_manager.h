@@ -58,11 +58,20 @@ public:
   int remove_server_session(const ObMysqlServerSession* server_session);
   int remove_server_session_internal(const ObMysqlServerSession* server_session);
   int remove_from_list(ObMysqlServerSession* server_session);
-  ObMysqlServerSession* acquire_from_list();
+  // prefer the free session whose session vars fingerprint is the same as
+  // the given one, 0 means take the latest released one
+  ObMysqlServerSession* acquire_from_list(const uint64_t session_vars_fingerprint = 0);
   int release_to_list(ObMysqlServerSession& server_session);
   int do_pool_log(const ObProxySchemaKey& schema_key, bool force_log = false);
+  // the total conn count this list should keep, the sessions in use plus
+  // the spare ones sized from the acquires of the recent windows, only
+  // called by the conn num check cont
+  int64_t calc_prewarm_target_count(const int64_t min_conn, const int64_t max_conn,
+                                    const int64_t max_spare);
 public:
   static const int64_t HASH_BUCKET_SIZE = 16;
+  static const int64_t MAX_FINGERPRINT_PROBE_COUNT = 8;
+  static const int64_t PREWARM_RATE_WINDOW = HRTIME_SECONDS(1);
   struct ObLocalIPHashing
   {
     typedef const ObMysqlServerSessionHashKey Key;
@@ -95,6 +104,13 @@ public:
   int64_t create_count_;
   int64_t destroy_count_;
   int64_t last_log_time_;
+  int64_t acquire_count_; // every acquire from this list, hit or miss
+  int64_t acquire_miss_count_; // acquires which found no free session
+  int64_t last_acquire_count_;
+  int64_t last_acquire_miss_count_;
+  int64_t recent_acquire_count_; // moving average per PREWARM_RATE_WINDOW
+  int64_t recent_acquire_miss_count_;
+  int64_t last_prewarm_time_;
   event::ObProxyMutex m_;
 public:
   LINK(ObMysqlServerSessionList, ip_hash_link_);
@@ -115,9 +131,11 @@ public:
   int accquire_server_seession_list(const ObCommonAddr& key, ObMysqlServerSessionList* &ss_list);
   int acquire_server_session(const ObCommonAddr &key,
                              ObMysqlServerSession* &server_session,
-                             bool new_client = true);
+                             bool new_client = true,
+                             const uint64_t session_vars_fingerprint = 0);
   int acquire_server_session(const ObCommonAddr &addr, const ObString &auth_user,
-                             ObMysqlServerSession* &server_session, bool new_client = true);
+                             ObMysqlServerSession* &server_session, bool new_client = true,
+                             const uint64_t session_vars_fingerprint = 0);
   //add when server_session create
   int add_server_session(ObMysqlServerSession& server_session);
   // remove when server_ession do_io_close()
@@ -130,6 +148,7 @@ public:
   int64_t incr_client_session_count();
   int64_t decr_client_session_count();
   int64_t get_current_session_conn_count(const ObCommonAddr& key);
+  int64_t get_prewarm_target_count(const ObCommonAddr& key);
   int add_server_addr_if_not_exist(const ObCommonAddr& common_addr);
   int add_server_addr_if_not_exist(const common::ObString& server_ip, int32_t server_port, bool is_physical);
   int remove_server_addr_if_exist(const common::ObString& server_ip, int32_t server_port, bool is_physical);
@@ -181,13 +200,16 @@ public:
                              const ObCommonAddr& addr,
                              const common::ObString& auth_user,
                              ObMysqlServerSession *&server_session,
-                             bool new_client = true);
+                             bool new_client = true,
+                             const uint64_t session_vars_fingerprint = 0);
   int release_session(ObMysqlServerSession &to_release);
   int purge_session_manager_keepalives(const common::ObString& dbkey);
   int do_close_extra_session_conn(const ObProxySchemaKey& schema_key, const ObCommonAddr& hash_key,
     int64_t need_close_num);
   int64_t get_current_session_conn_count(const common::ObString& dbkey,
                                          const ObCommonAddr& common_addr);
+  int64_t get_prewarm_target_count(const common::ObString& dbkey,
+                                   const ObCommonAddr& common_addr);
   ObMysqlServerSessionListPool* get_server_session_list_pool(const common::ObString& dbkey);
 
   int add_schema_if_not_exist(const ObProxySchemaKey& schema_key,
@@ -223,16 +245,33 @@ public:
 class SchemaKeyConnInfo
 {
 public:
-  SchemaKeyConnInfo() {}
+  SchemaKeyConnInfo() : conn_count_(0), target_count_(0), is_leader_switch_(false) {}
   ~SchemaKeyConnInfo() {}
 public:
   ObProxySchemaKey schema_key_;
   proxy::ObCommonAddr addr_;
   int64_t conn_count_;
+  int64_t target_count_; // conn count to reach, 0 means the min conn of schema_key_
+  bool is_leader_switch_; // prewarm job for the new leader of a partition
   DECLARE_TO_STRING;
   LINK(SchemaKeyConnInfo, link_);
 };
 
+// pushed by the partition cache when the leader of a partition moves, the
+// conn num check cont will prewarm the new leader for every pool which has
+// sessions on the old one
+class ObLeaderSwitchInfo
+{
+public:
+  ObLeaderSwitchInfo() {}
+  ~ObLeaderSwitchInfo() {}
+public:
+  common::ObAddr old_leader_;
+  common::ObAddr new_leader_;
+  TO_STRING_KV(K_(old_leader), K_(new_leader));
+  LINK(ObLeaderSwitchInfo, link_);
+};
+
 template <typename T>
 class ObMysqlContJobList
 {
@@ -293,6 +332,7 @@ T* ObMysqlContJobList<T>::pop()
 extern ObMysqlGlobalSessionManager& get_global_session_manager();
 extern ObMysqlContJobList<ObProxySchemaKey>& get_global_schema_key_job_list();
 extern ObMysqlContJobList<SchemaKeyConnInfo>& get_global_server_conn_job_list();
+extern ObMysqlContJobList<ObLeaderSwitchInfo>& get_global_leader_switch_job_list();
 
 
 } // end of namespace proxy
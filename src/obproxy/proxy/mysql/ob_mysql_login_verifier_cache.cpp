@@ -0,0 +1,238 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include "proxy/mysql/ob_mysql_login_verifier_cache.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/objectpool/ob_concurrency_objpool.h"
+#include "proxy/mysqllib/ob_proxy_session_info.h"
+#include "proxy/mysql/ob_mysql_global_session_utils.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::common::hash;
+using namespace oceanbase::obmysql;
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+void ObLoginVerifierEntry::reset()
+{
+  full_name_.reset();
+  scramble_.reset();
+  auth_response_.reset();
+  database_.reset();
+  user_priv_set_ = -1;
+  is_oracle_mode_ = false;
+  create_time_ = 0;
+}
+
+int ObLoginVerifierEntry::init(const ObString &full_name, const ObString &scramble,
+                               const ObString &auth_response, const ObString &database,
+                               const int64_t user_priv_set, const bool is_oracle_mode)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(full_name.empty() || full_name.length() > OB_PROXY_FULL_USER_NAME_MAX_LEN
+                  || scramble.length() > obmysql::OMPKHandshake::SCRAMBLE_TOTAL_SIZE
+                  || auth_response.empty() || auth_response.length() > MAX_AUTH_RESPONSE_LEN
+                  || database.length() > OB_MAX_DATABASE_NAME_LENGTH)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_DEBUG("login can not be cached", "name_len", full_name.length(),
+              "scramble_len", scramble.length(), "auth_response_len", auth_response.length());
+  } else {
+    MEMCPY(full_name_buf_, full_name.ptr(), full_name.length());
+    full_name_.assign_ptr(full_name_buf_, full_name.length());
+    MEMCPY(scramble_buf_, scramble.ptr(), scramble.length());
+    scramble_.assign_ptr(scramble_buf_, scramble.length());
+    MEMCPY(auth_response_buf_, auth_response.ptr(), auth_response.length());
+    auth_response_.assign_ptr(auth_response_buf_, auth_response.length());
+    MEMCPY(database_buf_, database.ptr(), database.length());
+    database_.assign_ptr(database_buf_, database.length());
+    user_priv_set_ = user_priv_set;
+    is_oracle_mode_ = is_oracle_mode;
+    create_time_ = ObTimeUtility::current_time();
+  }
+  return ret;
+}
+
+bool ObLoginVerifierEntry::is_match(const ObString &scramble, const ObString &auth_response,
+                                    const ObString &database) const
+{
+  return scramble_ == scramble && auth_response_ == auth_response && database_ == database;
+}
+
+void ObMysqlLoginVerifierCache::destroy()
+{
+  DRWLock::WRLockGuard guard(rwlock_);
+  LoginVerifierHashMap::iterator last = verifier_map_.end();
+  LoginVerifierHashMap::iterator tmp_iter;
+  for (LoginVerifierHashMap::iterator it = verifier_map_.begin(); it != last;) {
+    tmp_iter = it;
+    ++it;
+    op_free(&(*tmp_iter));
+  }
+  verifier_map_.reset();
+}
+
+int ObMysqlLoginVerifierCache::make_key(ObClientSessionInfo &client_info, char *buf,
+                                        const int64_t buf_len, ObString &key)
+{
+  int ret = OB_SUCCESS;
+  ObHSRResult &hsr = client_info.get_login_req().get_hsr_result();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid argument", K(buf), K(buf_len), K(ret));
+  } else if (OB_FAIL(ObMysqlSessionUtils::make_full_username(buf, static_cast<int>(buf_len),
+                                                             hsr.user_name_, hsr.tenant_name_,
+                                                             hsr.cluster_name_))) {
+    LOG_WDIAG("fail to make full username", K(ret));
+  } else {
+    key = ObString::make_string(buf);
+  }
+  return ret;
+}
+
+int ObMysqlLoginVerifierCache::add_verifier(ObClientSessionInfo &client_info)
+{
+  int ret = OB_SUCCESS;
+  char key_buf[OB_PROXY_FULL_USER_NAME_MAX_LEN + 1];
+  ObString key;
+  ObLoginVerifierEntry *entry = NULL;
+  const OMPKHandshakeResponse &hsr_response = client_info.get_login_req().get_hsr_result().response_;
+  if (OB_FAIL(make_key(client_info, key_buf, sizeof(key_buf), key))) {
+    LOG_WDIAG("fail to make login verifier key", K(ret));
+  } else if (OB_ISNULL(entry = op_alloc(ObLoginVerifierEntry))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WDIAG("fail to alloc login verifier entry", K(ret));
+  } else if (OB_FAIL(entry->init(key, client_info.get_scramble_string(),
+                                 hsr_response.get_auth_response(), hsr_response.get_database(),
+                                 client_info.get_priv_info().user_priv_set_,
+                                 client_info.is_oracle_mode()))) {
+    // do not cache it
+  } else {
+    DRWLock::WRLockGuard guard(rwlock_);
+    ObLoginVerifierEntry *old_entry = verifier_map_.remove(key);
+    if (NULL != old_entry) {
+      op_free(old_entry);
+      old_entry = NULL;
+    }
+    if (verifier_map_.count() >= MAX_ENTRY_COUNT) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_DEBUG("login verifier cache is full", K(key), "count", verifier_map_.count());
+    } else if (OB_FAIL(verifier_map_.unique_set(entry))) {
+      LOG_WDIAG("fail to add login verifier", K(key), K(ret));
+    } else {
+      LOG_DEBUG("succ to add login verifier", KPC(entry));
+      entry = NULL;
+    }
+  }
+
+  if (NULL != entry) {
+    op_free(entry);
+    entry = NULL;
+  }
+  return ret;
+}
+
+bool ObMysqlLoginVerifierCache::check_verifier(ObClientSessionInfo &client_info, const int64_t expire_time_us)
+{
+  int ret = OB_SUCCESS;
+  bool bret = false;
+  bool is_expired = false;
+  char key_buf[OB_PROXY_FULL_USER_NAME_MAX_LEN + 1];
+  ObString key;
+  ObLoginVerifierEntry *entry = NULL;
+  const OMPKHandshakeResponse &hsr_response = client_info.get_login_req().get_hsr_result().response_;
+  if (OB_FAIL(make_key(client_info, key_buf, sizeof(key_buf), key))) {
+    LOG_WDIAG("fail to make login verifier key", K(ret));
+  } else {
+    DRWLock::RDLockGuard guard(rwlock_);
+    if (OB_FAIL(verifier_map_.get_refactored(key, entry))) {
+      LOG_DEBUG("login verifier not found", K(key));
+    } else if (expire_time_us > 0 && ObTimeUtility::current_time() - entry->create_time_ > expire_time_us) {
+      is_expired = true;
+    } else if (entry->is_match(client_info.get_scramble_string(),
+                               hsr_response.get_auth_response(), hsr_response.get_database())) {
+      client_info.set_user_priv_set(entry->user_priv_set_);
+      client_info.set_oracle_mode(entry->is_oracle_mode_);
+      bret = true;
+    } else {
+      LOG_DEBUG("login is not the same as the cached one", K(key));
+    }
+  }
+
+  if (is_expired) {
+    // observer needs to verify it again
+    LOG_DEBUG("login verifier is expired", K(key), K(expire_time_us));
+    remove_verifier(client_info);
+  }
+  return bret;
+}
+
+void ObMysqlLoginVerifierCache::remove_verifier(ObClientSessionInfo &client_info)
+{
+  int ret = OB_SUCCESS;
+  char key_buf[OB_PROXY_FULL_USER_NAME_MAX_LEN + 1];
+  ObString key;
+  if (verifier_map_.count() <= 0) {
+    // empty, do nothing
+  } else if (OB_FAIL(make_key(client_info, key_buf, sizeof(key_buf), key))) {
+    LOG_WDIAG("fail to make login verifier key", K(ret));
+  } else {
+    ObLoginVerifierEntry *entry = NULL;
+    {
+      DRWLock::WRLockGuard guard(rwlock_);
+      entry = verifier_map_.remove(key);
+    }
+    if (NULL != entry) {
+      LOG_DEBUG("succ to remove login verifier", KPC(entry));
+      op_free(entry);
+      entry = NULL;
+    }
+  }
+}
+
+void ObMysqlLoginVerifierCache::check_user_priv_set(ObClientSessionInfo &client_info, const int64_t user_priv_set)
+{
+  int ret = OB_SUCCESS;
+  char key_buf[OB_PROXY_FULL_USER_NAME_MAX_LEN + 1];
+  ObString key;
+  bool is_changed = false;
+  if (verifier_map_.count() <= 0) {
+    // empty, do nothing
+  } else if (OB_FAIL(make_key(client_info, key_buf, sizeof(key_buf), key))) {
+    LOG_WDIAG("fail to make login verifier key", K(ret));
+  } else {
+    DRWLock::RDLockGuard guard(rwlock_);
+    ObLoginVerifierEntry *entry = NULL;
+    if (OB_SUCCESS == verifier_map_.get_refactored(key, entry) && entry->user_priv_set_ != user_priv_set) {
+      LOG_INFO("user privilege changed, remove the login verifier", KPC(entry), K(user_priv_set));
+      is_changed = true;
+    }
+  }
+
+  if (is_changed) {
+    remove_verifier(client_info);
+  }
+}
+
+ObMysqlLoginVerifierCache &get_global_login_verifier_cache()
+{
+  static ObMysqlLoginVerifierCache g_login_verifier_cache;
+  return g_login_verifier_cache;
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
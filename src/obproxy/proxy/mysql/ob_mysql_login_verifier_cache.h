@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_MYSQL_LOGIN_VERIFIER_CACHE_H_
+#define OB_MYSQL_LOGIN_VERIFIER_CACHE_H_
+
+#include "lib/hash/ob_build_in_hashmap.h"
+#include "lib/lock/ob_drw_lock.h"
+#include "lib/list/ob_intrusive_list.h"
+#include "rpc/obmysql/packet/ompk_handshake.h"
+#include "utils/ob_proxy_lib.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+class ObClientSessionInfo;
+
+// the login which observer has accepted recently, for one full username.
+// the auth response is only reusable with the same scramble, so both are kept, and
+// the database must be the same too, or the first login to observer may fail
+class ObLoginVerifierEntry
+{
+public:
+  static const int64_t MAX_AUTH_RESPONSE_LEN = 64;
+
+  ObLoginVerifierEntry() { reset(); }
+  ~ObLoginVerifierEntry() { }
+  void reset();
+
+  int init(const common::ObString &full_name, const common::ObString &scramble,
+           const common::ObString &auth_response, const common::ObString &database,
+           const int64_t user_priv_set, const bool is_oracle_mode);
+  bool is_match(const common::ObString &scramble, const common::ObString &auth_response,
+                const common::ObString &database) const;
+
+  TO_STRING_KV(K_(full_name), K_(database), K_(user_priv_set), K_(is_oracle_mode), K_(create_time));
+
+public:
+  common::ObString full_name_;
+  common::ObString scramble_;
+  common::ObString auth_response_;
+  common::ObString database_;
+  int64_t user_priv_set_;
+  bool is_oracle_mode_;
+  int64_t create_time_;
+
+  char full_name_buf_[OB_PROXY_FULL_USER_NAME_MAX_LEN];
+  char scramble_buf_[obmysql::OMPKHandshake::SCRAMBLE_TOTAL_SIZE + 1];
+  char auth_response_buf_[MAX_AUTH_RESPONSE_LEN];
+  char database_buf_[common::OB_MAX_DATABASE_NAME_LENGTH];
+
+  LINK(ObLoginVerifierEntry, verifier_link_);
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLoginVerifierEntry);
+};
+
+// used by lazy login, proxy answers ok to the client whose login is the same as the
+// one observer accepted before, and logins to observer when the first request comes
+class ObMysqlLoginVerifierCache
+{
+public:
+  static const int64_t HASH_BUCKET_SIZE = 1024;
+  static const int64_t MAX_ENTRY_COUNT = 10000;
+
+  ObMysqlLoginVerifierCache() { }
+  ~ObMysqlLoginVerifierCache() { destroy(); }
+  void destroy();
+
+  static int make_key(ObClientSessionInfo &client_info, char *buf, const int64_t buf_len,
+                      common::ObString &key);
+
+  // save the login of client_info after observer accepted it
+  int add_verifier(ObClientSessionInfo &client_info);
+  // return true if the login of client_info is the same as the cached one which is
+  // not expired, and fill the user privilege and oracle mode into client_info
+  bool check_verifier(ObClientSessionInfo &client_info, const int64_t expire_time_us);
+  void remove_verifier(ObClientSessionInfo &client_info);
+  // remove the cached verifier if the user privilege has changed
+  void check_user_priv_set(ObClientSessionInfo &client_info, const int64_t user_priv_set);
+  int64_t count() const { return verifier_map_.count(); }
+
+public:
+  struct ObLoginVerifierHashing
+  {
+    typedef const common::ObString &Key;
+    typedef ObLoginVerifierEntry Value;
+    typedef ObDLList(ObLoginVerifierEntry, verifier_link_) ListHead;
+    static uint64_t hash(Key key) { return key.hash(); }
+    static Key key(Value const *value) { return value->full_name_; }
+    static bool equal(Key lhs, Key rhs) { return lhs == rhs; }
+  };
+  typedef common::hash::ObBuildInHashMap<ObLoginVerifierHashing, HASH_BUCKET_SIZE> LoginVerifierHashMap;
+
+private:
+  common::DRWLock rwlock_;
+  LoginVerifierHashMap verifier_map_;
+  DISALLOW_COPY_AND_ASSIGN(ObMysqlLoginVerifierCache);
+};
+
+ObMysqlLoginVerifierCache &get_global_login_verifier_cache();
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+#endif // OB_MYSQL_LOGIN_VERIFIER_CACHE_H_
@@ -74,6 +74,7 @@ int ObMysqlProxyServerMain::make_net_accept_options(
 
     net_opt.accept_threads_ = config_params.net_accept_threads_;
     net_opt.frequent_accept_ = config_params.frequent_accept_;
+    net_opt.reuse_port_ = config_params.enable_reuse_port_;
     net_opt.ip_family_ = port.family_;
     net_opt.local_port_ = port.port_;
     net_opt.stacksize_ = config_params.stack_size_;
@@ -210,6 +211,11 @@ int ObMysqlProxyServerMain::start_processor_threads(const ObMysqlConfigParams &c
   int64_t grpc_threads = config_params.grpc_thread_num_;
   int64_t grpc_watch_threads = 1;
   bool enable_cpu_isolate = config_params.enable_cpu_isolate_;
+  g_event_processor.enable_coalesced_wakeup_ = config_params.enable_coalesced_wakeup_;
+  g_event_processor.enable_work_stealing_ = config_params.enable_work_stealing_;
+  g_event_processor.enable_io_buffer_slab_ = config_params.enable_io_buffer_slab_;
+  g_event_processor.io_buffer_slab_numa_local_ = config_params.io_buffer_slab_numa_local_;
+  g_event_processor.io_buffer_slab_huge_page_ = config_params.io_buffer_slab_huge_page_;
   if (OB_UNLIKELY(stack_size <= 0) || OB_UNLIKELY(event_threads <= 0)
       || OB_UNLIKELY(task_threads <= 0)) {
     ret = OB_INVALID_CONFIG;
@@ -23,6 +23,7 @@
 #include "proxy/mysqllib/ob_proxy_session_info_handler.h"
 #include "proxy/mysqllib/ob_mysql_request_builder.h"
 #include "proxy/mysqllib/ob_mysql_response_builder.h"
+#include "proxy/mysqllib/ob_mysql_analyzer_utils.h"
 #include "proxy/api/ob_plugin_vc.h"
 #include "proxy/mysql/ob_mysql_debug_names.h"
 #include "proxy/mysql/ob_prepare_statement_struct.h"
@@ -47,6 +48,7 @@
 #include "optimizer/ob_proxy_optimizer_processor.h"
 #include "dbconfig/ob_proxy_pb_utils.h"
 #include "proxy/mysql/ob_mysql_global_session_manager.h"
+#include "proxy/mysql/ob_mysql_login_verifier_cache.h"
 #include "omt/ob_white_list_table_processor.h"
 #include "omt/ob_conn_table_processor.h"
 #include "omt/ob_ssl_config_table_processor.h"
@@ -182,9 +184,11 @@ ObMysqlSM::ObMysqlSM()
       server_entry_(NULL), server_session_(NULL),
       server_buffer_reader_(NULL),
       default_handler_(NULL), pending_action_(NULL), reentrancy_count_(0),
+      cpu_time_slice_depth_(0), cpu_time_slice_begin_(0),
       terminate_sm_(false), kill_this_async_done_(false), handling_ssl_request_(false),
-      need_renew_cluster_resource_(false), is_in_trans_(true),
+      is_client_request_consumed_(false), need_renew_cluster_resource_(false), is_in_trans_(true),
       retry_acquire_server_session_count_(0), start_acquire_server_session_time_(0),
+      conn_admission_wait_start_time_(0),
       skip_plugin_(false), add_detect_server_cnt_(false), proxy_protocol_v2_(),
       server_protocol_(ObProxyProtocol::PROTOCOL_NORMAL), need_update_non_login_config_(false),
       single_leader_version_(0),
@@ -865,9 +869,10 @@ int ObMysqlSM::state_client_request_read(int event, void *data)
             MYSQL_INCREMENT_DYN_STAT(CURRENT_ACTIVE_CLIENT_CONNECTIONS);
           }
 
-          // We read the whole mysql request packet and then analyze it, so there is not
-          // data from client after reading a whole mysql request packet. The packet
-          // size is assured. Enable further IO to watch for client aborts
+          // We read the whole mysql request packet and then analyze it. If request pipelining
+          // is enabled, the requests pipelined behind it may be in client buffer too, so only
+          // the current request is consumed. Enable further IO to watch for client aborts
+          is_client_request_consumed_ = false;
           if (OB_UNLIKELY(handling_ssl_request_)) {
             client_entry_->read_vio_->nbytes_ = INT64_MAX;
           }
@@ -876,8 +881,10 @@ int ObMysqlSM::state_client_request_read(int event, void *data)
           // cancel client net_read_timeout, set to wait_timeout
           set_client_wait_timeout();
 
-          // no request data to read, reset read trigger and avoid unnecessary reading
-          if (!client_session_->is_proxy_mysql_client_) {
+          // no request data to read, reset read trigger and avoid unnecessary reading.
+          // if request pipelining is enabled, keep the trigger, the pipelined requests
+          // will be buffered behind this one while it is in flight
+          if (!client_session_->is_proxy_mysql_client_ && !is_client_request_pipelining_enabled()) {
             ObUnixNetVConnection* vc = static_cast<ObUnixNetVConnection *>(client_session_->get_netvc());
             if (!handling_ssl_request_) {
               vc->reset_read_trigger();
@@ -894,8 +901,8 @@ int ObMysqlSM::state_client_request_read(int event, void *data)
               } else if (need_wait_callback) {
                 // do nothing
               } else if (need_direct_response_for_client) {
-                if (OB_FAIL(client_buffer_reader_->consume_all())) {
-                  LOG_WDIAG("fail to consume all", K_(sm_id), K(ret));
+                if (OB_FAIL(consume_client_request())) {
+                  LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
                 } else {
                   trans_state_.next_action_ = ObMysqlTransact::SM_ACTION_INTERNAL_NOOP;
                   callout_api_and_start_next_action(ObMysqlTransact::SM_ACTION_API_SEND_RESPONSE);
@@ -945,8 +952,8 @@ int ObMysqlSM::state_client_request_read(int event, void *data)
               }
 
               if (OB_SUCC(ret) && OB_UNLIKELY(need_direct_response_for_client)) {
-                if (OB_FAIL(client_buffer_reader_->consume_all())) {
-                  LOG_WDIAG("fail to consume all", K_(sm_id), K(ret));
+                if (OB_FAIL(consume_client_request())) {
+                  LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
                 } else {
                   trans_state_.next_action_ = ObMysqlTransact::SM_ACTION_INTERNAL_NOOP;
                   callout_api_and_start_next_action(ObMysqlTransact::SM_ACTION_API_SEND_RESPONSE);
@@ -954,7 +961,9 @@ int ObMysqlSM::state_client_request_read(int event, void *data)
               }
 
               if (OB_SUCC(ret) && OB_LIKELY(!need_direct_response_for_client)) {
-                if (OB_LIKELY(client_session_->get_session_info().is_oceanbase_server())) {
+                if (OB_UNLIKELY(client_session_->is_vip_connection_waiting())) {
+                  setup_wait_conn_admission();
+                } else if (OB_LIKELY(client_session_->get_session_info().is_oceanbase_server())) {
                   setup_get_cluster_resource();
                 } else {
                   setup_set_cached_variables();
@@ -2200,21 +2209,104 @@ inline bool ObMysqlSM::check_vt_connection_throttle()
   ObString cluster_name;
   ObString tenant_name;
   ObString ip_name;
-  ObClientSessionInfo &cs_info = client_session_->get_session_info();
-  if (client_session_->is_need_convert_vip_to_tname() &&
-    client_session_->is_vip_lookup_success()) {
-    // 处理公有云vip信息
-    cluster_name = client_session_->get_vip_cluster_name();
-    tenant_name  = client_session_->get_vip_tenant_name();
-    cs_info.get_vip_addr_name(ip_name);
+  // 公有云使用vip信息, 拿不到vip信息的私有云场景: 没有vip的概念，只有集群和租户
+  client_session_->get_vip_tenant_conn_name(cluster_name, tenant_name, ip_name);
+
+  return get_global_conn_table_processor().check_and_inc_conn(
+    cluster_name, tenant_name, ip_name, client_session_->is_vip_connection_waiting());
+}
+
+// if vip tenant connections reach throttle, the login waits for a free connection instead of
+// being rejected immediately. it is not a fifo queue, every waiter polls the vip tenant every
+// CONN_ADMISSION_RETRY_INTERVAL_MS, and the first one which polls after a connection is freed
+// gets it. new logins can not get a connection while there are waiters
+inline bool ObMysqlSM::can_wait_conn_admission()
+{
+  bool bret = false;
+  if (get_global_proxy_config().client_conn_admission_wait_timeout.get() > 0
+      && get_global_proxy_config().client_conn_admission_max_waiters.get() > 0
+      && !client_session_->get_session_info().is_sharding_user()) {
+    if (OB_SUCCESS == client_session_->enter_vip_connection_waiting()) {
+      conn_admission_wait_start_time_ = event::get_hrtime();
+      bret = true;
+    } else {
+      MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_CONN_ADMISSION_REJECTS);
+      SESSION_PROMETHEUS_STAT(client_session_->get_session_info(), PROMETHEUS_CONN_ADMISSION_RESULT, false);
+    }
+  }
+  return bret;
+}
+
+void ObMysqlSM::setup_wait_conn_admission()
+{
+  int ret = OB_SUCCESS;
+  int64_t interval = HRTIME_MSECONDS(CONN_ADMISSION_RETRY_INTERVAL_MS);
+  MYSQL_SM_SET_DEFAULT_HANDLER(&ObMysqlSM::state_wait_conn_admission);
+  if (OB_ISNULL(pending_action_ = self_ethread().schedule_in(this, interval))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("fail to schedule wait conn admission", K_(sm_id), K(interval), K(ret));
+    trans_state_.inner_errcode_ = ret;
+    call_transact_and_set_next_state(ObMysqlTransact::handle_error_jump);
+  }
+}
+
+int ObMysqlSM::state_wait_conn_admission(int event, void *data)
+{
+  UNUSED(data);
+  int ret = OB_SUCCESS;
+  STATE_ENTER(ObMysqlSM::state_wait_conn_admission, event);
+  pending_action_ = NULL;
+
+  if (OB_UNLIKELY(EVENT_INTERVAL != event)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_EDIAG("unexpected event", K_(sm_id), K(event), K(ret));
+    trans_state_.inner_errcode_ = ret;
+    call_transact_and_set_next_state(ObMysqlTransact::handle_error_jump);
   } else {
-    // 拿不到vip信息的私有云场景: 没有vip的概念，只有集群和租户
-    cs_info.get_cluster_name(cluster_name);
-    cs_info.get_tenant_name(tenant_name);
+    const int64_t wait_time = event::get_hrtime() - conn_admission_wait_start_time_;
+    if (!check_vt_connection_throttle()) {
+      client_session_->leave_vip_connection_waiting();
+      client_session_->set_vip_connection_decrease(true);
+      MYSQL_SUM_DYN_STAT(TOTAL_CLIENT_CONN_ADMISSION_WAIT_TIME, wait_time);
+      SESSION_PROMETHEUS_STAT(client_session_->get_session_info(), PROMETHEUS_CONN_ADMISSION_WAIT_TIME,
+                              hrtime_to_usec(wait_time));
+      SESSION_PROMETHEUS_STAT(client_session_->get_session_info(), PROMETHEUS_CONN_ADMISSION_RESULT, true);
+      LOG_DEBUG("succ to get free vip tenant connection", K_(sm_id), "wait_time_us", hrtime_to_usec(wait_time));
+      if (OB_LIKELY(client_session_->get_session_info().is_oceanbase_server())) {
+        setup_get_cluster_resource();
+      } else {
+        setup_set_cached_variables();
+      }
+    } else if (wait_time < HRTIME_USECONDS(get_global_proxy_config().client_conn_admission_wait_timeout)) {
+      setup_wait_conn_admission();
+    } else {
+      client_session_->leave_vip_connection_waiting();
+      MYSQL_SUM_DYN_STAT(TOTAL_CLIENT_CONN_ADMISSION_WAIT_TIME, wait_time);
+      MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_CONN_ADMISSION_REJECTS);
+      SESSION_PROMETHEUS_STAT(client_session_->get_session_info(), PROMETHEUS_CONN_ADMISSION_WAIT_TIME,
+                              hrtime_to_usec(wait_time));
+      SESSION_PROMETHEUS_STAT(client_session_->get_session_info(), PROMETHEUS_CONN_ADMISSION_RESULT, false);
+      ObHSRResult &hsr = client_session_->get_session_info().get_login_req().get_hsr_result();
+      LOG_WDIAG("no free vip tenant connection after waiting, will disconnect", K_(sm_id),
+                "wait_time_us", hrtime_to_usec(wait_time));
+      COLLECT_LOGIN_DIAGNOSIS(connection_diagnosis_trace_,
+                              obutils::OB_LOGIN_DISCONNECT_TRACE, "",
+                              OB_ERR_TOO_MANY_SESSIONS,
+                              "tenant %.*s hold too many connections",
+                              hsr.tenant_name_.length(), hsr.tenant_name_.ptr());
+      if (OB_FAIL(ObMysqlTransact::encode_error_message(trans_state_, OB_ERR_CON_COUNT_ERROR))) {
+        LOG_WDIAG("fail to encode vip throttle message", K_(sm_id), K(ret));
+      } else if (OB_FAIL(consume_client_request())) {
+        LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
+      }
+      if (OB_FAIL(ret)) {
+        trans_state_.inner_errcode_ = ret;
+      }
+      call_transact_and_set_next_state(ObMysqlTransact::handle_error_jump);
+    }
   }
 
-  return get_global_conn_table_processor().check_and_inc_conn(
-    cluster_name, tenant_name, ip_name);
+  return VC_EVENT_NONE;
 }
 
 /*
@@ -2587,7 +2679,10 @@ int ObMysqlSM::analyze_change_user_request()
     LOG_WDIAG("invalid len", K(len), K(ret));
   } else {
     ObVariableLenBuffer<128> user_buffer;
-    if (OB_FAIL(user_buffer.init(len))) {
+    ObSqlString pipelined_reqs;
+    if (OB_FAIL(take_pipelined_requests(pipelined_reqs))) {
+      LOG_WDIAG("fail to take pipelined requests", K(ret));
+    } else if (OB_FAIL(user_buffer.init(len))) {
       LOG_WDIAG("fail to init user buffer", K(ret));
     } else {
       char *start = const_cast<char *>(user_buffer.ptr());
@@ -2697,6 +2792,8 @@ int ObMysqlSM::analyze_change_user_request()
 
           if (OB_FAIL(client_request.add_request(client_buffer_reader_, trans_state_.mysql_config_params_->request_buffer_length_))) {
             LOG_WDIAG("fail to add com request", K(ret));
+          } else if (OB_FAIL(restore_pipelined_requests(pipelined_reqs))) {
+            LOG_WDIAG("fail to restore pipelined requests", K(ret));
           }
         }
       }
@@ -2800,7 +2897,7 @@ int ObMysqlSM::analyze_login_request(ObRequestAnalyzeCtx &ctx, ObMysqlAnalyzeSta
                                     OB_ERR_TOO_MANY_SESSIONS, NULL);
             status = ANALYZE_ERROR; // disconnect
           } else if (!client_session_->is_proxy_mysql_client_
-                 && !unix_vc->using_ssl()
+                 && !unix_vc->is_ssl_connection()
                  && OB_NOT_NULL(multi_level_config_)
                  && multi_level_config_->ssl_attributes_.force_using_ssl_
                  && multi_level_config_->enable_client_ssl_
@@ -2816,16 +2913,21 @@ int ObMysqlSM::analyze_login_request(ObRequestAnalyzeCtx &ctx, ObMysqlAnalyzeSta
             status = ANALYZE_ERROR;
           } else {
             if (check_vt_connection_throttle()) {
-              // check cloud vip connection throttle count
-              if (OB_FAIL(ObMysqlTransact::encode_error_message(trans_state_, OB_ERR_CON_COUNT_ERROR))) {
-                LOG_WDIAG("fail to encode vip throttle message", K_(sm_id), K(ret));
+              if (can_wait_conn_admission()) {
+                // the login is analyzed, wait for a free connection in state_wait_conn_admission
+                LOG_DEBUG("vip tenant connections reach throttle, wait for a free one", K_(sm_id));
+              } else {
+                // check cloud vip connection throttle count
+                if (OB_FAIL(ObMysqlTransact::encode_error_message(trans_state_, OB_ERR_CON_COUNT_ERROR))) {
+                  LOG_WDIAG("fail to encode vip throttle message", K_(sm_id), K(ret));
+                }
+                COLLECT_LOGIN_DIAGNOSIS(connection_diagnosis_trace_,
+                                        obutils::OB_LOGIN_DISCONNECT_TRACE, "",
+                                        OB_ERR_TOO_MANY_SESSIONS,
+                                        "tenant %.*s hold too many connections",
+                                        hsr.tenant_name_.length(), hsr.tenant_name_.ptr());
+                status = ANALYZE_ERROR; // disconnect
               }
-              COLLECT_LOGIN_DIAGNOSIS(connection_diagnosis_trace_,
-                                      obutils::OB_LOGIN_DISCONNECT_TRACE, "",
-                                      OB_ERR_TOO_MANY_SESSIONS,
-                                      "tenant %.*s hold too many connections",
-                                      hsr.tenant_name_.length(), hsr.tenant_name_.ptr());
-              status = ANALYZE_ERROR; // disconnect
             } else {
               client_session_->set_vip_connection_decrease(true);
             }
@@ -2982,11 +3084,18 @@ int ObMysqlSM::do_analyze_ps_execute_request_without_flag(ObPsIdEntry *ps_id_ent
   int ret = OB_SUCCESS;
 
   int64_t param_num = ps_id_entry->get_param_count();
+  ObSqlString pipelined_reqs;
+  // the pipelined requests are moved out, so read_avail is the len of the current request
+  if (OB_FAIL(take_pipelined_requests(pipelined_reqs))) {
+    LOG_WDIAG("fail to take pipelined requests", K(ret));
+  }
   uint64_t read_avail = client_buffer_reader_->read_avail();
   const ObString& param_type = ps_id_entry->get_ps_sql_meta().get_param_type();
   int64_t param_type_pos = MYSQL_NET_META_LENGTH + MYSQL_PS_EXECUTE_HEADER_LENGTH + ((param_num + 7) /8) + 1;
   // decode execute packet to old execute obj
-  if (OB_ISNULL(client_buffer_reader_) || OB_UNLIKELY(param_type.empty())) {
+  if (OB_FAIL(ret)) {
+    // do nothing
+  } else if (OB_ISNULL(client_buffer_reader_) || OB_UNLIKELY(param_type.empty())) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WDIAG("reader is null or param_type is emptry, which is unexpected", K(param_type), KPC(ps_id_entry), K(ret));
   } else {
@@ -3054,6 +3163,10 @@ int ObMysqlSM::do_analyze_ps_execute_request_without_flag(ObPsIdEntry *ps_id_ent
     }
   }
 
+  if (OB_SUCC(ret) && OB_FAIL(restore_pipelined_requests(pipelined_reqs))) {
+    LOG_WDIAG("fail to restore pipelined requests", K(ret));
+  }
+
   return ret;
 }
 
@@ -3711,8 +3824,8 @@ int ObMysqlSM::state_execute_internal_cmd(int event, void *data)
   } else if (OB_ISNULL(client_entry_->vc_)) {
     ret = OB_INNER_STAT_ERROR;
     LOG_EDIAG("invalid internal state, client entry vc is NULL", K_(client_entry_->vc), K_(sm_id), K(ret));
-  } else  if (OB_FAIL(client_buffer_reader_->consume_all())) { // consume the client buffer
-    LOG_WDIAG("fail to consume all data in client buffer reader", K_(sm_id), K(ret));
+  } else  if (OB_FAIL(consume_client_request())) { // consume the client request
+    LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
   } else {
     pending_action_ = NULL;
     switch (event) {
@@ -4139,6 +4252,14 @@ ObProxyProtocol ObMysqlSM::get_server_session_protocol() const
   }
 }
 
+// ob20 packet has a tailer after the mysql packet, and may be compressed, so only the
+// plain mysql protocol is pipelined
+bool ObMysqlSM::is_client_request_pipelining_enabled() const
+{
+  return get_global_proxy_config().enable_client_request_pipelining
+         && ObProxyProtocol::PROTOCOL_NORMAL == get_client_session_protocol();
+}
+
 ObProxyProtocol ObMysqlSM::get_client_session_protocol() const
 {
   if (client_session_ == NULL
@@ -5427,9 +5548,12 @@ int ObMysqlSM::process_server_addr_lookup(const ObProxyKillQueryInfo *query_info
       internal_query_info->real_conn_id_ = query_info->real_conn_id_;
       if (static_cast<int64_t>(query_info->real_conn_id_) != internal_query_info->cs_id_) {
         // we need reset req pkt
+        ObSqlString pipelined_reqs;
         if (OB_ISNULL(client_buffer_reader_) || OB_ISNULL(client_buffer_reader_->mbuf_)) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WDIAG("unexpect null client_buffer",  K_(sm_id), K(ret));
+        } else if (OB_FAIL(take_pipelined_requests(pipelined_reqs))) {
+          LOG_WDIAG("fail to take pipelined requests", K_(sm_id), K(ret));
         //consume the client buffer
         } else if (OB_FAIL(client_buffer_reader_->consume_all())) {
           LOG_WDIAG("fail to consume request in buffer", K(ret));
@@ -5453,6 +5577,8 @@ int ObMysqlSM::process_server_addr_lookup(const ObProxyKillQueryInfo *query_info
           } else if (ANALYZE_DONE != result.status_) {
             ret = OB_ERR_UNEXPECTED;
             LOG_WDIAG("fail to analyze one packet, error status_", K(result.status_), K(ret));
+          } else if (OB_FAIL(restore_pipelined_requests(pipelined_reqs))) {
+            LOG_WDIAG("fail to restore pipelined requests", K_(sm_id), K(ret));
           } else {
             //update set_packet_meta as we had rewrite kill query cmd
             trans_state_.trans_info_.client_request_.set_packet_meta(result.meta_);
@@ -5573,6 +5699,8 @@ int ObMysqlSM::main_handler(int event, void *data)
     LOG_EDIAG("invalid sm magic or reentrancy_count", K_(magic), K_(reentrancy_count), K_(sm_id), K(event));
   }
   ++reentrancy_count_;
+  // the reentrant calls are counted in the outermost one
+  begin_cpu_time_slice();
 
   // Don't use the state enter macro since it uses history
   // space that we don't care about
@@ -5604,6 +5732,8 @@ int ObMysqlSM::main_handler(int event, void *data)
     }
   }
 
+  end_cpu_time_slice();
+
   // The sub-handler signals when it is time for the state machine
   // to exit. We can only exit if we are not reentrantly called
   // otherwise when the our call unwinds, we will be
@@ -6330,6 +6460,18 @@ int ObMysqlSM::trim_ok_packet(ObIOBufferReader &reader)
                                                                            trans_state_.trace_log_,
                                                                            is_only_sync_trans_sess))) {
         LOG_WDIAG("fail to save changed session info", K(ret));
+      } else if (trans_state_.is_auth_request_
+                 && OB_MYSQL_COM_LOGIN == trans_state_.trans_info_.sql_cmd_
+                 && !is_only_sync_trans_sess
+                 && get_global_proxy_config().enable_lazy_login
+                 && !client_session->is_proxy_mysql_client_
+                 && !client_session->is_session_pool_client()
+                 && !client_session->get_session_info().is_sharding_user()
+                 && client_session->get_session_info().is_oceanbase_server()) {
+        // observer accepted this login, the same login later can be answered by proxy directly
+        if (OB_SUCCESS != get_global_login_verifier_cache().add_verifier(client_session->get_session_info())) {
+          LOG_DEBUG("fail to add login verifier, ignore", K_(sm_id));
+        }
       }
     }
   }
@@ -7379,8 +7521,8 @@ inline int ObMysqlSM::handle_retry_acquire_svr_session() {
         LOG_WDIAG("fail to acquire svr session after retry", K(diff_time), K(retry_acquire_server_session_count_));
         retry_acquire_server_session_count_ = 0;
         start_acquire_server_session_time_ = 0;
-        if (OB_FAIL(client_buffer_reader_->consume_all())) {
-          LOG_WDIAG("fail to consume all", K_(sm_id), K(ret));
+        if (OB_FAIL(consume_client_request())) {
+          LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
         }
         call_transact_and_set_next_state(ObMysqlTransact::handle_error_jump);
       }
@@ -7552,6 +7694,19 @@ inline int ObMysqlSM::do_normal_internal_observer_open(ObMysqlServerSession *&se
   return ret;
 }
 
+// whether the session vars need a sync request before the user request
+static inline bool need_session_vars_sync_request(const ObClientSessionInfo &client_info,
+                                                  const ObServerSessionInfo &server_info)
+{
+  bool bret = false;
+  if (!client_info.is_server_support_session_var_sync() || client_info.need_reset_conf_sys_vars()) {
+    bret = client_info.need_reset_session_vars(server_info);
+  } else {
+    bret = client_info.need_reset_user_session_vars(server_info);
+  }
+  return bret;
+}
+
 inline int ObMysqlSM::do_internal_observer_open()
 {
   int ret = OB_SUCCESS;
@@ -7628,6 +7783,19 @@ inline int ObMysqlSM::do_internal_observer_open()
                                      "svr", server_session_->server_ip_,
                                      "sessid", static_cast<int64_t>(server_session_->get_server_sessid()));
 
+      // skip the sync if the server session already has the session vars of the client,
+      // the sys vars are sent in the extra info if the server supports session var sync
+      if (OB_MYSQL_COM_STMT_CLOSE != cmd
+          && OB_MYSQL_COM_STMT_RESET != cmd
+          && !client_session_->can_direct_send_request_
+          && OB_UNLIKELY(need_session_vars_sync_request(client_info, server_info))) {
+        const bool is_skipped = ObProxySessionInfoHandler::skip_session_vars_sync_if_same(client_info, server_info);
+        // count the sync requests saved
+        if (is_skipped && !need_session_vars_sync_request(client_info, server_info)) {
+          MYSQL_INCREMENT_DYN_STAT(SESSION_VARS_SYNC_SKIPPED);
+        }
+      }
+
       if (OB_UNLIKELY(OB_MYSQL_COM_STMT_CLOSE == cmd
                       || OB_MYSQL_COM_STMT_RESET == cmd
                       || client_session_->can_direct_send_request_)) {
@@ -7721,7 +7889,7 @@ inline int ObMysqlSM::connect_observer()
   }
   opt.ip_family_ = trans_state_.server_info_.addr_.sa_.sa_family;
   opt.is_inner_connect_ = client_session_->is_proxy_mysql_client_;
-  opt.ethread_ = client_session_->is_proxy_mysql_client_ ? this_ethread() : client_session_->get_create_thread();
+  opt.ethread_ = client_session_->is_proxy_mysql_client_ ? this_ethread() : client_session_->get_net_thread();
 
   // Set the inactivity timeout to the connect timeout so that we
   // we fail this server if it doesn't start sending the response
@@ -8090,6 +8258,58 @@ int ObMysqlSM::do_internal_request_for_sharding_select_db(ObMIOBuffer *buf)
   return ret;
 }
 
+int ObMysqlSM::consume_client_request()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(client_buffer_reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("client buffer reader is NULL", K_(sm_id), K(ret));
+  } else if (!is_client_request_pipelining_enabled()) {
+    // the rest may be the tailer of ob20 packet, consume it together
+    if (OB_FAIL(client_buffer_reader_->consume_all())) {
+      LOG_WDIAG("fail to consume all", K_(sm_id), K(ret));
+    }
+  } else if (is_client_request_consumed_) {
+    // the request has been consumed or sent, the rest are pipelined requests
+  } else if (OB_FAIL(ObMysqlAnalyzerUtils::consume_request(*client_buffer_reader_,
+      trans_state_.trans_info_.client_request_.get_packet_meta().pkt_len_))) {
+    LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
+  } else {
+    is_client_request_consumed_ = true;
+  }
+  return ret;
+}
+
+int ObMysqlSM::take_pipelined_requests(ObSqlString &pipelined_reqs)
+{
+  int ret = OB_SUCCESS;
+  const int64_t request_len = is_client_request_consumed_
+                              ? 0 : trans_state_.trans_info_.client_request_.get_packet_meta().pkt_len_;
+  pipelined_reqs.reset();
+  if (OB_ISNULL(client_buffer_reader_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("client buffer reader is NULL", K_(sm_id), K(ret));
+  } else if (!is_client_request_pipelining_enabled()) {
+    // no pipelined request, the rest may be the tailer of ob20 packet
+  } else if (OB_FAIL(ObMysqlAnalyzerUtils::take_pipelined_requests(*client_buffer_reader_,
+                                                                   request_len, pipelined_reqs))) {
+    LOG_WDIAG("fail to take pipelined requests", K_(sm_id), K(request_len), K(ret));
+  }
+  return ret;
+}
+
+int ObMysqlSM::restore_pipelined_requests(const ObSqlString &pipelined_reqs)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObMysqlAnalyzerUtils::restore_pipelined_requests(*client_buffer_reader_, pipelined_reqs.string()))) {
+    LOG_WDIAG("fail to restore pipelined requests", K_(sm_id), K(ret));
+  } else {
+    // the rewritten request is in client buffer now
+    is_client_request_consumed_ = false;
+  }
+  return ret;
+}
+
 void ObMysqlSM::do_internal_request()
 {
   int ret = OB_SUCCESS;
@@ -8098,18 +8318,12 @@ void ObMysqlSM::do_internal_request()
   ObMIOBuffer *buf = NULL;
   bool send_response_direct = true;
 
-  int64_t total_len = client_buffer_reader_->read_avail();
-  if (OB_UNLIKELY(OB_MYSQL_COM_STMT_CLOSE == trans_state_.trans_info_.sql_cmd_)
-          && OB_LIKELY(total_len > trans_state_.trans_info_.client_request_.get_packet_meta().pkt_len_)) {
-    total_len = trans_state_.trans_info_.client_request_.get_packet_meta().pkt_len_;
-  }
-
   // consume data in client buffer reader
   if (OB_UNLIKELY(NULL != pending_action_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WDIAG("[ObMysqlSM::do_internal_request]", K_(sm_id), K_(pending_action));
-  } else if (OB_FAIL(client_buffer_reader_->consume(total_len))) {
-    LOG_WDIAG("fail to consume all", K_(sm_id), K(ret));
+  } else if (OB_FAIL(consume_client_request())) {
+    LOG_WDIAG("fail to consume client request", K_(sm_id), K(ret));
   } else if (OB_FAIL(trans_state_.alloc_internal_buffer(MYSQL_BUFFER_SIZE))) {
     LOG_EDIAG("[ObMysqlSM::do_internal_request] fail to allocate internal buffer,",
               K_(sm_id), K(ret));
@@ -9364,6 +9578,10 @@ int ObMysqlSM::setup_server_request_send()
       ret = OB_ERR_UNEXPECTED;
       LOG_WDIAG("invalid request buf", K(buf_start), K(request_len), K(ret));
     } else {
+      if (ObMysqlTransact::SERVER_SEND_REQUEST == trans_state_.current_.send_action_) {
+        // the request is consumed from client buffer while it is sent to server
+        is_client_request_consumed_ = true;
+      }
       if (OB_UNLIKELY(get_global_performance_params().enable_trace_)) {
         int64_t build_server_request_end = get_based_hrtime();
         cmd_time_stats_.build_server_request_time_ += milestone_diff(build_server_request_begin, build_server_request_end);
@@ -9632,7 +9850,7 @@ int ObMysqlSM::build_error_packet_for_connection_diagnosis(bool &is_packet_build
       (trans_state_.internal_reader_ != NULL &&
       trans_state_.internal_reader_->read_avail() <= 0)) {
     // consume user request
-    if (OB_NOT_NULL(client_buffer_reader_) && OB_FAIL(client_buffer_reader_->consume_all())) {
+    if (OB_NOT_NULL(client_buffer_reader_) && OB_FAIL(consume_client_request())) {
       LOG_WDIAG("fail to consume request", K_(sm_id), K(ret));
     } else {
       int error_code = 0;
@@ -11116,6 +11334,8 @@ inline void ObMysqlSM::update_stats()
     }
 
     milestones_.trans_finish_ = get_based_hrtime();
+    // the running slice belongs to this transaction, not the next one
+    charge_cpu_time_slice();
 
     LOG_DEBUG("[ObMysqlSM::update_stats] Logging transaction", K_(sm_id));
 
@@ -11142,6 +11362,14 @@ inline void ObMysqlSM::update_stats()
     MYSQL_SUM_TRANS_STAT(TOTAL_SERVER_PROCESS_REQUEST_TIME, trans_stats_.server_process_request_time_);
     MYSQL_SUM_TRANS_STAT(TOTAL_SERVER_RESPONSE_READ_TIME, trans_stats_.server_response_read_time_);
     MYSQL_SUM_TRANS_STAT(TOTAL_SERVER_RESPONSE_ANALYZE_TIME, trans_stats_.server_response_analyze_time_);
+    MYSQL_SUM_TRANS_STAT(TOTAL_PROXY_CPU_TIME, trans_stats_.proxy_cpu_time_);
+    if (NULL != client_session_) {
+      client_session_->add_cpu_time(trans_stats_.proxy_cpu_time_);
+      if (!client_session_->is_proxy_mysql_client_ && !client_session_->is_proxysys_tenant()) {
+        SESSION_PROMETHEUS_STAT(client_session_->get_session_info(), PROMETHEUS_PROXY_CPU_TIME,
+                                hrtime_to_usec(trans_stats_.proxy_cpu_time_));
+      }
+    }
 
     trans_stats_.server_connect_time_ =
       milestone_diff(milestones_.server_connect_begin_, milestones_.server_connect_end_);
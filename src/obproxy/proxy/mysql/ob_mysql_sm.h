@@ -55,6 +55,10 @@ static const int64_t MYSQL_SM_LIST_BUCKETS = 64;
 // COM_STMT_CLOSE not return any packet, in case client sending packet continuously, here define WATER_MARK to check whether stack overflow
 static const int64_t COM_STMT_CLOSE_REQUEST_BUFFER_WATER_MARK = 1024;
 
+// the interval the waiting login polls whether it can get a free vip tenant connection,
+// waiters are not ordered, see ObMysqlSM::can_wait_conn_admission
+static const int64_t CONN_ADMISSION_RETRY_INTERVAL_MS = 5;
+
 class ObMysqlServerSession;
 
 enum ObMysqlSMMagic
@@ -189,6 +193,20 @@ public:
   event::ObIOBufferReader *get_client_buffer_reader() { return client_buffer_reader_; }
   event::ObIOBufferReader *get_server_buffer_reader() { return server_buffer_reader_; }
 
+  // consume the current request in client buffer, the requests pipelined behind it
+  // are left for the following transactions
+  int consume_client_request();
+  // the requests pipelined behind the current one are moved out of client buffer before
+  // the current request is rewritten at the head of client buffer, and written back after it
+  int take_pipelined_requests(common::ObSqlString &pipelined_reqs);
+  int restore_pipelined_requests(const common::ObSqlString &pipelined_reqs);
+
+  // the cpu time spent in the outermost handler of sm or tunnel is charged to the transaction
+  void begin_cpu_time_slice();
+  void end_cpu_time_slice();
+  // charge the time of the running slice so far, before the transaction stats are updated
+  void charge_cpu_time_slice();
+
   ObMysqlServerSession *get_server_session() { return server_session_; }
   ObMysqlClientSession *get_client_session() { return client_session_; }
   ObMysqlClientSession *get_client_session() const { return client_session_; }
@@ -224,6 +242,7 @@ public:
 
   ObProxyProtocol get_server_session_protocol() const;
   ObProxyProtocol get_client_session_protocol() const;
+  bool is_client_request_pipelining_enabled() const;
   bool is_checksum_on() const;
   bool is_extra_ok_packet_for_stats_enabled() const;
   uint8_t get_compressed_or_ob20_request_seq();
@@ -308,6 +327,9 @@ public:
   int state_execute_internal_cmd(int event, void *data);
 
   int handle_retry_acquire_svr_session();
+  bool can_wait_conn_admission();
+  void setup_wait_conn_admission();
+  int state_wait_conn_admission(int event, void *data);
   int do_internal_observer_open_event(int event, void *data);
 
   // OB Server Handlers
@@ -493,6 +515,8 @@ private:
   event::ObAction *pending_action_;
 
   int32_t reentrancy_count_;
+  int32_t cpu_time_slice_depth_;
+  ObHRTime cpu_time_slice_begin_;
 
   // The terminate flag is set by handlers and checked by the
   // main handler who will terminate the state machine
@@ -500,10 +524,12 @@ private:
   bool terminate_sm_;
   bool kill_this_async_done_;
   bool handling_ssl_request_;
+  bool is_client_request_consumed_;
   bool need_renew_cluster_resource_;
   bool is_in_trans_;
   int32_t retry_acquire_server_session_count_;
   int64_t start_acquire_server_session_time_;
+  int64_t conn_admission_wait_start_time_;
   bool skip_plugin_;
   bool add_detect_server_cnt_;
   proxy_protocol_v2::ProxyProtocolV2 proxy_protocol_v2_;
@@ -757,6 +783,29 @@ inline ObHRTime ObMysqlSM::get_based_hrtime()
   return time;
 }
 
+inline void ObMysqlSM::begin_cpu_time_slice()
+{
+  if (0 == cpu_time_slice_depth_++) {
+    cpu_time_slice_begin_ = get_hrtime_internal();
+  }
+}
+
+inline void ObMysqlSM::end_cpu_time_slice()
+{
+  if (0 == --cpu_time_slice_depth_) {
+    trans_stats_.proxy_cpu_time_ += get_hrtime_internal() - cpu_time_slice_begin_;
+  }
+}
+
+inline void ObMysqlSM::charge_cpu_time_slice()
+{
+  if (cpu_time_slice_depth_ > 0) {
+    const ObHRTime now = get_hrtime_internal();
+    trans_stats_.proxy_cpu_time_ += now - cpu_time_slice_begin_;
+    cpu_time_slice_begin_ = now;
+  }
+}
+
 inline bool ObMysqlSM::is_causal_order_read_enabled()
 {
   return trans_state_.mysql_config_params_->enable_causal_order_read_
@@ -119,7 +119,8 @@ int64_t ObTransactionStat::to_string(char *buf, const int64_t buf_len) const
   TO_STRING_TIME_US(server_response_analyze_time_);
   TO_STRING_TIME_US(ok_packet_trim_time_);
   TO_STRING_TIME_US(client_response_write_time_);
-  TO_STRING_TIME_US_END(trans_time_);
+  TO_STRING_TIME_US(trans_time_);
+  TO_STRING_TIME_US_END(proxy_cpu_time_);
   J_OBJ_END();
   return pos;
 }
@@ -273,6 +273,9 @@ struct ObTransactionStat
   ObHRTime client_response_write_time_;
 
   ObHRTime trans_time_;
+  // time spent in the handlers of sm, it is the cpu time of proxy
+  // as the handlers never block
+  ObHRTime proxy_cpu_time_;
   bool is_in_testload_trans_;
 };
 
@@ -27,6 +27,7 @@
 #include "proxy/mysqllib/ob_mysql_request_builder.h"
 #include "proxy/mysqllib/ob_mysql_analyzer_utils.h"
 #include "proxy/mysql/ob_mysql_global_session_manager.h"
+#include "proxy/mysql/ob_mysql_login_verifier_cache.h"
 #include "proxy/mysqllib/ob_2_0_protocol_utils.h"
 #include "proxy/mysql/ob_mysql_sm.h"
 #include "proxy/route/ob_route_struct.h"
@@ -543,7 +544,28 @@ bool ObMysqlTransact::can_direct_ok_for_login(ObTransState &s)
     //scan all 直接回ok
     bret = true;
   } else if (!s.sm_->client_session_->is_session_pool_client()) {
-    // should only session_pool_client
+    // lazy login, the same login was accepted by observer recently, connect to observer
+    // when the first request comes
+    if (get_global_proxy_config().enable_lazy_login
+        && !s.sm_->client_session_->is_proxy_mysql_client_
+        && !cs_info.is_sharding_user()
+        && cs_info.is_oceanbase_server()
+        && !s.mysql_config_params_->is_mysql_routing_mode()
+        && get_global_login_verifier_cache().check_verifier(
+               cs_info, get_global_proxy_config().lazy_login_verifier_expire_time)) {
+      const ObString &database = cs_info.get_login_req().get_hsr_result().response_.get_database();
+      if (!database.empty() && OB_SUCCESS != cs_info.set_database_name(database)) {
+        LOG_WDIAG("fail to set database name, login to observer now", K(database));
+        // let observer's login response fill it
+        cs_info.set_user_priv_set(-1);
+      } else {
+        ObProxyMutex *mutex_ = s.sm_->mutex_; // for stat
+        MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_LAZY_LOGINS);
+        LOG_DEBUG("login is the same as the cached one, response ok directly",
+                  "cs_id", s.sm_->client_session_->get_cs_id(), K(database));
+        bret = true;
+      }
+    }
   } else if (cs_info.is_sharding_user()) {
     //V2 sharding_user 直接回ok
     bret = true;
@@ -1374,8 +1396,8 @@ void ObMysqlTransact::handle_fetch_request(ObTransState &s)
     tmp_ret = OB_CURSOR_NOT_EXIST;
   }
 
-  if (OB_FAIL(s.sm_->get_client_buffer_reader()->consume_all())) {
-    LOG_WDIAG("client buffer reader fail to consume all", K(ret));
+  if (OB_FAIL(s.sm_->consume_client_request())) {
+    LOG_WDIAG("client buffer reader fail to consume client request", K(ret));
   } else if (OB_FAIL(ObMysqlTransact::encode_error_message(s))) {
     LOG_WDIAG("fail to build err packet", K(ret));
   }
@@ -1416,8 +1438,8 @@ void ObMysqlTransact::handle_target_db_not_allow(ObTransState &s)
 void ObMysqlTransact::handle_explain_route(ObTransState &s)
 {
   int ret = OB_SUCCESS;
-  if (OB_FAIL(s.sm_->get_client_buffer_reader()->consume_all())) {
-    LOG_WDIAG("client buffer reader fail to consume all for target db", K(ret));
+  if (OB_FAIL(s.sm_->consume_client_request())) {
+    LOG_WDIAG("client buffer reader fail to consume client request for explain route", K(ret));
   } else if (OB_FAIL(ObMysqlResponseBuilder::build_explain_route_resp(*s.internal_buffer_,
                                                                       s.trans_info_.client_request_,
                                                                       *s.sm_->client_session_,
@@ -2105,6 +2127,10 @@ inline void ObMysqlTransact::ObPartitionLookupInfo::pl_update_if_necessary(const
         if (is_leader != is_partition_hit || has_table_but_no_leader) {
           LOG_INFO("will set strong read route dirty", K(is_leader), K(is_partition_hit), K(has_table_but_no_leader),
                 "origin_name", te_name_, "route_info", route_);
+          if (is_leader && !is_partition_hit) {
+            ObProxyMutex *mutex_ = s.sm_->mutex_; // for stat
+            PROCESSOR_INCREMENT_DYN_STAT(UPDATE_ROUTE_ENTRY_BY_PARTITION_MISS);
+          }
           //NOTE:: if leader was congested from server, it will set_dirty in ObMysqlTransact::handle_congestion_control_lookup
           //       here we only care response
           if (route_.set_target_dirty()) {
@@ -2132,6 +2158,10 @@ inline void ObMysqlTransact::ObPartitionLookupInfo::pl_update_if_necessary(const
                    K(update_by_leader_dead), K(update_by_hit_all_leader),
                    K(is_need_force_flush), "origin_name", te_name_,
                    "route_info", route_, "hit_replica", hit_replica);
+          if (update_by_not_hit) {
+            ObProxyMutex *mutex_ = s.sm_->mutex_; // for stat
+            PROCESSOR_INCREMENT_DYN_STAT(UPDATE_ROUTE_ENTRY_BY_PARTITION_MISS);
+          }
 
           if (route_.set_target_dirty(is_need_force_flush)) {
             get_pl_task_flow_controller().handle_new_task();
@@ -2987,7 +3017,7 @@ void ObMysqlTransact::handle_server_addr_lookup(ObTransState &s)
     if (OB_ISNULL(sm)) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WDIAG("unexpect empty sm", K(ret));
-    } else if (OB_FAIL(sm->get_client_buffer_reader()->consume_all())) {
+    } else if (OB_FAIL(sm->consume_client_request())) {
       LOG_WDIAG("[ObMysqlTransact::handle_server_addr_lookup] fail to consume client_buffer_reader_", K(ret));
     } else if (OB_FAIL(s.alloc_internal_buffer(MYSQL_BUFFER_SIZE))) {
       LOG_WDIAG("[ObMysqlTransact::handle_server_addr_lookup] fail to allocate internal miobuffer", K(ret));
@@ -3537,11 +3567,11 @@ int ObMysqlTransact::build_server_request(ObTransState &s, ObIOBufferReader *&re
       }
 
       case SERVER_SEND_LOGIN: {
-        // before send first login packet, we must consume current buffer
-        if (OB_FAIL(client_buffer_reader->consume_all())) {
+        // before send first login packet, we must consume the login request in client buffer
+        if (OB_FAIL(s.sm_->consume_client_request())) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WDIAG("[ObMysqlTransact::build_server_request] "
-                   "failed to consume all data in client buffer reader", K(ret));
+                   "failed to consume login request in client buffer reader", K(ret));
         } else {
           if (s.sm_->client_session_->get_session_info().is_oceanbase_server()) {
             if (s.mysql_config_params_->is_mysql_routing_mode()) {
@@ -4485,7 +4515,8 @@ inline int ObMysqlTransact::handle_oceanbase_saved_login_succ(ObTransState &s)
       LOG_WDIAG("fail to get ok packet from server buffer reader", K(ret));
     } else {
       const ObIArray<ObStringKV> &sys_var = ok_packet.get_system_vars();
-      // current, we only care about OB_SV_PROXY_GLOBAL_VARIABLES_VERSION and OB_SV_CAPABILITY_FLAG
+      // current, we only care about OB_SV_PROXY_GLOBAL_VARIABLES_VERSION and OB_SV_CAPABILITY_FLAG,
+      // and OB_SV_PROXY_USER_PRIVILEGE for lazy login
       for (int64_t i = 0; i < sys_var.count() && OB_SUCC(ret); ++i) {
         const ObStringKV &str_kv = sys_var.at(i);
         // check global vars version, if the global vars has changed, we no need to check again
@@ -4499,6 +4530,18 @@ inline int ObMysqlTransact::handle_oceanbase_saved_login_succ(ObTransState &s)
                   client_info, server_info, str_kv.value_, false, need_save))) {
             LOG_WDIAG("fail to handle capability flag var", K(str_kv), K(ret));
           }
+        } else if (str_kv.key_ == OB_SV_PROXY_USER_PRIVILEGE
+                   && s.sm_->client_session_->can_direct_ok()
+                   && !s.sm_->client_session_->is_session_pool_client()) {
+          // lazy login took the user privilege from the login verifier cache,
+          // correct it if it has changed since then
+          int64_t user_priv_set = -1;
+          if (OB_FAIL(get_int_value(str_kv.value_, user_priv_set))) {
+            LOG_WDIAG("fail to get int from string", "string value", str_kv.value_, K(ret));
+          } else if (user_priv_set != client_info.get_priv_info().user_priv_set_) {
+            get_global_login_verifier_cache().check_user_priv_set(client_info, user_priv_set);
+            client_info.set_user_priv_set(user_priv_set);
+          }
         } else {} // do not handle other vars
       } //  end of for
     }
@@ -4559,7 +4602,7 @@ void ObMysqlTransact::handle_error_resp(ObTransState &s, bool &is_user_request)
   switch(s.current_.send_action_) {
     case SERVER_SEND_HANDSHAKE:
       if (!s.sm_->client_session_->get_session_info().is_oceanbase_server()) {
-        if (OB_SUCCESS != s.sm_->get_client_buffer_reader()->consume_all()) {
+        if (OB_SUCCESS != s.sm_->consume_client_request()) {
           s.current_.state_ = INTERNAL_ERROR;
           LOG_WDIAG("fail to consume client buffer reader", "state", s.current_.state_);
         } else {
@@ -4634,6 +4677,7 @@ void ObMysqlTransact::handle_error_resp(ObTransState &s, bool &is_user_request)
           K(resp));
         } else {
           is_user_request = true;
+          get_global_login_verifier_cache().remove_verifier(s.sm_->client_session_->get_session_info());
 
           // case above may retry OB_MYSQL_COM_LOGIN
           // record login diagnosis log here because client will disconnect while receive error packet
@@ -4718,6 +4762,13 @@ void ObMysqlTransact::handle_error_resp(ObTransState &s, bool &is_user_request)
         K(resp));
       } else {
         s.current_.error_type_ = SAVED_LOGIN_COMMON_ERROR;
+        if (s.sm_->client_session_->can_direct_ok() && !s.sm_->client_session_->is_session_pool_client()) {
+          // lazy login is refused by observer, maybe the password has changed
+          ObProxyMutex *mutex_ = s.sm_->mutex_; // for stat
+          MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_LAZY_LOGIN_FAILURES);
+          get_global_login_verifier_cache().remove_verifier(s.sm_->client_session_->get_session_info());
+          LOG_WDIAG("lazy login is refused by observer", K(resp));
+        }
       }
       break;
 
@@ -4741,7 +4792,7 @@ void ObMysqlTransact::handle_error_resp(ObTransState &s, bool &is_user_request)
       } else if (obmysql::OB_MYSQL_COM_STMT_RESET == s.trans_info_.sql_cmd_ ||
         s.trans_info_.client_request_.get_parse_result().is_text_ps_drop_stmt()) {
         // RESET 请求因为要发送给指定 Server, 如果该 Server 执行发生错误，直接返回错误包
-        if (OB_SUCCESS != s.sm_->get_client_buffer_reader()->consume_all()) {
+        if (OB_SUCCESS != s.sm_->consume_client_request()) {
           s.current_.state_ = INTERNAL_ERROR;
           LOG_WDIAG("fail to consume client buffer reader", "state", s.current_.state_);
         } else {
@@ -5554,11 +5605,14 @@ int ObMysqlTransact::handle_rewrite_request(ObTransState &s)
     ret = OB_ERR_UNEXPECTED;
     LOG_WDIAG("[ObMysqlTransact::handle_rewrite_request] client reader is NULL");
   } else {
-    // rewrite request to client buffer in order to retry
+    // rewrite request to client buffer in order to retry, in front of the pipelined requests
     ObString req_pkt = s.trans_info_.client_request_.get_req_pkt();
     int64_t pkt_len = req_pkt.length();
     int64_t written_len = 0;
-    if (0 != client_reader->read_avail() || req_pkt.empty()) {
+    ObSqlString pipelined_reqs;
+    if (OB_FAIL(s.sm_->take_pipelined_requests(pipelined_reqs))) {
+      LOG_WDIAG("[ObMysqlTransact::handle_rewrite_request] fail to take pipelined requests", K(ret));
+    } else if (0 != client_reader->read_avail() || req_pkt.empty()) {
       ret = OB_INNER_STAT_ERROR;
       LOG_EDIAG("[ObMysqlTransact::handle_rewrite_request] invalid internal state",
                 "read_avail", client_reader->read_avail(), K(req_pkt));
@@ -5570,11 +5624,41 @@ int ObMysqlTransact::handle_rewrite_request(ObTransState &s)
       ret = OB_ERR_UNEXPECTED;
       LOG_WDIAG("request packet length must be equal with written len",
                "request_length", pkt_len,  K(written_len), K(ret));
+    } else if (OB_FAIL(s.sm_->restore_pipelined_requests(pipelined_reqs))) {
+      LOG_WDIAG("[ObMysqlTransact::handle_rewrite_request] fail to restore pipelined requests", K(ret));
     }
   }
   return ret;
 }
 
+// observer may disconnect after the request was sent, if nothing has been sent to client
+// yet, the select request outside transaction can be sent to another server safely
+bool ObMysqlTransact::can_replay_request(ObTransState &s)
+{
+  bool bret = false;
+  ObProxyMysqlRequest &client_request = s.trans_info_.client_request_;
+  ObSqlParseResult &parse_result = client_request.get_parse_result();
+  ObIOBufferReader *client_reader = s.sm_->get_client_buffer_reader();
+  if (get_global_proxy_config().enable_read_request_replay
+      && (CONNECTION_ERROR == s.current_.state_ || CONNECTION_CLOSED == s.current_.state_)
+      && SERVER_SEND_REQUEST == s.current_.send_action_
+      && OB_MYSQL_COM_QUERY == client_request.get_packet_meta().cmd_
+      && s.sm_->client_session_->get_session_info().is_oceanbase_server()
+      && !s.mysql_config_params_->is_mysql_routing_mode()) {
+    bret = parse_result.is_select_stmt()
+           && !parse_result.has_for_update()
+           && !s.is_hold_start_trans_
+           && !s.is_hold_xa_start_
+           && !is_in_trans(s)
+           && !need_use_tunnel(s)
+           && !client_request.get_req_pkt().empty()
+           && 0 == s.sm_->cmd_size_stats_.client_response_bytes_
+           && NULL != client_reader
+           && 0 == client_reader->read_avail();
+  }
+  return bret;
+}
+
 void ObMysqlTransact::handle_oceanbase_server_resp_error(ObTransState &s, ObMySQLCmd request_cmd, ObMySQLCmd current_cmd)
 {
   int ret = OB_SUCCESS;
@@ -5772,6 +5856,19 @@ inline void ObMysqlTransact::handle_response_from_server(ObTransState &s)
 
   handle_server_failed(s);
 
+  if (OB_UNLIKELY(can_replay_request(s))) {
+    if (OB_SUCCESS == handle_rewrite_request(s)) {
+      ObProxyMutex *mutex_ = s.sm_->mutex_; // for stat
+      MYSQL_INCREMENT_DYN_STAT(TOTAL_CLIENT_REQUEST_REPLAYS);
+      LOG_INFO("observer disconnected before any response sent to client, will replay the request",
+               "server_state", get_server_state_name(s.current_.state_),
+               "server_ip", s.server_info_.addr_,
+               "attempts", s.current_.attempts_,
+               "sql", s.trans_info_.get_print_sql());
+      s.current_.state_ = CONNECT_ERROR;
+    }
+  }
+
   // after handle response, before cmd complete, record current server session addr and sess id for next sql
   if (OB_NOT_NULL(s.sm_->get_client_session())
       && !s.sm_->client_session_->is_proxy_mysql_client_
@@ -7136,8 +7233,8 @@ int ObMysqlTransact::encode_error_message(ObTransState &s, int err_code)
   int ret = OB_SUCCESS;
 
   if (s.sm_ != NULL) {
-    if (s.sm_->get_client_buffer_reader() != NULL && OB_FAIL(s.sm_->get_client_buffer_reader()->consume_all())) {
-      LOG_WDIAG("client buffer reader fail to consume all", K(ret));
+    if (s.sm_->get_client_buffer_reader() != NULL && OB_FAIL(s.sm_->consume_client_request())) {
+      LOG_WDIAG("client buffer reader fail to consume client request", K(ret));
     } else {
       ObMysqlClientSession *client_session = s.sm_->get_client_session();
       if (err_code != 0) {
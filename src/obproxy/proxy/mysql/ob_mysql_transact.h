@@ -937,6 +937,7 @@ enum ObServerRespErrorType
 
   static void handle_server_failed(ObTransState &s);
   static int handle_rewrite_request(ObTransState &s);
+  static bool can_replay_request(ObTransState &s);
   static void handle_oceanbase_server_resp_error(ObTransState &s, obmysql::ObMySQLCmd request_cmd, obmysql::ObMySQLCmd current_cmd);
   static void handle_server_resp_error(ObTransState &s);
 
@@ -1160,6 +1160,9 @@ int ObMysqlTunnel::main_handler(int event, void *data)
     LOG_WDIAG("failed to check sm magic", K_(sm_->magic), "expected", MYSQL_SM_MAGIC_ALIVE);
   }
 
+  // the tunnel is a separate continuation, its cpu time is charged to the sm too
+  sm_->begin_cpu_time_slice();
+
   // Find the appropriate entry
   if (NULL != (p = get_producer(reinterpret_cast<ObVIO *>(data)))) {
     sm_callback = producer_handler(event, *p);
@@ -1186,6 +1189,9 @@ int ObMysqlTunnel::main_handler(int event, void *data)
     }
   }
 
+  // end the slice before calling back sm, which times itself and may be destroyed
+  sm_->end_cpu_time_slice();
+
   // We called a vc handler, the tunnel might be finished.
   // Check to see if there are any remaining VConnections
   // alive. If not, notify the state machine
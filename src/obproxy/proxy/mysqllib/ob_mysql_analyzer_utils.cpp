@@ -425,6 +425,63 @@ int ObMysqlAnalyzerUtils::consume_and_compress_data(
   return ret;
 }
 
+int ObMysqlAnalyzerUtils::consume_request(ObIOBufferReader &reader, const int64_t request_len)
+{
+  int ret = OB_SUCCESS;
+  int64_t consume_len = reader.read_avail();
+  if (request_len > 0 && consume_len > request_len) {
+    consume_len = request_len;
+  }
+  if (OB_FAIL(reader.consume(consume_len))) {
+    LOG_WDIAG("fail to consume request", K(consume_len), K(request_len), K(ret));
+  }
+  return ret;
+}
+
+int ObMysqlAnalyzerUtils::take_pipelined_requests(ObIOBufferReader &reader, const int64_t request_len,
+                                                  ObSqlString &pipelined_reqs)
+{
+  int ret = OB_SUCCESS;
+  const int64_t pipelined_len = reader.read_avail() - request_len;
+  pipelined_reqs.reset();
+  if (OB_ISNULL(reader.mbuf_) || OB_UNLIKELY(request_len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid argument", K(reader.mbuf_), K(request_len), K(ret));
+  } else if (pipelined_len > 0) {
+    if (OB_FAIL(pipelined_reqs.reserve(pipelined_len))) {
+      LOG_WDIAG("fail to reserve pipelined requests", K(pipelined_len), K(ret));
+    } else if (OB_UNLIKELY(reader.copy(pipelined_reqs.ptr(), pipelined_len, request_len)
+                           != pipelined_reqs.ptr() + pipelined_len)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WDIAG("fail to copy pipelined requests", K(request_len), K(pipelined_len), K(ret));
+    } else if (OB_FAIL(pipelined_reqs.set_length(pipelined_len))) {
+      LOG_WDIAG("fail to set pipelined requests length", K(pipelined_len), K(ret));
+    } else if (OB_FAIL(reader.mbuf_->trim(reader, pipelined_len))) {
+      LOG_WDIAG("fail to trim pipelined requests", K(pipelined_len), K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObMysqlAnalyzerUtils::restore_pipelined_requests(ObIOBufferReader &reader, const ObString &pipelined_reqs)
+{
+  int ret = OB_SUCCESS;
+  int64_t written_len = 0;
+  if (pipelined_reqs.empty()) {
+    // do nothing
+  } else if (OB_ISNULL(reader.mbuf_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("reader mbuf is NULL", K(ret));
+  } else if (OB_FAIL(reader.mbuf_->write(pipelined_reqs.ptr(), pipelined_reqs.length(), written_len))) {
+    LOG_WDIAG("fail to write pipelined requests", "length", pipelined_reqs.length(), K(ret));
+  } else if (OB_UNLIKELY(pipelined_reqs.length() != written_len)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WDIAG("pipelined requests length must be equal with written len",
+              "length", pipelined_reqs.length(), K(written_len), K(ret));
+  }
+  return ret;
+}
+
 } // end of namespace proxy
 } // end of namespace obproxy
 } // end of namespace oceanbase
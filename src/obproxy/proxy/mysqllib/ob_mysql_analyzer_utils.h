@@ -14,6 +14,7 @@
 #define OBPROXY_MYSQL_ANALYZER_UTILS_H
 
 #include "lib/ob_define.h"
+#include "lib/string/ob_sql_string.h"
 #include "proxy/mysqllib/ob_mysql_common_define.h"
 #include "proxy/mysqllib/ob_resp_analyzer_util.h"
 #include "proxy/mysqllib/ob_compressed_header_param.h"
@@ -86,6 +87,19 @@ public:
                                     const int64_t compressed_len,
                                     char *compressed_hdr_buf_start);
 
+  // @reader, contain the current request at the head, maybe followed by pipelined requests
+  // @request_len, the len of the current request, include header
+  // only the current request is consumed, the pipelined requests are kept in reader
+  static int consume_request(event::ObIOBufferReader &reader, const int64_t request_len);
+
+  // @reader, contain the current request at the head, maybe followed by pipelined requests
+  // @request_len, the len of the current request in reader, 0 if it has been consumed
+  // move the pipelined requests out of reader, so the current request can be rewritten in reader
+  static int take_pipelined_requests(event::ObIOBufferReader &reader, const int64_t request_len,
+                                     common::ObSqlString &pipelined_reqs);
+
+  // write the pipelined requests back to reader, behind the rewritten request
+  static int restore_pipelined_requests(event::ObIOBufferReader &reader, const common::ObString &pipelined_reqs);
 };
 
 } // end of namespace proxy
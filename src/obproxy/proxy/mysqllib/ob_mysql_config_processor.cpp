@@ -60,6 +60,7 @@ ObMysqlConfigParams::ObMysqlConfigParams()
     server_tcp_init_cwnd_(0),
 
     frequent_accept_(false),
+    enable_reuse_port_(false),
     net_accept_threads_(0),
     default_inactivity_timeout_(0),
     observer_query_timeout_delta_(0),
@@ -121,6 +122,11 @@ ObMysqlConfigParams::ObMysqlConfigParams()
     proxy_id_(0),
     client_max_memory_size_(0),
     enable_cpu_isolate_(false),
+    enable_coalesced_wakeup_(false),
+    enable_work_stealing_(false),
+    enable_io_buffer_slab_(false),
+    io_buffer_slab_numa_local_(false),
+    io_buffer_slab_huge_page_(false),
     enable_primary_zone_(true),
     ip_listen_mode_(0),
     local_bound_ipv6_ip_(),
@@ -168,6 +174,7 @@ int ObMysqlConfigParams::assign_config(const ObProxyConfig &proxy_config)
   CONFIG_ITEM_ASSIGN(client_tcp_user_timeout);
 
   CONFIG_ITEM_ASSIGN(frequent_accept);
+  CONFIG_ITEM_ASSIGN(enable_reuse_port);
   CONFIG_ITEM_ASSIGN(net_accept_threads);
   CONFIG_TIME_ASSIGN(default_inactivity_timeout);
   CONFIG_TIME_ASSIGN(observer_query_timeout_delta);
@@ -226,6 +233,11 @@ int ObMysqlConfigParams::assign_config(const ObProxyConfig &proxy_config)
   CONFIG_ITEM_ASSIGN(proxy_id);
   CONFIG_ITEM_ASSIGN(client_max_memory_size);
   CONFIG_ITEM_ASSIGN(enable_cpu_isolate);
+  CONFIG_ITEM_ASSIGN(enable_coalesced_wakeup);
+  CONFIG_ITEM_ASSIGN(enable_work_stealing);
+  CONFIG_ITEM_ASSIGN(enable_io_buffer_slab);
+  CONFIG_ITEM_ASSIGN(io_buffer_slab_numa_local);
+  CONFIG_ITEM_ASSIGN(io_buffer_slab_huge_page);
   CONFIG_ITEM_ASSIGN(enable_primary_zone);
   CONFIG_ITEM_ASSIGN(ip_listen_mode);
   CONFIG_TIME_ASSIGN(read_stale_retry_interval);
@@ -328,7 +340,7 @@ DEF_TO_STRING(ObMysqlConfigParams)
        K_(server_tcp_keepidle), K_(server_tcp_keepintvl),
        K_(server_tcp_keepcnt), K_(server_tcp_user_timeout),
        K_(sock_option_flag_out), K_(sock_packet_mark_out), K_(sock_packet_tos_out),
-       K_(server_tcp_init_cwnd), K_(frequent_accept), K_(net_accept_threads));
+       K_(server_tcp_init_cwnd), K_(frequent_accept), K_(enable_reuse_port), K_(net_accept_threads));
   J_COMMA();
   J_KV(K_(short_async_task_timeout), K_(short_async_task_timeout), K_(min_congested_connect_timeout),
        K_(tenant_location_valid_time), K_(local_bound_ip), K_(listen_port), K_(rpc_listen_port), K_(stack_size), K_(work_thread_num),
@@ -352,7 +364,9 @@ DEF_TO_STRING(ObMysqlConfigParams)
        K_(enable_reroute), K_(enable_weak_reroute), K_(enable_index_route), K_(enable_causal_order_read),
        K_(ip_listen_mode));
   J_COMMA();
-  J_KV(K_(local_bound_ipv6_ip), K_(read_stale_retry_interval), K_(ob_max_read_stale_time));
+  J_KV(K_(local_bound_ipv6_ip), K_(read_stale_retry_interval), K_(ob_max_read_stale_time),
+       K_(enable_coalesced_wakeup), K_(enable_work_stealing), K_(enable_io_buffer_slab),
+       K_(io_buffer_slab_numa_local), K_(io_buffer_slab_huge_page));
   J_COMMA();
   J_OBJ_END();
   return pos;
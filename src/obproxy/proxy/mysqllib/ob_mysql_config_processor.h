@@ -88,6 +88,7 @@ public:
   CfgInt client_sock_option_flag_out_;
 
   CfgBool frequent_accept_;
+  CfgBool enable_reuse_port_;
   CfgInt net_accept_threads_;
   CfgTime default_inactivity_timeout_;
   CfgTime observer_query_timeout_delta_;
@@ -149,6 +150,11 @@ public:
   CfgInt proxy_id_;
   CfgInt client_max_memory_size_;
   CfgBool enable_cpu_isolate_;
+  CfgBool enable_coalesced_wakeup_;
+  CfgBool enable_work_stealing_;
+  CfgBool enable_io_buffer_slab_;
+  CfgBool io_buffer_slab_numa_local_;
+  CfgBool io_buffer_slab_huge_page_;
   CfgBool enable_primary_zone_;
   CfgInt ip_listen_mode_;
   CfgIp local_bound_ipv6_ip_;
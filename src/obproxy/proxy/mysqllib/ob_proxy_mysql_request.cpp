@@ -16,6 +16,7 @@
 #include "proxy/mysqllib/ob_proxy_mysql_request.h"
 #include "obproxy/cmd/ob_internal_cmd_processor.h"
 #include "obproxy/utils/ob_proxy_privilege_check.h"
+#include "obutils/ob_proxy_config.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::sql;
@@ -91,10 +92,12 @@ int ObProxyMysqlRequest::add_request(event::ObIOBufferReader *reader, const int6
     } else {
       // OB_MYSQL_COM_STMT_CLOSE/OB_MYSQL_COM_STMT_SEND_LONG_DATA always followed other request
       // mysql req in ob20 payload, always followed by crc or other mysql req
+      // pipelined requests may follow any request
       LOG_DEBUG("add request before", K(total_len), K(meta_), K(is_mysql_req_in_ob20_payload()));
       if (total_len > meta_.pkt_len_
           && (is_mysql_req_in_ob20_payload()
-              || OB_UNLIKELY(OB_MYSQL_COM_STMT_CLOSE == meta_.cmd_ || OB_MYSQL_COM_STMT_SEND_LONG_DATA == meta_.cmd_))) {
+              || OB_UNLIKELY(OB_MYSQL_COM_STMT_CLOSE == meta_.cmd_ || OB_MYSQL_COM_STMT_SEND_LONG_DATA == meta_.cmd_)
+              || obutils::get_global_proxy_config().enable_client_request_pipelining)) {
         total_len = meta_.pkt_len_;
       }
 
@@ -38,7 +38,7 @@ namespace proxy
 {
 const int64_t SESSION_ITEM_NUM = 256;
 ObServerSessionInfo::ObServerSessionInfo() :
-    cap_(0), compatible_capability_(0), checksum_switch_(CHECKSUM_ON), is_inited_(false),
+    val_hash_version_(-1), cap_(0), compatible_capability_(0), checksum_switch_(CHECKSUM_ON), is_inited_(false),
     is_sharding_txn_session_(false), is_lock_session_(false), server_type_(DB_OB_MYSQL), shard_conn_(NULL),
     ps_id_(0), ps_id_pair_map_(), cursor_id_pair_map_(), allocator_(), text_ps_version_set_()
 {
@@ -122,6 +122,8 @@ void ObServerSessionInfo::reset()
   destroy_cursor_id_pair_map();
   ob_server_.reset();
   version_.reset();
+  val_hash_version_ = -1;
+  vars_image_.reset();
   cap_ = 0;
   compatible_capability_.capability_ = 0;
   checksum_switch_ = CHECKSUM_ON;
@@ -242,6 +244,7 @@ ObClientSessionInfo::ObClientSessionInfo()
       obproxy_force_parallel_query_dop_(1), ob_max_read_stale_time_(-1), last_server_addr_(),
       last_server_sess_id_(0), sync_conf_sys_var_(false), init_sql_()
 {
+  vars_image_version_ = -1;
   // const int BUCKET_SIZE = 8;
   is_session_pool_client_ = true;
   MEMSET(scramble_buf_, 0, sizeof(scramble_buf_));
@@ -1043,6 +1046,87 @@ int ObClientSessionInfo::extract_user_variable_reset_sql(ObServerSessionInfo &se
   return ret;
 }
 
+int ObClientSessionInfo::calc_changed_val_hash()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WDIAG("client session is not inited", K(ret));
+  } else {
+    if (OB_SUCC(ret) && is_common_hot_sys_version_changed()) {
+      if (OB_FAIL(field_mgr_.calc_common_hot_sys_var_hash(val_hash_.common_hot_sys_var_hash_))) {
+        LOG_WDIAG("fail to calc_common_hot_sys_var_hash", K(ret));
+      } else {
+        hash_version_.common_hot_sys_var_version_ = version_.common_hot_sys_var_version_;
+      }
+    }
+    if (OB_SUCC(ret) && is_common_cold_sys_version_changed()) {
+      if (OB_FAIL(field_mgr_.calc_common_cold_sys_var_hash(val_hash_.common_cold_sys_var_hash_))) {
+        LOG_WDIAG("fail to calc_common_cold_sys_var_hash", K(ret));
+      } else {
+        hash_version_.common_sys_var_version_ = version_.common_sys_var_version_;
+      }
+    }
+    if (is_oceanbase_server()) {
+      if (OB_SUCC(ret) && is_sys_hot_version_changed()) {
+        if (OB_FAIL(field_mgr_.calc_hot_sys_var_hash(val_hash_.hot_sys_var_hash_))) {
+          LOG_WDIAG("fail to calc_hot_sys_var_hash", K(ret));
+        } else {
+          hash_version_.hot_sys_var_version_ = version_.hot_sys_var_version_;
+        }
+      }
+      if (OB_SUCC(ret) && is_sys_cold_version_changed()) {
+        if (OB_FAIL(field_mgr_.calc_cold_sys_var_hash(val_hash_.cold_sys_var_hash_))) {
+          LOG_WDIAG("fail to calc_cold_sys_var_hash", K(ret));
+        } else {
+          hash_version_.sys_var_version_ = version_.sys_var_version_;
+        }
+      }
+    } else {
+      if (OB_SUCC(ret) && is_mysql_hot_sys_version_changed()) {
+        if (OB_FAIL(field_mgr_.calc_mysql_hot_sys_var_hash(val_hash_.mysql_hot_sys_var_hash_))) {
+          LOG_WDIAG("fail to calc_mysql_hot_sys_var_hash", K(ret));
+        } else {
+          hash_version_.mysql_hot_sys_var_version_ = version_.mysql_hot_sys_var_version_;
+        }
+      }
+      if (OB_SUCC(ret) && is_mysql_cold_sys_version_changed()) {
+        if (OB_FAIL(field_mgr_.calc_mysql_cold_sys_var_hash(val_hash_.mysql_cold_sys_var_hash_))) {
+          LOG_WDIAG("fail to calc_mysql_cold_sys_var_hash", K(ret));
+        } else {
+          hash_version_.mysql_sys_var_version_ = version_.mysql_sys_var_version_;
+        }
+      }
+    }
+    if (OB_SUCC(ret) && is_user_var_version_changed()) {
+      if (OB_FAIL(field_mgr_.calc_user_var_hash(val_hash_.user_var_hash_))) {
+        LOG_WDIAG("fail to calc_user_var_hash", K(ret));
+      } else {
+        hash_version_.user_var_version_ = version_.user_var_version_;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObClientSessionInfo::calc_session_vars_image()
+{
+  int ret = OB_SUCCESS;
+  const int64_t version = version_.get_vars_version_sum();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WDIAG("client session is not inited", K(ret));
+  } else if (vars_image_version_ != version) {
+    vars_image_version_ = -1;
+    if (OB_FAIL(field_mgr_.get_session_vars_image(vars_image_))) {
+      LOG_WDIAG("fail to get session vars image", K(ret));
+    } else {
+      vars_image_version_ = version;
+    }
+  }
+  return ret;
+}
+
 int ObClientSessionInfo::extract_variable_reset_sql(ObServerSessionInfo &server_info,
                                                     ObSqlString &sql)
 {
@@ -1421,6 +1505,8 @@ void ObClientSessionInfo::destroy()
   ob_max_read_stale_time_ = 0;
 
   global_vars_version_ = OB_INVALID_VERSION;
+  vars_image_.reset();
+  vars_image_version_ = -1;
   obproxy_route_addr_ = 0;
   safe_read_snapshot_ = 0;
   syncing_safe_read_snapshot_ = 0;
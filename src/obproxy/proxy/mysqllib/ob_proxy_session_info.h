@@ -117,6 +117,13 @@ public:
   void inc_db_name_version() { db_name_version_++; }
   void inc_last_insert_id_version() { last_insert_id_version_++; }
   void inc_sess_info_version() { sess_info_version_++; }
+  // every change of a session var category raises its version, so the sum
+  // changes whenever any of them changes
+  int64_t get_vars_version_sum() const
+  {
+    return common_hot_sys_var_version_ + common_sys_var_version_ + mysql_hot_sys_var_version_
+           + mysql_sys_var_version_ + hot_sys_var_version_ + sys_var_version_ + user_var_version_;
+  }
 
   TO_STRING_KV(K_(common_hot_sys_var_version), K_(common_sys_var_version),
                K_(mysql_hot_sys_var_version), K_(mysql_sys_var_version),
@@ -157,6 +164,18 @@ public:
   ObSessionVarValHash() { reset(); }
   ~ObSessionVarValHash() { reset(); }
   void reset() { memset(this, 0, sizeof(ObSessionVarValHash)); }
+  void assign(const ObSessionVarValHash &other) { MEMCPY(this, &other, sizeof(ObSessionVarValHash)); }
+  bool equal(const ObSessionVarValHash &other) const
+  {
+    return 0 == memcmp(this, &other, sizeof(ObSessionVarValHash));
+  }
+  // summary of the synced session state, only used to pick a pooled server session
+  // which probably needs no sync. the need_reset_* checks are still authoritative
+  uint64_t get_fingerprint(const common::ObString &database_name) const
+  {
+    return common::murmurhash(this, sizeof(ObSessionVarValHash),
+                              common::murmurhash(database_name.ptr(), database_name.length(), 0));
+  }
   TO_STRING_KV(K_(common_hot_sys_var_hash), K_(common_cold_sys_var_hash),
                K_(mysql_hot_sys_var_hash), K_(mysql_cold_sys_var_hash),
                K_(hot_sys_var_hash), K_(cold_sys_var_hash), K_(user_var_hash));
@@ -324,6 +343,7 @@ public:
   int set_database_name(const common::ObString &database_name, const bool is_string_to_lower_case);
   int remove_database_name() { return field_mgr_.remove_database_name(); }
   ObString get_database_name() const;
+  uint64_t get_session_vars_fingerprint() const { return val_hash_.get_fingerprint(get_database_name()); }
   void set_server_type(DBServerType server_type) { server_type_ = server_type; }
   DBServerType get_server_type() const { return server_type_; }
   bool is_oceanbase_server() const { return DB_OB_MYSQL == server_type_ || DB_OB_ORACLE == server_type_; }
@@ -341,9 +361,15 @@ public:
     }
     shard_conn_ = shard_conn;
   }
+  // val_hash_ and vars_image_ are the session vars synced from a non pool client,
+  // they are only valid until the versions are changed by other ways
+  void set_val_hash_synced() { val_hash_version_ = version_.get_vars_version_sum(); }
+  bool is_val_hash_synced() const { return val_hash_version_ == version_.get_vars_version_sum(); }
 public:
   ObSessionFieldMgr field_mgr_;
   ObSessionVarValHash val_hash_;
+  common::ObSqlString vars_image_;
+  int64_t val_hash_version_;
 private:
   /* server session capability, filled in negotiation */
   uint64_t cap_;
@@ -607,6 +633,7 @@ public:
   int get_vip_addr_name(common::ObString &vip_addr_name) const;
   int get_database_name(common::ObString &database_name) const;
   common::ObString get_database_name() const;
+  uint64_t get_session_vars_fingerprint() const { return val_hash_.get_fingerprint(get_database_name()); }
   common::ObString get_full_username();
   int get_user_name(common::ObString &user_name) const;
   int get_service_name(common::ObString &service_name) const;
@@ -679,6 +706,11 @@ public:
   int extract_all_variable_reset_sql(common::ObSqlString &sql);
   int extract_variable_reset_sql(ObServerSessionInfo &server_info, common::ObSqlString &sql);
   int extract_user_variable_reset_sql(ObServerSessionInfo &server_info, ObSqlString &sql);
+  // recalc the value hash of the session var categories changed since last calc
+  int calc_changed_val_hash();
+  // recalc the image of the session vars if any version changed since last calc
+  int calc_session_vars_image();
+  common::ObString get_session_vars_image() const { return vars_image_.string(); }
   int extract_oceanbase_variable_reset_sql(ObServerSessionInfo &server_info,
                                            common::ObSqlString &sql, bool &need_reset);
   int extract_mysql_variable_reset_sql(ObServerSessionInfo &server_info,
@@ -1058,6 +1090,8 @@ public:
   ObSessionFieldMgr field_mgr_;
   ObSessionVarVersion hash_version_;
   ObSessionVarValHash val_hash_;
+  common::ObSqlString vars_image_;
+  int64_t vars_image_version_;
   ObProxyObProto20Request ob20_request_;  // handle ob v2.0 protocol request info from client
   bool is_session_pool_client_; // used for ObMysqlClient
   uint32_t lock_session_num_; // used for table lock/lock function route
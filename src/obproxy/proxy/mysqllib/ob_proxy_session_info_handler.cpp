@@ -26,6 +26,7 @@
 #include "proxy/mysqllib/ob_2_0_protocol_struct.h"
 #include "proxy/mysqllib/ob_2_0_protocol_utils.h"
 #include "proxy/mysql/ob_mysql_client_session.h"
+#include "proxy/mysql/ob_mysql_login_verifier_cache.h"
 #include "lib/container/ob_se_array.h"
 
 using namespace oceanbase::common;
@@ -876,6 +877,8 @@ inline int ObProxySessionInfoHandler::handle_user_privilege_var(
                  K(user_priv_set), K(ret));
       } else {
         client_info.set_user_priv_set(user_priv_set);
+        // the login verifier of lazy login keeps the privilege of last login, drop it if changed
+        get_global_login_verifier_cache().check_user_priv_set(client_info, user_priv_set);
         LOG_DEBUG("succ to update proxy user privilege", K(user_priv_set));
       }
     }
@@ -1448,10 +1451,55 @@ int ObProxySessionInfoHandler::assign_session_vars_version(
       }
     }
     LOG_DEBUG("assign_session_vars_version", K(client_val_hash), K(server_val_hash));
+  } else if (get_global_proxy_config().enable_session_vars_fingerprint) {
+    // remember the synced session vars, so the sync can be skipped if the client
+    // comes back with exactly the same values
+    if (OB_FAIL(client_info.calc_changed_val_hash())) {
+      LOG_WDIAG("fail to calc changed val hash", K(ret));
+    } else if (OB_FAIL(client_info.calc_session_vars_image())) {
+      LOG_WDIAG("fail to calc session vars image", K(ret));
+    } else if (OB_FAIL(server_info.vars_image_.assign(client_info.get_session_vars_image()))) {
+      LOG_WDIAG("fail to assign session vars image", K(ret));
+    } else {
+      server_info.val_hash_.assign(client_info.val_hash_);
+      server_info.set_val_hash_synced();
+    }
+    if (OB_FAIL(ret)) {
+      server_info.val_hash_version_ = -1;
+    }
   }
   return ret;
 }
 
+bool ObProxySessionInfoHandler::skip_session_vars_sync_if_same(
+    ObClientSessionInfo &client_info,
+    ObServerSessionInfo &server_info)
+{
+  int ret = OB_SUCCESS;
+  bool bret = false;
+  // the versions only tell the server session missed some changes, but the values
+  // may be the same, e.g. a var is set and set back, or another server session
+  // of the client has run the changes
+  if (!client_info.is_session_pool_client_
+      && get_global_proxy_config().enable_session_vars_fingerprint
+      && server_info.is_val_hash_synced()
+      && client_info.get_session_version().get_vars_version_sum()
+         != server_info.get_session_var_version().get_vars_version_sum()) {
+    // the val hashes compare strings case insensitively, so compare the exact values
+    if (OB_FAIL(client_info.calc_session_vars_image())) {
+      LOG_WDIAG("fail to calc session vars image", K(ret));
+    } else if (client_info.get_session_vars_image() == server_info.vars_image_.string()) {
+      if (OB_FAIL(assign_session_vars_version(client_info, server_info))) {
+        LOG_WDIAG("fail to assign session vars version", K(ret));
+      } else {
+        bret = true;
+        LOG_DEBUG("same session vars, skip sync", "image_len", server_info.vars_image_.length());
+      }
+    }
+  }
+  return bret;
+}
+
 int ObProxySessionInfoHandler::save_changed_sess_info(ObClientSessionInfo& client_info,
     ObServerSessionInfo& server_info, Ob20ExtraInfo& extra_info, common::ObSimpleTrace<4096> &trace_log, bool is_error_packet)
 {
@@ -172,6 +172,10 @@ public:
                                             ObServerSessionInfo &server_info);
   static int assign_session_vars_version(ObClientSessionInfo &client_info,
                                          ObServerSessionInfo &server_info);
+  // return true if the server session already has the session var values of
+  // the client and the versions are assigned, so no sync is needed
+  static bool skip_session_vars_sync_if_same(ObClientSessionInfo &client_info,
+                                             ObServerSessionInfo &server_info);
 
   static int handle_capability_flag_var(ObClientSessionInfo &client_info,
                                         ObServerSessionInfo &server_info,
@@ -468,6 +468,35 @@ int ObSessionFieldMgr::calc_user_var_hash(uint64_t &hash_val)
   return calc_var_hash_common(user_first_block_, hash_val, NULL, ObString::make_string("user_var"));
 }
 
+int ObSessionFieldMgr::get_session_vars_image(ObSqlString &image)
+{
+  int ret = OB_SUCCESS;
+  std::map<std::string, std::string> vars;
+  image.reuse();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WDIAG("not inited", K(ret));
+  } else if (OB_FAIL(get_vars_image_common(common_sys_first_block_, 'c', vars))) {
+    LOG_WDIAG("fail to get common sys vars image", K(ret));
+  } else if (OB_FAIL(get_vars_image_common(mysql_sys_first_block_, 'm', vars))) {
+    LOG_WDIAG("fail to get mysql sys vars image", K(ret));
+  } else if (OB_FAIL(get_vars_image_common(sys_first_block_, 's', vars))) {
+    LOG_WDIAG("fail to get sys vars image", K(ret));
+  } else if (OB_FAIL(get_vars_image_common(user_first_block_, 'u', vars))) {
+    LOG_WDIAG("fail to get user vars image", K(ret));
+  } else {
+    for (std::map<std::string, std::string>::iterator it = vars.begin(); OB_SUCC(ret) && it != vars.end(); ++it) {
+      if (OB_FAIL(image.append_fmt("%ld:%s%ld:", static_cast<int64_t>(it->first.length()), it->first.c_str(),
+                                   static_cast<int64_t>(it->second.length())))) {
+        LOG_WDIAG("fail to append var name", K(ret));
+      } else if (OB_FAIL(image.append(it->second.data(), static_cast<int64_t>(it->second.length())))) {
+        LOG_WDIAG("fail to append var value", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSessionFieldMgr::set_sys_var_set(ObDefaultSysVarSet *set)
 {
   int ret = common::OB_SUCCESS;
@@ -384,6 +384,9 @@ public:
   int calc_hot_sys_var_hash(uint64_t &hash_val);
   int calc_cold_sys_var_hash(uint64_t &hash_val);
   int calc_user_var_hash(uint64_t &hash_val);
+  // the names and the serialized values of all local session vars, sorted by name.
+  // unlike the val hashes, two images are the same only if the values are exactly the same
+  int get_session_vars_image(common::ObSqlString &image);
   //set and get methord
   int set_cluster_name(const common::ObString &cluster_name);
   int set_tenant_name(const common::ObString &tenant_name);
@@ -604,6 +607,32 @@ private:
     return ret;
   }
 
+  template<typename T>
+  int get_vars_image_common(const T *block, const char var_type, std::map<std::string, std::string> &vars)
+  {
+    int ret = common::OB_SUCCESS;
+    const ObSessionBaseField *field = NULL;
+    for (; common::OB_SUCCESS == ret && NULL != block; block = block->next_) {
+      for (int64_t i = 0; common::OB_SUCCESS == ret && i < block->free_idx_; ++i) {
+        field = block->field_slots_ + i;
+        if (OB_FIELD_USED == field->stat_) {
+          // the same name may be both a sys var and a user var
+          std::string var_name(1, var_type);
+          var_name.append(field->name_, field->name_len_);
+          const int64_t size = field->value_.get_serialize_size();
+          std::string value(size, '\0');
+          int64_t pos = 0;
+          if (OB_FAIL(field->value_.serialize(&value[0], size, pos))) {
+            PROXY_LOG(WDIAG, "fail to serialize var value", K(field->value_), K(ret));
+          } else {
+            vars[var_name] = value;
+          }
+        }
+      }
+    }
+    return ret;
+  }
+
   template<typename T>
   int calc_var_hash_common(const T *block, uint64_t& hash_val, NeedFunc need_func, const common::ObString& session_name)
   {
@@ -291,6 +291,12 @@ int ObCacheCleaner::do_clean_job()
           LOG_WDIAG("fail to clean partition hash map", K(ret));
           ret = OB_SUCCESS; // continue
         }
+        next_action_ = REFRESH_HOT_ROUTE_ENTRY_ACTION;
+        break;
+      }
+
+      case REFRESH_HOT_ROUTE_ENTRY_ACTION: {
+        refresh_hot_route_entry();
         next_action_ = EXPIRE_INDEX_ENTRY_ACTION;
         break;
       }
@@ -761,6 +767,112 @@ int ObCacheCleaner::clean_one_sub_bucket_partition_cache(const int64_t bucket_id
   return ret;
 }
 
+bool ObCacheCleaner::is_route_entry_need_refresh(const ObRouteEntry &entry, const int64_t now_us,
+                                                 const int64_t interval_us) const
+{
+  // accessed in the last interval, and pulled from remote more than one interval ago
+  return entry.is_avail_state()
+         && (now_us - entry.get_last_access_time_us()) < interval_us
+         && (now_us - entry.get_create_time_us()) >= interval_us;
+}
+
+void ObCacheCleaner::refresh_hot_route_entry()
+{
+  int ret = OB_SUCCESS;
+  ObProxyConfig &config = get_global_proxy_config();
+  const int64_t interval_us = config.location_cache_refresh_interval;
+  int64_t refresh_count = 0;
+  if (interval_us > 0 && config.enable_async_pull_location_cache) {
+    // non-partition table keeps its leader in table entry
+    for (int64_t i = table_cache_range_.start_idx_;
+         (i <= table_cache_range_.end_idx_) && (refresh_count < MAX_REFRESH_ROUTE_ENTRY_COUNT); ++i) {
+      if (OB_FAIL(refresh_one_part_hot_table_entry(i, interval_us, refresh_count))) {
+        LOG_WDIAG("fail to refresh hot table entry", "part_idx", i, K(ret));
+        ret = OB_SUCCESS; // ignore, and continue
+      }
+    }
+    for (int64_t i = partition_cache_range_.start_idx_;
+         (i <= partition_cache_range_.end_idx_) && (refresh_count < MAX_REFRESH_ROUTE_ENTRY_COUNT); ++i) {
+      if (OB_FAIL(refresh_one_sub_bucket_hot_partition_entry(i, interval_us, refresh_count))) {
+        LOG_WDIAG("fail to refresh hot partition entry", "sub bucket idx", i, K(ret));
+        ret = OB_SUCCESS; // ignore, and continue
+      }
+    }
+    if (refresh_count > 0) {
+      LOG_INFO("succ to mark hot route entry dirty for refreshing", K(refresh_count), K(interval_us),
+               K_(this_cleaner_idx));
+    }
+  }
+}
+
+int ObCacheCleaner::refresh_one_part_hot_table_entry(const int64_t part_idx, const int64_t interval_us,
+                                                     int64_t &refresh_count)
+{
+  int ret = OB_SUCCESS;
+  int64_t mt_part_num = table_cache_->get_sub_part_count();
+  if (part_idx < 0 || part_idx >= mt_part_num) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid part idx", K(part_idx), K(mt_part_num), K(ret));
+  } else {
+    TableIter it;
+    ObTableEntry *entry = NULL;
+    const int64_t now_us = hrtime_to_usec(get_hrtime());
+    MUTEX_TRY_LOCK(lock, table_cache_->lock_for_key(part_idx), this_ethread());
+    if (!lock.is_locked()) {
+      LOG_DEBUG("fail to try lock, wait next round", K(part_idx));
+    } else if (OB_FAIL(table_cache_->run_todo_list(part_idx))) {
+      LOG_WDIAG("fail to run todo list", K(part_idx), K(ret));
+    } else {
+      entry = table_cache_->first_entry(part_idx, it);
+      while (NULL != entry && refresh_count < MAX_REFRESH_ROUTE_ENTRY_COUNT) {
+        if (entry->is_non_partition_table()
+            && !entry->is_dummy_entry()
+            && is_route_entry_need_refresh(*entry, now_us, interval_us)
+            && entry->cas_set_dirty_state()) {
+          PROCESSOR_INCREMENT_DYN_STAT(REFRESH_ROUTE_ENTRY_IN_BACKGROUND);
+          LOG_DEBUG("hot table entry will be refreshed", KPC(entry));
+          ++refresh_count;
+        }
+        entry = table_cache_->next_entry(part_idx, it);
+      }
+    }
+  }
+  return ret;
+}
+
+int ObCacheCleaner::refresh_one_sub_bucket_hot_partition_entry(const int64_t bucket_idx,
+                                                               const int64_t interval_us,
+                                                               int64_t &refresh_count)
+{
+  int ret = OB_SUCCESS;
+  int64_t bucket_num = partition_cache_->get_sub_part_count();
+  if (bucket_idx < 0 || bucket_idx >= bucket_num) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WDIAG("invalid input value", K(bucket_idx), K(bucket_num), K(ret));
+  } else {
+    PartitionIter it;
+    ObPartitionEntry *entry = NULL;
+    const int64_t now_us = hrtime_to_usec(get_hrtime());
+    MUTEX_TRY_LOCK(lock, partition_cache_->lock_for_key(bucket_idx), this_ethread());
+    if (!lock.is_locked()) {
+      LOG_DEBUG("fail to try lock, wait next round", K(bucket_idx));
+    } else if (OB_FAIL(partition_cache_->run_todo_list(bucket_idx))) {
+      LOG_WDIAG("fail to run todo list", K(bucket_idx), K(ret));
+    } else {
+      entry = partition_cache_->first_entry(bucket_idx, it);
+      while (NULL != entry && refresh_count < MAX_REFRESH_ROUTE_ENTRY_COUNT) {
+        if (is_route_entry_need_refresh(*entry, now_us, interval_us) && entry->cas_set_dirty_state()) {
+          PROCESSOR_INCREMENT_DYN_STAT(REFRESH_ROUTE_ENTRY_IN_BACKGROUND);
+          LOG_DEBUG("hot partition entry will be refreshed", KPC(entry));
+          ++refresh_count;
+        }
+        entry = partition_cache_->next_entry(bucket_idx, it);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObCacheCleaner::clean_index_cache() {
   int ret = OB_SUCCESS;
   ObCountRange &range = index_cache_range_;
@@ -948,6 +1060,9 @@ const char *ObCacheCleaner::get_cleaner_action_name(const ObCleanAction action)
     case CLEAN_THREAD_CACHE_PARTITION_ENTRY_ACTION:
       name = "CLEAN_THREAD_CACHE_PARTITION_ENTRY_ACTION";
       break;
+    case REFRESH_HOT_ROUTE_ENTRY_ACTION:
+      name = "REFRESH_HOT_ROUTE_ENTRY_ACTION";
+      break;
     case CLEAN_THREAD_CACHE_TABLE_ENTRY_ACTION:
       name = "CLEAN_THREAD_CACHE_TABLE_ENTRY_ACTION";
       break;
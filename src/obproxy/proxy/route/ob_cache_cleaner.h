@@ -81,6 +81,7 @@ class ObPartitionEntry;
 class ObRoutineEntry;
 class ObSqlTableEntry;
 class ObIndexEntry;
+class ObRouteEntry;
 // every work thread has one cache cleaner
 class ObCacheCleaner : public event::ObContinuation
 {
@@ -121,6 +122,7 @@ private:
     EXPIRE_PARTITION_ENTRY_ACTION,
     CLEAN_PARTITION_CACHE_ACTION,
     CLEAN_THREAD_CACHE_PARTITION_ENTRY_ACTION,
+    REFRESH_HOT_ROUTE_ENTRY_ACTION,
     EXPIRE_INDEX_ENTRY_ACTION,
     CLEAN_INDEX_CACHE_ACTION,
     CLEAN_THREAD_CACHE_INDEX_ENTRY_ACTION,
@@ -155,6 +157,15 @@ private:
   int do_expire_partition_entry();
   int clean_partition_cache();
   int clean_one_sub_bucket_partition_cache(const int64_t bucket_idx, const int64_t clean_count);
+  // mark the hot and old route entries dirty, so they are pulled in background
+  // (enable_async_pull_location_cache) before the leader change makes requests miss
+  void refresh_hot_route_entry();
+  bool is_route_entry_need_refresh(const ObRouteEntry &entry, const int64_t now_us,
+                                   const int64_t interval_us) const;
+  int refresh_one_part_hot_table_entry(const int64_t part_idx, const int64_t interval_us,
+                                       int64_t &refresh_count);
+  int refresh_one_sub_bucket_hot_partition_entry(const int64_t bucket_idx, const int64_t interval_us,
+                                                 int64_t &refresh_count);
 
   int do_expire_index_entry();
   int clean_index_cache();
@@ -182,6 +193,8 @@ private:
   const static int64_t PART_SQL_TABLE_ENTRY_MIN_COUNT = 10;
 
   const static int64_t MAX_COLSE_CLIENT_SESSION_RETYR_TIME = 5;
+  // the max count of route entries one cleaner refreshes in one round
+  const static int64_t MAX_REFRESH_ROUTE_ENTRY_COUNT = 128;
 
   bool is_inited_;
   bool triggered_;
@@ -14,6 +14,7 @@
 
 #include "proxy/route/ob_partition_cache.h"
 #include "stat/ob_processor_stats.h"
+#include "proxy/mysql/ob_mysql_global_session_manager.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::obproxy::event;
@@ -25,6 +26,30 @@ namespace obproxy
 {
 namespace proxy
 {
+// the traffic of this partition is going to move to the new leader, let the
+// session pool prewarm it before the first request pays the handshake
+static void push_leader_switch_job(const ObPartitionEntry &old_entry, const ObPartitionEntry &new_entry)
+{
+  const ObProxyReplicaLocation *old_leader = NULL;
+  const ObProxyReplicaLocation *new_leader = NULL;
+  ObLeaderSwitchInfo *leader_switch_info = NULL;
+  if (get_global_proxy_config().is_pool_mode
+      && get_global_proxy_config().enable_server_conn_prewarm
+      && NULL != (old_leader = old_entry.get_leader_replica())
+      && NULL != (new_leader = new_entry.get_leader_replica())
+      && old_leader->server_ != new_leader->server_) {
+    if (OB_ISNULL(leader_switch_info = op_alloc(ObLeaderSwitchInfo))) {
+      LOG_WDIAG("fail to alloc ObLeaderSwitchInfo", "old_leader", old_leader->server_,
+                "new_leader", new_leader->server_);
+    } else {
+      leader_switch_info->old_leader_ = old_leader->server_;
+      leader_switch_info->new_leader_ = new_leader->server_;
+      get_global_leader_switch_job_list().push(leader_switch_info);
+      LOG_DEBUG("partition leader switched", KPC(leader_switch_info), "key", new_entry.get_key());
+    }
+  }
+}
+
 //---------------------------ObPartitionCacheCont----------------------//
 class ObPartitionCacheCont : public event::ObContinuation
 {
@@ -378,6 +403,7 @@ int ObPartitionCache::add_partition_entry(ObPartitionEntry &entry, bool direct_a
         } else {
           ObPartitionEntry *tmp_entry = insert_entry(hash, key, &entry);
           if (NULL != tmp_entry) {
+            push_leader_switch_job(*tmp_entry, entry);
             tmp_entry->set_deleted_state(); // used to update tc_partition_map
             tmp_entry->dec_ref();
             tmp_entry = NULL;
@@ -501,6 +527,9 @@ int ObPartitionCache::process(const int64_t buck_id, ObPartitionCacheParam *para
       case ObPartitionCacheParam::ADD_PARTITION_OP: {
         entry = insert_entry(param->hash_, param->key_, param->entry_);
         if (NULL != entry) {
+          if (NULL != param->entry_) {
+            push_leader_switch_job(*entry, *param->entry_);
+          }
           entry->set_deleted_state(); // used to update tc_partition_map
           entry->dec_ref(); // free old entry
           entry = NULL;
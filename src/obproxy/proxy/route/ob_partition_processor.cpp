@@ -513,7 +513,14 @@ int ObPartitionEntryCont::handle_lookup_cache_done()
   } else if (gcached_entry_->is_need_update()) {
     // double check
     if (gcached_entry_->cas_compare_and_swap_state(ObRouteEntry::DIRTY, ObRouteEntry::UPDATING)) {
-      if (get_pl_task_flow_controller().can_deliver_task()) {
+      if (get_global_proxy_config().rpc_enable_async_pull_batch_tablets
+          && param_.get_table_entry()->is_remote_fetching_tablet_id(param_.partition_id_)) {
+        // another cont is fetching it in batch, the new entry will be added to cache by it,
+        // so just use the old one and set back to dirty in case that batch fetch fails
+        PROCESSOR_INCREMENT_DYN_STAT(PARTITION_ENTRY_REMOTE_FETCH_SAVED);
+        LOG_DEBUG("this entry is being fetched in batch, no need to fetch again", KPC_(gcached_entry));
+        gcached_entry_->set_dirty_state();
+      } else if (get_pl_task_flow_controller().can_deliver_task()) {
         PROCESSOR_INCREMENT_DYN_STAT(GET_PARTITION_ENTRY_FROM_GLOBAL_CACHE_DIRTY);
         LOG_INFO("this entry is dirty and need to update", KPC_(gcached_entry));
         need_notify_caller = false;
@@ -744,6 +751,7 @@ int ObPartitionEntryCont::lookup_batch_entry_remote(bool first_fetch)
         LOG_WDIAG("fail to nonblock read", K(sql), K_(param), K(ret));
       } else {
         is_batch_fetching_ = true;
+        PROCESSOR_SUM_DYN_STAT(PARTITION_ENTRY_REMOTE_FETCH_SAVED, partition_ids_.count() - 1);
       }
     }
   }
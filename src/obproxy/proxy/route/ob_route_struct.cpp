@@ -97,20 +97,30 @@ int64_t ObProxyReplicaLocation::to_string(char *buf, const int64_t buf_len) cons
 
 int ObProxyPartitionLocation::set_replicas(const common::ObIArray<ObProxyReplicaLocation> &replicas)
 {
-  int ret = OB_SUCCESS;
   //NOTE::leader must put into the first sit
-  if (!replicas.empty()) {
-    const int64_t alloc_size = static_cast<int64_t>(sizeof(ObProxyReplicaLocation)) * replicas.count();
-    if (replica_count_ == replicas.count()) {
-      MEMCPY(replicas_, &(replicas.at(0)), alloc_size);
-    } else {
+  return set_replicas(replicas.empty() ? NULL : &(replicas.at(0)), replicas.count());
+}
+
+int ObProxyPartitionLocation::set_replicas(const ObProxyReplicaLocation *replicas, const int64_t replica_count)
+{
+  int ret = OB_SUCCESS;
+  if (NULL != replicas && replica_count > 0) {
+    const int64_t alloc_size = static_cast<int64_t>(sizeof(ObProxyReplicaLocation)) * replica_count;
+    if (replica_count_ != replica_count) {
       destory();
-      if (OB_ISNULL(replicas_ = static_cast<ObProxyReplicaLocation *>(op_fixed_mem_alloc(alloc_size)))) {
+      if (replica_count <= INLINE_REPLICA_COUNT) {
+        replicas_ = reinterpret_cast<ObProxyReplicaLocation *>(inline_replicas_buf_);
+      } else if (OB_ISNULL(replicas_ = static_cast<ObProxyReplicaLocation *>(op_fixed_mem_alloc(alloc_size)))) {
         ret = OB_ALLOCATE_MEMORY_FAILED;
         LOG_WDIAG("fail to alloc mem", K(alloc_size), K(ret));
-      } else {
-        MEMCPY(replicas_, &(replicas.at(0)), alloc_size);
-        replica_count_ = replicas.count();
+      }
+    }
+    if (OB_SUCC(ret)) {
+      MEMCPY(replicas_, replicas, alloc_size);
+      replica_count_ = replica_count;
+      all_server_hash_ = 0;
+      for (int64_t i = 0; i < replica_count_; ++i) {
+        all_server_hash_ += replicas_[i].server_.hash();
       }
     }
   } else {
@@ -123,17 +133,8 @@ ObProxyPartitionLocation &ObProxyPartitionLocation::operator=(const ObProxyParti
 {
   if (this != &other) {
     if (other.is_valid()) {
-      const int64_t alloc_size = static_cast<int64_t>(sizeof(ObProxyReplicaLocation)) * other.replica_count();
-      if (replica_count_ == other.replica_count()) {
-        MEMCPY(replicas_, other.replicas_, alloc_size);
-      } else {
-        destory();
-        if (OB_ISNULL(replicas_ = static_cast<ObProxyReplicaLocation *>(op_fixed_mem_alloc(alloc_size)))) {
-          LOG_WDIAG("fail to alloc mem", K(alloc_size));
-        } else {
-          MEMCPY(replicas_, other.replicas_ , alloc_size);
-          replica_count_ = other.replica_count();
-        }
+      if (OB_SUCCESS != set_replicas(other.replicas_, other.replica_count())) {
+        LOG_WDIAG("fail to copy replicas", "replica_count", other.replica_count());
       }
     } else {
       destory();
@@ -177,11 +178,12 @@ bool ObProxyPartitionLocation::check_and_update_server_changed(ObProxyPartitionL
 
 void ObProxyPartitionLocation::destory()
 {
-  if (NULL != replicas_ && replica_count_ > 0) {
+  if (NULL != replicas_ && replica_count_ > 0 && !is_inline_replicas()) {
     op_fixed_mem_free(replicas_, static_cast<int64_t>(sizeof(ObProxyReplicaLocation)) * replica_count_);
   }
   replicas_ = NULL;
   replica_count_ = 0;
+  all_server_hash_ = 0;
 }
 
 int64_t ObProxyPartitionLocation::to_string(char *buf, const int64_t buf_len) const
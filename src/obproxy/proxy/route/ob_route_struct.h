@@ -306,8 +306,11 @@ class ObProxyPartitionLocation
 {
 public:
   static const int64_t OB_PROXY_REPLICA_COUNT = common::OB_MAX_MEMBER_NUMBER;
+  // most partitions have three replicas, keep them inside the location to save
+  // an allocation and a pointer jump on every route
+  static const int64_t INLINE_REPLICA_COUNT = 3;
 
-  ObProxyPartitionLocation() : replica_count_(0), replicas_(NULL), is_server_changed_(false) {}
+  ObProxyPartitionLocation() : replica_count_(0), replicas_(NULL), all_server_hash_(0), is_server_changed_(false) {}
   ObProxyPartitionLocation(const ObProxyPartitionLocation &other);
   ~ObProxyPartitionLocation() { destory(); }
   void destory();
@@ -327,9 +330,17 @@ public:
   ObProxyPartitionLocation &operator=(const ObProxyPartitionLocation &other);
   int64_t to_string(char *buf, const int64_t buf_len) const;
 private:
+  int set_replicas(const ObProxyReplicaLocation *replicas, const int64_t replica_count);
+  bool is_inline_replicas() const
+  {
+    return replicas_ == reinterpret_cast<const ObProxyReplicaLocation *>(inline_replicas_buf_);
+  }
+
   int64_t replica_count_;
   ObProxyReplicaLocation *replicas_;
+  uint64_t all_server_hash_;
   bool is_server_changed_;
+  int64_t inline_replicas_buf_[(INLINE_REPLICA_COUNT * sizeof(ObProxyReplicaLocation) + sizeof(int64_t) - 1) / sizeof(int64_t)];
 };
 
 inline bool ObProxyPartitionLocation::exist_leader() const
@@ -365,19 +376,14 @@ inline ObProxyReplicaLocation *ObProxyPartitionLocation::get_replica(const int64
   return replica;
 }
 
-//do no care the order
+//do no care the order, computed when replicas are set
 inline uint64_t ObProxyPartitionLocation::get_all_server_hash() const
 {
-  uint64_t hash = 0;
-  if (is_valid()) {
-    for (int64_t i = 0; i < replica_count_; ++i) {
-      hash += replicas_[i].server_.hash();
-    }
-  }
-  return hash;
+  return is_valid() ? all_server_hash_ : 0;
 }
 
 inline ObProxyPartitionLocation::ObProxyPartitionLocation(const ObProxyPartitionLocation &other)
+  : replica_count_(0), replicas_(NULL), all_server_hash_(0), is_server_changed_(false)
 {
   *this = other;
 }
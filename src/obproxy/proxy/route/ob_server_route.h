@@ -659,11 +659,6 @@ inline bool ObServerRoute::set_target_dirty(bool is_need_force_flush /*false*/)
         && table_entry_->need_update_entry()
         && table_entry_->cas_set_dirty_state()) {
       table_entry_->set_need_force_flush(is_need_force_flush);
-      if (obutils::get_global_proxy_config().enable_async_pull_location_cache
-            && obutils::get_global_proxy_config().rpc_enable_async_pull_batch_tablets) {
-        //put it first, no care about that put it to batch set or not, we just try it, not to care about return value
-        table_entry_->put_batch_fetch_tablet_id(part_entry_->get_partition_id());
-      }
       bret = true;
       PROXY_LOG(INFO, "this table entry will set to dirty and wait for update", K(is_need_force_flush), KPC_(table_entry));
     }
@@ -672,6 +667,11 @@ inline bool ObServerRoute::set_target_dirty(bool is_need_force_flush /*false*/)
         && part_entry_->need_update_entry()
         && part_entry_->cas_set_dirty_state()) {
       table_entry_->set_need_force_flush(is_need_force_flush);
+      if (obutils::get_global_proxy_config().enable_async_pull_location_cache
+            && obutils::get_global_proxy_config().rpc_enable_async_pull_batch_tablets) {
+        //put it first, no care about that put it to batch set or not, we just try it, not to care about return value
+        table_entry_->put_batch_fetch_tablet_id(part_entry_->get_partition_id());
+      }
       bret = true;
       PROXY_LOG(INFO, "this partition entry will set to dirty and wait for update", K(is_need_force_flush), KPC_(table_entry), KPC_(part_entry));
     }
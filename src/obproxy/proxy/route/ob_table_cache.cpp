@@ -224,7 +224,8 @@ int ObTableCache::init(const int64_t bucket_size)
   } else if (OB_UNLIKELY(bucket_size <= 0 || sub_bucket_size <= 0)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WDIAG("invalid input value", K(bucket_size), K(sub_bucket_size), K(ret));
-  } else if (OB_FAIL(TableEntryHashMap::init(sub_bucket_size, TABLE_ENTRY_MAP_LOCK, gc_table_entry))) {
+  } else if (OB_FAIL(TableEntryHashMap::init(sub_bucket_size, TABLE_ENTRY_MAP_LOCK,
+                                                 gc_table_entry, NULL, true))) {
     LOG_WDIAG("fail to init hash table of table cache", K(sub_bucket_size), K(ret));
   } else {
     for (int64_t i = 0; i < MT_HASHTABLE_PARTITIONS; ++i) {
@@ -275,62 +276,67 @@ int ObTableCache::get_table_entry(
     uint64_t hash = key.hash();
     LOG_DEBUG("begin to get table location entry", K(ppentry), K(key), K(cont), K(hash));
 
-    ObProxyMutex *bucket_mutex = lock_for_key(hash);
-    MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
-    if (lock_bucket.is_locked()) {
-      if (OB_FAIL(run_todo_list(part_num(hash)))) {
-        LOG_WDIAG("fail to run todo list", K(ret));
-      } else {
-        *ppentry = lookup_entry(hash, key);
-        if (NULL != *ppentry) {
-          if (is_table_entry_expired(**ppentry)) {
-            // expire time mismatch
-            LOG_DEBUG("the table entry is expired", "expire_time_us",
-                      get_cache_expire_time_us(), KPC(*ppentry));
-            *ppentry = NULL;
-            // remove the expired table entry in locked
-            if (OB_FAIL(remove_table_entry(key))) {
-              LOG_WDIAG("fail to remove table entry", K(key), K(ret));
+    if (get_global_proxy_config().enable_lock_free_table_cache_read
+        && lock_free_get_table_entry(key, hash, *ppentry)) {
+      LOG_DEBUG("get_table_entry, entry found succ without lock", KPC(*ppentry));
+    } else {
+      ObProxyMutex *bucket_mutex = lock_for_key(hash);
+      MUTEX_TRY_LOCK(lock_bucket, bucket_mutex, this_ethread());
+      if (lock_bucket.is_locked()) {
+        if (OB_FAIL(run_todo_list(part_num(hash)))) {
+          LOG_WDIAG("fail to run todo list", K(ret));
+        } else {
+          *ppentry = lookup_entry(hash, key);
+          if (NULL != *ppentry) {
+            if (is_table_entry_expired(**ppentry)) {
+              // expire time mismatch
+              LOG_DEBUG("the table entry is expired", "expire_time_us",
+                        get_cache_expire_time_us(), KPC(*ppentry));
+              *ppentry = NULL;
+              // remove the expired table entry in locked
+              if (OB_FAIL(remove_table_entry(key))) {
+                LOG_WDIAG("fail to remove table entry", K(key), K(ret));
+              }
+            } else {
+              (*ppentry)->inc_ref();
+              LOG_DEBUG("get_table_entry, entry found succ", KPC(*ppentry));
             }
           } else {
-            (*ppentry)->inc_ref();
-            LOG_DEBUG("get_table_entry, entry found succ", KPC(*ppentry));
+            // non-existent, return NULL
+            LOG_DEBUG("get_table_entry, entry not found", K(key));
           }
-        } else {
-          // non-existent, return NULL
-          LOG_DEBUG("get_table_entry, entry not found", K(key));
         }
-      }
-    } else {
-      LOG_DEBUG("get_table_entry, trylock failed, reschedule cont interval(ns)",
-                LITERAL_K(ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL));
-      ObTableCacheCont *table_cont = NULL;
-      if (OB_ISNULL(table_cont = op_alloc_args(ObTableCacheCont, *this))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_EDIAG("fail to allocate memory for table cache continuation", K(ret));
-      } else if (OB_FAIL(ObTableEntry::alloc_and_init_table_entry(*key.name_, key.cr_version_,
-          key.cr_id_, table_cont->buf_entry_))) { // use to save name buf
-        LOG_WDIAG("fail to alloc and init pl entry", K(key), K(ret));
       } else {
-        table_cont->buf_entry_->get_key(table_cont->key_);
-        table_cont->action_.set_continuation(cont);
-        table_cont->mutex_ = cont->mutex_;
-        table_cont->hash_ = hash;
-        table_cont->ppentry_ = ppentry;
-
-        SET_CONTINUATION_HANDLER(table_cont, &ObTableCacheCont::get_table_entry);
-        if (OB_ISNULL(cont->mutex_->thread_holding_)
-            || OB_ISNULL(cont->mutex_->thread_holding_->schedule_in(table_cont,
-                ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL))) {
-          ret = OB_ERR_UNEXPECTED;
-          LOG_WDIAG("fail to schedule imm", K(table_cont), K(ret));
+        LOG_DEBUG("get_table_entry, trylock failed, reschedule cont interval(ns)",
+                  LITERAL_K(ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL));
+        ObTableCacheCont *table_cont = NULL;
+        if (OB_ISNULL(table_cont = op_alloc_args(ObTableCacheCont, *this))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_EDIAG("fail to allocate memory for table cache continuation", K(ret));
+        } else if (OB_FAIL(ObTableEntry::alloc_and_init_table_entry(*key.name_, key.cr_version_,
+            key.cr_id_, table_cont->buf_entry_))) { // use to save name buf
+          LOG_WDIAG("fail to alloc and init pl entry", K(key), K(ret));
         } else {
-          action = &table_cont->action_;
+          table_cont->buf_entry_->get_key(table_cont->key_);
+          table_cont->action_.set_continuation(cont);
+          table_cont->mutex_ = cont->mutex_;
+          table_cont->hash_ = hash;
+          table_cont->ppentry_ = ppentry;
+
+          SET_CONTINUATION_HANDLER(table_cont, &ObTableCacheCont::get_table_entry);
+          if (OB_ISNULL(cont->mutex_->thread_holding_)
+              || OB_ISNULL(cont->mutex_->thread_holding_->schedule_in(table_cont,
+                  ObTableParam::SCHEDULE_TABLE_CACHE_CONT_INTERVAL))) {
+            ret = OB_ERR_UNEXPECTED;
+            LOG_WDIAG("fail to schedule imm", K(table_cont), K(ret));
+          } else {
+            action = &table_cont->action_;
+          }
+        }
+        if (OB_FAIL(ret) && OB_LIKELY(NULL != table_cont)) {
+          table_cont->destroy();
+          table_cont = NULL;
         }
-      }
-      if (OB_FAIL(ret) && OB_LIKELY(NULL != table_cont)) {
-        table_cont->destroy();
-        table_cont = NULL;
       }
     }
     if (OB_FAIL(ret)) {
@@ -340,6 +346,38 @@ int ObTableCache::get_table_entry(
   return ret;
 }
 
+bool ObTableCache::lock_free_get_table_entry(const ObTableEntryKey &key, const uint64_t hash,
+                                             ObTableEntry *&entry)
+{
+  bool bret = false;
+  entry = NULL;
+  // the pending ops in todo list are only visible to the locked lookup
+  if (todo_lists_[part_num(hash)].empty()) {
+    ObMTHashTableReclaimer::ReadGuard guard;
+    ObTableEntry *tmp_entry = lock_free_lookup_entry(hash, key);
+    if (NULL != tmp_entry && tmp_entry->try_inc_ref()) {
+      // the entry found may have been replaced or removed before it is pinned,
+      // only return the live one, as the locked lookup does
+      if (tmp_entry == lock_free_lookup_entry(hash, key) && !tmp_entry->is_deleted_state()) {
+        entry = tmp_entry;
+      } else {
+        tmp_entry->dec_ref();
+      }
+    }
+  }
+
+  if (NULL != entry) {
+    if (is_table_entry_expired(*entry)) {
+      // let the locked lookup remove it
+      entry->dec_ref();
+      entry = NULL;
+    } else {
+      bret = true;
+    }
+  }
+  return bret;
+}
+
 int ObTableCache::update_entry(ObTableEntry &entry, const ObTableEntryKey &key,
     const uint64_t hash)
 {
@@ -88,6 +88,8 @@ public:
 
 private:
   int process(const int64_t buck_id, ObTableParam *param);
+  // return true if the entry is found without partition lock, and it has been inc ref
+  bool lock_free_get_table_entry(const ObTableEntryKey &key, const uint64_t hash, ObTableEntry *&entry);
 
 private:
   bool is_inited_;
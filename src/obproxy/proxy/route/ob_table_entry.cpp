@@ -17,6 +17,7 @@
 #include "proxy/route/ob_table_entry.h"
 #include "utils/ob_proxy_utils.h"
 #include "proxy/route/obproxy_part_info.h"
+#include "obutils/ob_mt_hashtable.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::share;
@@ -166,7 +167,8 @@ void ObTableEntry::free()
   int64_t total_len = sizeof(ObTableEntry) + buf_len_;
   buf_start_ = NULL;
   buf_len_ = 0;
-  op_fixed_mem_free(this, total_len);
+  // table cache readers without lock may still see this entry
+  obutils::ObMTHashTableReclaimer::retire(this, total_len, obutils::ObMTHashTableReclaimer::free_fixed_mem);
 }
 
 int ObTableEntry::alloc_and_init_table_entry(
@@ -437,6 +439,16 @@ int ObTableEntry::remove_pending_batch_fetch_tablet_ids(ObIArray<uint64_t>  &bat
   return ret;
 }
 
+bool ObTableEntry::is_remote_fetching_tablet_id(const uint64_t tablet_id)
+{
+  bool bret = false;
+  event::MUTEX_TRY_LOCK(lock, batch_mutex_, event::this_ethread());
+  if (lock.is_locked() && remote_fetching_tablet_id_set_.size() > 0) {
+    bret = (OB_HASH_EXIST == remote_fetching_tablet_id_set_.exist_refactored(tablet_id));
+  }
+  return bret;
+}
+
 int ObTableEntry::get_batch_fetch_size()
 {
   int ret = 0; //0 means not put to batch set, > 0 batch size in set
@@ -125,6 +125,8 @@ public:
   int get_batch_fetch_tablet_ids(ObIArray<uint64_t>  &batch_ids);
   int get_batch_fetch_tablet_ids(ObIArray<uint64_t> &batch_ids, int max_count, uint64_t tablet_id);
   int remove_pending_batch_fetch_tablet_ids(ObIArray<uint64_t>  &batch_ids, bool force);
+  // whether the tablet is being fetched by a batch fetch of other cont
+  bool is_remote_fetching_tablet_id(const uint64_t tablet_id);
   int get_batch_fetch_size();
   void *get_batch_fetch_cont() { return batch_fetch_cont_; }
   void set_batch_fetch_cont(void *cont) { batch_fetch_cont_ = cont; }
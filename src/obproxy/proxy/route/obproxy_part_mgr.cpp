@@ -1291,6 +1291,8 @@ int ObProxyPartMgr::build_list_part(const ObPartitionLevel part_level,
   if (OB_SUCC(ret)) {
     if (OB_FAIL(desc_list->set_part_array(part_array, part_num))) {
       LOG_WDIAG("fail to set_part_array, unexpected ", K(ret));
+    } else if (OB_FAIL(desc_list->build_row_index(allocator_))) {
+      LOG_WDIAG("fail to build list row index", K(ret));
     }
   }
 
@@ -1457,6 +1459,8 @@ int ObProxyPartMgr::build_sub_list_part_with_non_template(const ObPartitionFuncT
       }
       if (OB_FAIL(desc_list->set_part_array(part_array, sub_part_num_[i]))) {
         LOG_WDIAG("fail to set_part_array, unexpected ", K(ret));
+      } else if (OB_FAIL(desc_list->build_row_index(allocator_))) {
+        LOG_WDIAG("fail to build list row index", K(ret));
       }
     }
   } // end of for
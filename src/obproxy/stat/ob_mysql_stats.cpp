@@ -87,6 +87,65 @@ int init_mysql_stats()
     MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "current_server_connections",
                             RECD_INT, CURRENT_SERVER_CONNECTIONS, SYNC_SUM, RECP_PERSISTENT);
 
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_session_migrations",
+                            RECD_INT, TOTAL_CLIENT_SESSION_MIGRATIONS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_lazy_logins",
+                            RECD_INT, TOTAL_CLIENT_LAZY_LOGINS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_lazy_login_failures",
+                            RECD_INT, TOTAL_CLIENT_LAZY_LOGIN_FAILURES, SYNC_SUM, RECP_NULL);
+
+    // vip tenant connection admission stats
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "current_client_conn_admission_waiters",
+                            RECD_INT, CURRENT_CLIENT_CONN_ADMISSION_WAITERS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_conn_admission_waits",
+                            RECD_INT, TOTAL_CLIENT_CONN_ADMISSION_WAITS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_conn_admission_rejects",
+                            RECD_INT, TOTAL_CLIENT_CONN_ADMISSION_REJECTS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_conn_admission_wait_time",
+                            RECD_INT, TOTAL_CLIENT_CONN_ADMISSION_WAIT_TIME, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_request_replays",
+                            RECD_INT, TOTAL_CLIENT_REQUEST_REPLAYS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_pipelined_requests",
+                            RECD_INT, TOTAL_CLIENT_PIPELINED_REQUESTS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "current_hibernated_client_sessions",
+                            RECD_INT, CURRENT_HIBERNATED_CLIENT_SESSIONS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_client_session_hibernations",
+                            RECD_INT, TOTAL_CLIENT_SESSION_HIBERNATIONS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "current_hibernated_client_session_bytes",
+                            RECD_INT, CURRENT_HIBERNATED_CLIENT_SESSION_BYTES, SYNC_SUM, RECP_NULL);
+
+    // session pool stats
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_pool_acquire_hits",
+                            RECD_INT, SESSION_POOL_ACQUIRE_HITS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_pool_acquire_misses",
+                            RECD_INT, SESSION_POOL_ACQUIRE_MISSES, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_pool_fingerprint_hits",
+                            RECD_INT, SESSION_POOL_FINGERPRINT_HITS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_pool_sync_round_trips_saved",
+                            RECD_INT, SESSION_POOL_SYNC_SAVED, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_vars_sync_round_trips_avoided",
+                            RECD_INT, SESSION_VARS_SYNC_SKIPPED, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_pool_prewarmed_server_conns",
+                            RECD_INT, SESSION_POOL_PREWARMED_CONNS, SYNC_SUM, RECP_NULL);
+
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "session_pool_leader_switch_prewarms",
+                            RECD_INT, SESSION_POOL_LEADER_SWITCH_PREWARMS, SYNC_SUM, RECP_NULL);
+
     // cache stats
     MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "vip_to_tenant_cache_hit",
                             RECD_INT, VIP_TO_TENANT_CACHE_HIT, SYNC_SUM, RECP_PERSISTENT);
@@ -358,6 +417,9 @@ int init_mysql_stats()
     MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_server_connect_time",
                             RECD_INT, TOTAL_SERVER_CONNECT_TIME, SYNC_SUM, RECP_NULL);
 
+    MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_proxy_cpu_time",
+                            RECD_INT, TOTAL_PROXY_CPU_TIME, SYNC_SUM, RECP_NULL);
+
     MYSQL_REGISTER_RAW_STAT(mysql_rsb, RECT_PROCESS, "total_send_xa_start_time",
                             RECD_INT, TOTAL_SEND_XA_START_TIME , SYNC_SUM, RECP_NULL);
 
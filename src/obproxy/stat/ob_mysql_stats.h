@@ -68,6 +68,7 @@ enum ObMysqlStats
   TOTAL_PL_LOOKUP_TIME,
   TOTAL_CONGESTION_CONTROL_LOOKUP_TIME,
   TOTAL_SERVER_CONNECT_TIME,
+  TOTAL_PROXY_CPU_TIME,
 
   // Transactiona stats
   CLIENT_REQUESTS,
@@ -164,6 +165,27 @@ enum ObMysqlStats
   TOTAL_CLIENT_CONNECTIONS_IPV6,
   TOTAL_SERVER_CONNECTIONS,
   CURRENT_SERVER_CONNECTIONS, // global
+  TOTAL_CLIENT_SESSION_MIGRATIONS,
+  TOTAL_CLIENT_LAZY_LOGINS,
+  TOTAL_CLIENT_LAZY_LOGIN_FAILURES,
+  CURRENT_CLIENT_CONN_ADMISSION_WAITERS,
+  TOTAL_CLIENT_CONN_ADMISSION_WAITS,
+  TOTAL_CLIENT_CONN_ADMISSION_REJECTS,
+  TOTAL_CLIENT_CONN_ADMISSION_WAIT_TIME,
+  TOTAL_CLIENT_REQUEST_REPLAYS,
+  TOTAL_CLIENT_PIPELINED_REQUESTS,
+  CURRENT_HIBERNATED_CLIENT_SESSIONS,
+  TOTAL_CLIENT_SESSION_HIBERNATIONS,
+  CURRENT_HIBERNATED_CLIENT_SESSION_BYTES,
+
+  // Mysql Session Pool Stats
+  SESSION_POOL_ACQUIRE_HITS,
+  SESSION_POOL_ACQUIRE_MISSES,
+  SESSION_POOL_FINGERPRINT_HITS,
+  SESSION_POOL_SYNC_SAVED,
+  SESSION_VARS_SYNC_SKIPPED,
+  SESSION_POOL_PREWARMED_CONNS,
+  SESSION_POOL_LEADER_SWITCH_PREWARMS,
 
   // Mysql K-A Stats
   TRANSACTIONS_PER_CLIENT_CON,
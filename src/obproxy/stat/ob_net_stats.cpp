@@ -56,6 +56,12 @@ int init_net_stats()
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "global_accepts_currently_open",
                           RECD_INT, NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, SYNC_SUM, RECP_NULL);
 
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "global_ktls_connections_currently_open",
+                          RECD_INT, NET_GLOBAL_KTLS_CONNECTIONS_CURRENTLY_OPEN, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "accepted_connections",
+                          RECD_INT, NET_ACCEPTED_CONNECTIONS, SYNC_SUM, RECP_NULL);
+
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "calls_to_readfromnet",
                           RECD_INT, NET_CALLS_TO_READFROMNET, SYNC_SUM, RECP_NULL);
 
@@ -74,9 +80,30 @@ int init_net_stats()
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "calls_to_write_nodata",
                           RECD_INT, NET_CALLS_TO_WRITE_NODATA, SYNC_SUM, RECP_NULL);
 
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "calls_to_io_uring_enter",
+                          RECD_INT, NET_CALLS_TO_IO_URING_ENTER, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "write_syscalls_saved",
+                          RECD_INT, NET_WRITE_SYSCALLS_SAVED, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "calls_to_zero_copy_send",
+                          RECD_INT, NET_CALLS_TO_ZERO_COPY_SEND, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "zero_copy_send_bytes",
+                          RECD_INT, NET_ZERO_COPY_SEND_BYTES, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "events_stolen",
+                          RECD_INT, NET_EVENTS_STOLEN, SYNC_SUM, RECP_NULL);
+
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "inactivity_cop_lock_acquire_failure",
                           RECD_INT, INACTIVITY_COP_LOCK_ACQUIRE_FAILURE, SYNC_SUM, RECP_NULL);
 
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "inactivity_cop_full_sweep",
+                          RECD_INT, INACTIVITY_COP_FULL_SWEEP, SYNC_SUM, RECP_NULL);
+
+    NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "inactivity_wheel_expired",
+                          RECD_INT, INACTIVITY_WHEEL_EXPIRED, SYNC_SUM, RECP_NULL);
+
     NET_REGISTER_RAW_STAT(net_rsb, RECT_PROCESS, "keep_alive_lru_timeout_total",
                           RECD_INT, KEEP_ALIVE_LRU_TIMEOUT_TOTAL, SYNC_SUM, RECP_NULL);
 
@@ -31,13 +31,22 @@ enum ObNetStats
   NET_GLOBAL_CLIENT_CONNECTIONS_CURRENTLY_OPEN, // global
   NET_GLOBAL_CONNECTIONS_CURRENTLY_OPEN, // global
   NET_GLOBAL_ACCEPTS_CURRENTLY_OPEN, // global, count of accept task
+  NET_GLOBAL_KTLS_CONNECTIONS_CURRENTLY_OPEN, // global, ssl connections offloaded to kernel tls
+  NET_ACCEPTED_CONNECTIONS,
   NET_CALLS_TO_READFROMNET,
   NET_CALLS_TO_READ,
   NET_CALLS_TO_READ_NODATA,
   NET_CALLS_TO_WRITETONET,
   NET_CALLS_TO_WRITE,
   NET_CALLS_TO_WRITE_NODATA,
+  NET_CALLS_TO_IO_URING_ENTER,
+  NET_WRITE_SYSCALLS_SAVED,
+  NET_CALLS_TO_ZERO_COPY_SEND,
+  NET_ZERO_COPY_SEND_BYTES,
+  NET_EVENTS_STOLEN,
   INACTIVITY_COP_LOCK_ACQUIRE_FAILURE,
+  INACTIVITY_COP_FULL_SWEEP,
+  INACTIVITY_WHEEL_EXPIRED,
   KEEP_ALIVE_LRU_TIMEOUT_TOTAL,
   KEEP_ALIVE_LRU_TIMEOUT_COUNT,
   DEFAULT_INACTIVITY_TIMEOUT,
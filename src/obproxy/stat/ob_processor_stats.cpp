@@ -136,9 +136,18 @@ int init_processor_stats()
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "kick_out_partition_entry_from_global_cache",
                       RECD_INT, KICK_OUT_PARTITION_ENTRY_FROM_GLOBAL_CACHE, SYNC_SUM, RECP_PERSISTENT);
 
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "partition_entry_remote_fetch_saved",
+                      RECD_INT, PARTITION_ENTRY_REMOTE_FETCH_SAVED, SYNC_SUM, RECP_PERSISTENT);
+
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "update_route_entry_by_congestion",
                       RECD_INT, UPDATE_ROUTE_ENTRY_BY_CONGESTION, SYNC_SUM, RECP_PERSISTENT);
 
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "update_route_entry_by_partition_miss",
+                      RECD_INT, UPDATE_ROUTE_ENTRY_BY_PARTITION_MISS, SYNC_SUM, RECP_PERSISTENT);
+
+    PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "refresh_route_entry_in_background",
+                      RECD_INT, REFRESH_ROUTE_ENTRY_IN_BACKGROUND, SYNC_SUM, RECP_PERSISTENT);
+
     // routine entry related
     PROCESSOR_REGISTER_RAW_STAT(processor_rsb, RECT_PROCESS, "get_routine_entry_from_thread_cache_hit",
                       RECD_INT, GET_ROUTINE_ENTRY_FROM_THREAD_CACHE_HIT, SYNC_SUM, RECP_PERSISTENT);
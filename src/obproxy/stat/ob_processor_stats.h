@@ -64,8 +64,11 @@ enum ObProcessorStats
   GC_PARTITION_ENTRY_FROM_GLOBAL_CACHE,
   GC_PARTITION_ENTRY_FROM_THREAD_CACHE,
   KICK_OUT_PARTITION_ENTRY_FROM_GLOBAL_CACHE, // when partition cache is full
+  PARTITION_ENTRY_REMOTE_FETCH_SAVED, // by batch fetch, or reusing the batch fetch in flight
 
   UPDATE_ROUTE_ENTRY_BY_CONGESTION,
+  UPDATE_ROUTE_ENTRY_BY_PARTITION_MISS, // request was routed by a stale entry
+  REFRESH_ROUTE_ENTRY_IN_BACKGROUND, // hot entry refreshed before request miss
 
   // routine entry related
   GET_ROUTINE_ENTRY_FROM_THREAD_CACHE_HIT,
@@ -23,6 +23,8 @@ namespace common
 ObPartDescList::ObPartDescList() : part_array_ (NULL)
                                    , part_array_size_(0)
                                    , default_part_array_idx_(OB_INVALID_INDEX)
+                                   , row_index_(NULL)
+                                   , row_index_size_(0)
 {
 }
 
@@ -58,6 +60,106 @@ ListPartition::ListPartition() : part_id_(0), rows_()
 {
 }
 
+int ListRowIndex::compare_row(const ObNewRow &lhs, const ObNewRow &rhs)
+{
+  int cmp = 0;
+  const int64_t min_col_cnt = std::min(lhs.get_count(), rhs.get_count());
+  for (int64_t i = 0; 0 == cmp && i < min_col_cnt; ++i) {
+    cmp = lhs.get_cell(i)->compare(*rhs.get_cell(i));
+  }
+  if (0 == cmp) {
+    cmp = (lhs.get_count() < rhs.get_count() ? -1 : (lhs.get_count() > rhs.get_count() ? 1 : 0));
+  }
+  return cmp;
+}
+
+bool ListRowIndex::less_than(const ListRowIndex &a, const ListRowIndex &b)
+{
+  const int cmp = compare_row(*a.row_, *b.row_);
+  return cmp < 0 || (0 == cmp && a.part_array_idx_ < b.part_array_idx_);
+}
+
+int ObPartDescList::build_row_index(ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_count = 0;
+  const ObNewRow *first_row = NULL;
+  bool is_meta_matched = true;
+  row_index_ = NULL;
+  row_index_size_ = 0;
+  for (int64_t i = 0; i < part_array_size_ && is_meta_matched; ++i) {
+    if (i != default_part_array_idx_) {
+      for (int64_t j = 0; j < part_array_[i].rows_.count() && is_meta_matched; ++j) {
+        const ObNewRow &row = part_array_[i].rows_.at(j);
+        if (NULL == first_row) {
+          first_row = &row;
+          is_meta_matched = (row.get_count() > 0);
+          for (int64_t k = 0; k < row.get_count() && is_meta_matched; ++k) {
+            // null and min/max value can not be compared with the casted value
+            is_meta_matched = (NULL != row.get_cell(k)
+                               && !row.get_cell(k)->is_null()
+                               && !row.get_cell(k)->is_ext());
+          }
+        } else {
+          is_meta_matched = is_same_row_meta(row, *first_row);
+        }
+        ++row_count;
+      }
+    }
+  }
+
+  if (!is_meta_matched || row_count <= 0) {
+    COMMON_LOG(DEBUG, "list values have different types, do not build row index",
+               K(is_meta_matched), K(row_count));
+  } else if (OB_ISNULL(row_index_ = static_cast<ListRowIndex *>(allocator.alloc(sizeof(ListRowIndex) * row_count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    COMMON_LOG(WDIAG, "fail to alloc row index", K(row_count), K(ret));
+  } else {
+    for (int64_t i = 0; i < part_array_size_; ++i) {
+      if (i != default_part_array_idx_) {
+        for (int64_t j = 0; j < part_array_[i].rows_.count(); ++j) {
+          row_index_[row_index_size_].row_ = &part_array_[i].rows_.at(j);
+          row_index_[row_index_size_].part_array_idx_ = i;
+          ++row_index_size_;
+        }
+      }
+    }
+    std::sort(row_index_, row_index_ + row_index_size_, ListRowIndex::less_than);
+  }
+  return ret;
+}
+
+bool ObPartDescList::is_same_row_meta(const ObNewRow &lhs, const ObNewRow &rhs)
+{
+  bool bret = (lhs.get_count() == rhs.get_count());
+  for (int64_t i = 0; i < lhs.get_count() && bret; ++i) {
+    const ObObj *lhs_obj = lhs.get_cell(i);
+    const ObObj *rhs_obj = rhs.get_cell(i);
+    bret = (NULL != lhs_obj && NULL != rhs_obj
+            && lhs_obj->get_type() == rhs_obj->get_type()
+            && (!lhs_obj->is_string_type() || lhs_obj->get_collation_type() == rhs_obj->get_collation_type()));
+  }
+  return bret;
+}
+
+bool ObPartDescList::lookup_row_index(const ObNewRow &src_row, int64_t &part_array_idx) const
+{
+  bool found = false;
+  // the value which is not casted, e.g. null, never equals to any value of the index
+  if (is_same_row_meta(src_row, *row_index_[0].row_)) {
+    ListRowIndex key;
+    key.row_ = &src_row;
+    key.part_array_idx_ = -1;
+    const ListRowIndex *result = std::lower_bound(row_index_, row_index_ + row_index_size_,
+                                                  key, ListRowIndex::less_than);
+    if (result != row_index_ + row_index_size_ && 0 == ListRowIndex::compare_row(*result->row_, src_row)) {
+      found = true;
+      part_array_idx = result->part_array_idx_;
+    }
+  }
+  return found;
+}
+
 int ObPartDescList::get_part(ObNewRange &range,
                              ObIAllocator &allocator,
                              ObIArray<int64_t> &part_ids,
@@ -77,38 +179,50 @@ int ObPartDescList::get_part(ObNewRange &range,
   } else {
     bool found = false;
     bool casted = false;
-    // cast src_row and compare with part array
-    for (int64_t i = 0; i < part_array_size_ && !found; i++) {
-      if (i == default_part_array_idx_) {
-        continue;
+    int64_t found_idx = OB_INVALID_INDEX;
+    if (row_index_size_ > 0) {
+      // all values have the same types, cast once and binary search
+      if (OB_FAIL(cast_row(src_row, const_cast<ObNewRow &>(*row_index_[0].row_), allocator, ctx))) {
+        COMMON_LOG(DEBUG, "fail to cast row");
+      } else {
+        found = lookup_row_index(src_row, found_idx);
       }
-      for (int64_t j = 0; j < part_array_[i].rows_.count() && !found; j++) {
-        if (part_array_[i].rows_[j].get_count() == 0) {
-          ret = OB_ERR_UNEXPECTED;
-          COMMON_LOG(DEBUG, "no cells in the row", K(part_array_[i].rows_[j]), K(ret));
-        } else {
-          // if not cast, cast first
-          if (!casted && OB_FAIL(cast_row(src_row, part_array_[i].rows_.at(j), allocator, ctx))) {
-            COMMON_LOG(DEBUG, "fail to cast row");
-            continue;
+    } else {
+      // cast src_row and compare with part array
+      for (int64_t i = 0; i < part_array_size_ && !found; i++) {
+        if (i == default_part_array_idx_) {
+          continue;
+        }
+        for (int64_t j = 0; j < part_array_[i].rows_.count() && !found; j++) {
+          if (part_array_[i].rows_[j].get_count() == 0) {
+            ret = OB_ERR_UNEXPECTED;
+            COMMON_LOG(DEBUG, "no cells in the row", K(part_array_[i].rows_[j]), K(ret));
           } else {
-            casted = true;
-          }
-          // if casted, then compare
-          if (casted && src_row == part_array_[i].rows_.at(j)) {
-            found = true;
-            part_idx = i;
-            if (OB_FAIL(part_ids.push_back(part_array_[i].part_id_))) {
-              COMMON_LOG(WDIAG, "fail to push part id", K(ret));
-            } else if (NULL != tablet_id_array_ && OB_FAIL(tablet_ids.push_back(tablet_id_array_[i]))) {
-              COMMON_LOG(WDIAG, "fail to push tablet id", K(ret));
+            // if not cast, cast first
+            if (!casted && OB_FAIL(cast_row(src_row, part_array_[i].rows_.at(j), allocator, ctx))) {
+              COMMON_LOG(DEBUG, "fail to cast row");
+              continue;
+            } else {
+              casted = true;
             }
-          } else {}
-        }
-      } // end for rows
-    } // end for part_array
+            // if casted, then compare
+            if (casted && src_row == part_array_[i].rows_.at(j)) {
+              found = true;
+              found_idx = i;
+            } else {}
+          }
+        } // end for rows
+      } // end for part_array
+    }
 
-    if (!found && OB_INVALID_INDEX != default_part_array_idx_) {
+    if (found) {
+      part_idx = found_idx;
+      if (OB_FAIL(part_ids.push_back(part_array_[found_idx].part_id_))) {
+        COMMON_LOG(WDIAG, "fail to push part id", K(ret));
+      } else if (NULL != tablet_id_array_ && OB_FAIL(tablet_ids.push_back(tablet_id_array_[found_idx]))) {
+        COMMON_LOG(WDIAG, "fail to push tablet id", K(ret));
+      }
+    } else if (OB_INVALID_INDEX != default_part_array_idx_) {
       // if no row matches, use default partition
       part_idx = default_part_array_idx_;
       COMMON_LOG(DEBUG, "will use default partition id", K(src_row), K(ret));
@@ -167,39 +281,51 @@ int ObPartDescList::get_part_for_obkv(ObNewRange &range,
   } else {
     bool found = false;
     bool casted = false;
-    // cast src_row and compare with part array
-    for (int64_t i = 0; i < part_array_size_ && !found; i++) {
-      if (i == default_part_array_idx_) {
-        continue;
+    int64_t found_idx = OB_INVALID_INDEX;
+    if (row_index_size_ > 0) {
+      // all values have the same types, cast once and binary search
+      if (OB_FAIL(cast_row_for_obkv(src_row, const_cast<ObNewRow &>(*row_index_[0].row_), allocator, ctx))) {
+        COMMON_LOG(WDIAG, "fail to cast row");
+      } else {
+        found = lookup_row_index(src_row, found_idx);
       }
-      for (int64_t j = 0; j < part_array_[i].rows_.count() && !found; j++) {
-        if (part_array_[i].rows_[j].get_count() == 0) {
-          ret = OB_ERR_UNEXPECTED;
-          COMMON_LOG(WDIAG, "no cells in the row", K(part_array_[i].rows_[j]), K(ret));
-        } else {
-          // if not cast, cast first
-          if (!casted && OB_FAIL(cast_row_for_obkv(src_row, part_array_[i].rows_.at(j), allocator, ctx))) {
-            COMMON_LOG(WDIAG, "fail to cast row");
-            continue;
+    } else {
+      // cast src_row and compare with part array
+      for (int64_t i = 0; i < part_array_size_ && !found; i++) {
+        if (i == default_part_array_idx_) {
+          continue;
+        }
+        for (int64_t j = 0; j < part_array_[i].rows_.count() && !found; j++) {
+          if (part_array_[i].rows_[j].get_count() == 0) {
+            ret = OB_ERR_UNEXPECTED;
+            COMMON_LOG(WDIAG, "no cells in the row", K(part_array_[i].rows_[j]), K(ret));
           } else {
-            casted = true;
-          }
-          // if casted, then compare
-          if (casted && src_row == part_array_[i].rows_.at(j)) {
-            found = true;
-            if (OB_FAIL(part_ids.push_back(part_array_[i].part_id_))) {
-              COMMON_LOG(WDIAG, "fail to push part id", K(ret));
-            } else if (NULL != tablet_id_array_ && OB_FAIL(tablet_ids.push_back(tablet_id_array_[i]))) {
-              COMMON_LOG(WDIAG, "fail to push tablet id", K(ret));
-            } else if (NULL != ls_id_array_ && OB_FAIL(ls_ids.push_back(ls_id_array_[i]))) {
-              COMMON_LOG(WDIAG, "fail to push ls id", K(ret));
+            // if not cast, cast first
+            if (!casted && OB_FAIL(cast_row_for_obkv(src_row, part_array_[i].rows_.at(j), allocator, ctx))) {
+              COMMON_LOG(WDIAG, "fail to cast row");
+              continue;
+            } else {
+              casted = true;
             }
-          } else {}
-        }
-      } // end for rows
-    } // end for part_array
+            // if casted, then compare
+            if (casted && src_row == part_array_[i].rows_.at(j)) {
+              found = true;
+              found_idx = i;
+            } else {}
+          }
+        } // end for rows
+      } // end for part_array
+    }
 
-    if (!found && OB_INVALID_INDEX != default_part_array_idx_) {
+    if (found) {
+      if (OB_FAIL(part_ids.push_back(part_array_[found_idx].part_id_))) {
+        COMMON_LOG(WDIAG, "fail to push part id", K(ret));
+      } else if (NULL != tablet_id_array_ && OB_FAIL(tablet_ids.push_back(tablet_id_array_[found_idx]))) {
+        COMMON_LOG(WDIAG, "fail to push tablet id", K(ret));
+      } else if (NULL != ls_id_array_ && OB_FAIL(ls_ids.push_back(ls_id_array_[found_idx]))) {
+        COMMON_LOG(WDIAG, "fail to push ls id", K(ret));
+      }
+    } else if (OB_INVALID_INDEX != default_part_array_idx_) {
       // if no row matches, use default partition
       COMMON_LOG(DEBUG, "will use default partition id", K(src_row), K(ret));
       if (OB_FAIL(part_ids.push_back(part_array_[default_part_array_idx_].part_id_))) {
@@ -34,6 +34,18 @@ struct ListPartition
                K_(rows));
 };
 
+// one value of the list partitions, sorted by value to binary search
+struct ListRowIndex
+{
+  const ObNewRow *row_;
+  int64_t part_array_idx_;
+
+  static int compare_row(const ObNewRow &lhs, const ObNewRow &rhs);
+  // the same values are sorted by part array idx, so the first matched partition is found
+  static bool less_than(const ListRowIndex &a, const ListRowIndex &b);
+  TO_STRING_KV(KPC_(row), K_(part_array_idx));
+};
+
 class ObPartDescList : public ObPartDesc
 {
 public:
@@ -67,6 +79,10 @@ public:
     part_array_size_ = size;
     return OB_SUCCESS;
   }
+  // build the sorted index of all values after part array is set, it is used only
+  // when all values have the same obj types, or the linear scan is used
+  int build_row_index(ObIAllocator &allocator);
+  int64_t get_row_index_size() const { return row_index_size_; }
 
   int cast_row(ObNewRow &src_row,
                ObNewRow &target_row,
@@ -80,10 +96,17 @@ public:
 
   DECLARE_VIRTUAL_TO_STRING;
   virtual int64_t to_plain_string(char* buf, const int64_t buf_len) const;
+private:
+  static bool is_same_row_meta(const ObNewRow &lhs, const ObNewRow &rhs);
+  // src_row must have been casted to the type of the values
+  bool lookup_row_index(const ObNewRow &src_row, int64_t &part_array_idx) const;
+
 private:
   ListPartition *part_array_;
   int64_t part_array_size_;
   int64_t default_part_array_idx_;
+  ListRowIndex *row_index_;
+  int64_t row_index_size_;
 };
 
 } // end common
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include "lib/ob_define.h"
+#include "lib/string/ob_sql_string.h"
+#include "obproxy/iocore/eventsystem/ob_io_buffer.h"
+#include "obproxy/proxy/mysqllib/ob_mysql_analyzer_utils.h"
+#include "obproxy/proxy/mysqllib/ob_mysql_request_builder.h"
+#include "obproxy/proxy/mysqllib/ob_proxy_parser_utils.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+using namespace oceanbase::obproxy::event;
+
+static int64_t const MYSQL_BUFFER_SIZE = BUFFER_SIZE_FOR_INDEX(BUFFER_SIZE_INDEX_8K);
+
+// the first query is handled by proxy itself, the second one is pipelined behind it
+static const char *INTERNAL_SQL = "show proxysession";
+static const char *REWRITTEN_SQL = "kill query 1";
+
+class TestClientRequestPipelining : public ::testing::Test
+{
+public:
+  TestClientRequestPipelining() : buf_(NULL), reader_(NULL) {}
+
+  virtual void SetUp()
+  {
+    buf_ = new_miobuffer(MYSQL_BUFFER_SIZE);
+    ASSERT_TRUE(NULL != buf_);
+    reader_ = buf_->alloc_reader();
+    ASSERT_TRUE(NULL != reader_);
+    // the pipelined query spans several buffer blocks
+    ASSERT_EQ(OB_SUCCESS, pipelined_sql_.append("select '"));
+    for (int64_t i = 0; i < MYSQL_BUFFER_SIZE * 2; ++i) {
+      ASSERT_EQ(OB_SUCCESS, pipelined_sql_.append("a"));
+    }
+    ASSERT_EQ(OB_SUCCESS, pipelined_sql_.append("'"));
+  }
+
+  virtual void TearDown()
+  {
+    if (NULL != buf_) {
+      free_miobuffer(buf_);
+      buf_ = NULL;
+      reader_ = NULL;
+    }
+  }
+
+  void write_query(const ObString &sql)
+  {
+    ASSERT_EQ(OB_SUCCESS, ObMysqlRequestBuilder::build_mysql_request(*buf_, OB_MYSQL_COM_QUERY,
+                                                                     sql, false, false, 0));
+  }
+
+  void write_pipelined_queries()
+  {
+    write_query(ObString::make_string(INTERNAL_SQL));
+    write_query(pipelined_sql_.string());
+  }
+
+  // the query at the head of client buffer must be the expected one
+  void check_head_query(const ObString &sql, int64_t &pkt_len)
+  {
+    ObMysqlAnalyzeResult result;
+    ObSqlString head_sql;
+    ASSERT_EQ(OB_SUCCESS, ObProxyParserUtils::analyze_one_packet(*reader_, result));
+    ASSERT_EQ(ANALYZE_DONE, result.status_);
+    ASSERT_EQ(OB_MYSQL_COM_QUERY, result.meta_.cmd_);
+    pkt_len = result.meta_.pkt_len_;
+    ASSERT_EQ(MYSQL_NET_META_LENGTH + sql.length(), pkt_len);
+    ASSERT_EQ(OB_SUCCESS, head_sql.reserve(sql.length()));
+    reader_->copy(head_sql.ptr(), sql.length(), MYSQL_NET_META_LENGTH);
+    ASSERT_EQ(OB_SUCCESS, head_sql.set_length(sql.length()));
+    ASSERT_TRUE(sql == head_sql.string());
+  }
+
+  ObMIOBuffer *buf_;
+  ObIOBufferReader *reader_;
+  ObSqlString pipelined_sql_;
+};
+
+TEST_F(TestClientRequestPipelining, consume_internal_request)
+{
+  int64_t pkt_len = 0;
+  int64_t pipelined_pkt_len = 0;
+  write_pipelined_queries();
+  check_head_query(ObString::make_string(INTERNAL_SQL), pkt_len);
+
+  // the internal request is consumed, the pipelined one is left in client buffer
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::consume_request(*reader_, pkt_len));
+  check_head_query(pipelined_sql_.string(), pipelined_pkt_len);
+  ASSERT_EQ(pipelined_pkt_len, reader_->read_avail());
+
+  // nothing is left behind the last request
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::consume_request(*reader_, pipelined_pkt_len));
+  ASSERT_EQ(0, reader_->read_avail());
+}
+
+TEST_F(TestClientRequestPipelining, rewrite_request)
+{
+  int64_t pkt_len = 0;
+  int64_t pipelined_pkt_len = 0;
+  ObSqlString pipelined_reqs;
+  write_pipelined_queries();
+  check_head_query(ObString::make_string(INTERNAL_SQL), pkt_len);
+
+  // the current request is rewritten at the head of client buffer
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::take_pipelined_requests(*reader_, pkt_len, pipelined_reqs));
+  ASSERT_EQ(pkt_len, reader_->read_avail());
+  ASSERT_EQ(OB_SUCCESS, reader_->consume_all());
+  write_query(ObString::make_string(REWRITTEN_SQL));
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::restore_pipelined_requests(*reader_, pipelined_reqs.string()));
+
+  check_head_query(ObString::make_string(REWRITTEN_SQL), pkt_len);
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::consume_request(*reader_, pkt_len));
+  check_head_query(pipelined_sql_.string(), pipelined_pkt_len);
+  ASSERT_EQ(pipelined_pkt_len, reader_->read_avail());
+}
+
+TEST_F(TestClientRequestPipelining, retry_request)
+{
+  int64_t pkt_len = 0;
+  int64_t pipelined_pkt_len = 0;
+  ObSqlString pipelined_reqs;
+  write_pipelined_queries();
+  check_head_query(ObString::make_string(INTERNAL_SQL), pkt_len);
+
+  // the current request has been sent, and is written back for retry
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::consume_request(*reader_, pkt_len));
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::take_pipelined_requests(*reader_, 0, pipelined_reqs));
+  ASSERT_EQ(0, reader_->read_avail());
+  write_query(ObString::make_string(INTERNAL_SQL));
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::restore_pipelined_requests(*reader_, pipelined_reqs.string()));
+
+  check_head_query(ObString::make_string(INTERNAL_SQL), pkt_len);
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::consume_request(*reader_, pkt_len));
+  check_head_query(pipelined_sql_.string(), pipelined_pkt_len);
+  ASSERT_EQ(pipelined_pkt_len, reader_->read_avail());
+}
+
+TEST_F(TestClientRequestPipelining, no_pipelined_request)
+{
+  int64_t pkt_len = 0;
+  ObSqlString pipelined_reqs;
+  write_query(ObString::make_string(INTERNAL_SQL));
+  check_head_query(ObString::make_string(INTERNAL_SQL), pkt_len);
+
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::take_pipelined_requests(*reader_, pkt_len, pipelined_reqs));
+  ASSERT_TRUE(pipelined_reqs.empty());
+  ASSERT_EQ(pkt_len, reader_->read_avail());
+  ASSERT_EQ(OB_SUCCESS, ObMysqlAnalyzerUtils::restore_pipelined_requests(*reader_, pipelined_reqs.string()));
+  ASSERT_EQ(pkt_len, reader_->read_avail());
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "lib/time/ob_time_utility.h"
+#include "omt/ob_conn_table_processor.h"
+#include "omt/ob_resource_unit_table_processor.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace omt;
+
+#define TEST_MAX_CONNECTIONS  2
+#define TEST_MAX_WAITERS      1
+#define TEST_POLL_INTERVAL_US 5000
+
+class TestConnAdmission : public ::testing::Test
+{
+public:
+  TestConnAdmission()
+    : cluster_name_(ObString::make_string("cname")),
+      tenant_name_(ObString::make_string("tname")),
+      ip_name_(ObString::make_string("127.0.0.1")) {}
+
+  virtual void SetUp()
+  {
+    ObString name_str = ObString::make_string("max_connections");
+    ObString value_str = ObString::make_string("[{\"vip\":\"127.0.0.1\",\"value\":2}]");
+    ASSERT_EQ(OB_SUCCESS, processor_.conn_handle_replace_config(cluster_name_, tenant_name_,
+                                                                name_str, value_str, false));
+  }
+
+  bool check_and_inc_conn(const bool is_waiter = false)
+  {
+    return processor_.check_and_inc_conn(cluster_name_, tenant_name_, ip_name_, is_waiter);
+  }
+
+  void dec_conn() { processor_.dec_conn(cluster_name_, tenant_name_, ip_name_); }
+
+  int inc_waiting_conn()
+  {
+    int64_t cur_waiting_connections = 0;
+    return processor_.inc_waiting_conn(cluster_name_, tenant_name_, ip_name_,
+                                       TEST_MAX_WAITERS, cur_waiting_connections);
+  }
+
+  void dec_waiting_conn() { processor_.dec_waiting_conn(cluster_name_, tenant_name_, ip_name_); }
+
+  // the same as ObMysqlSM::state_wait_conn_admission, return true if admitted before timeout
+  bool wait_conn_admission(const int64_t timeout_us)
+  {
+    bool admitted = false;
+    const int64_t begin = ObTimeUtility::current_time();
+    while (!admitted && ObTimeUtility::current_time() - begin < timeout_us) {
+      usleep(TEST_POLL_INTERVAL_US);
+      admitted = !check_and_inc_conn(true);
+    }
+    dec_waiting_conn();
+    return admitted;
+  }
+
+  // -1 if the used conn is not in map
+  void get_used_conn_count(int64_t &used_count, int64_t &waiting_count)
+  {
+    ObFixedLengthString<OB_PROXY_MAX_TENANT_CLUSTER_NAME_LENGTH + MAX_IP_ADDR_LENGTH> key_string;
+    ObUsedConn *used_conn = NULL;
+    int64_t cur_used_connections = 0;
+    used_count = -1;
+    waiting_count = -1;
+    ASSERT_EQ(OB_SUCCESS, build_tenant_cluster_vip_name(tenant_name_, cluster_name_, ip_name_, key_string));
+    ObString key_name = ObString::make_string(key_string.ptr());
+    if (OB_SUCCESS == processor_.get_used_conn(key_name, false, used_conn, cur_used_connections)) {
+      used_count = used_conn->max_used_connections_;
+      waiting_count = used_conn->waiting_connections_;
+      used_conn->dec_ref();
+    }
+  }
+
+  ObString cluster_name_;
+  ObString tenant_name_;
+  ObString ip_name_;
+  ObConnTableProcessor processor_;
+};
+
+TEST_F(TestConnAdmission, wait_and_admit)
+{
+  int64_t used_count = 0;
+  int64_t waiting_count = 0;
+  for (int64_t i = 0; i < TEST_MAX_CONNECTIONS; ++i) {
+    ASSERT_FALSE(check_and_inc_conn());
+  }
+  // throttled, the first one waits and the others over max waiters are rejected
+  ASSERT_TRUE(check_and_inc_conn());
+  ASSERT_EQ(OB_SUCCESS, inc_waiting_conn());
+  ASSERT_EQ(OB_SIZE_OVERFLOW, inc_waiting_conn());
+  get_used_conn_count(used_count, waiting_count);
+  ASSERT_EQ(TEST_MAX_CONNECTIONS, used_count);
+  ASSERT_EQ(TEST_MAX_WAITERS, waiting_count);
+  ASSERT_TRUE(check_and_inc_conn(true));
+
+  // a connection is freed, the new login can not overtake the waiter
+  dec_conn();
+  ASSERT_TRUE(check_and_inc_conn());
+  ASSERT_TRUE(wait_conn_admission(TEST_POLL_INTERVAL_US * 10));
+  get_used_conn_count(used_count, waiting_count);
+  ASSERT_EQ(TEST_MAX_CONNECTIONS, used_count);
+  ASSERT_EQ(0, waiting_count);
+
+  for (int64_t i = 0; i < TEST_MAX_CONNECTIONS; ++i) {
+    dec_conn();
+  }
+  get_used_conn_count(used_count, waiting_count);
+  ASSERT_EQ(-1, used_count);
+}
+
+TEST_F(TestConnAdmission, wait_timeout)
+{
+  int64_t used_count = 0;
+  int64_t waiting_count = 0;
+  for (int64_t i = 0; i < TEST_MAX_CONNECTIONS; ++i) {
+    ASSERT_FALSE(check_and_inc_conn());
+  }
+  ASSERT_TRUE(check_and_inc_conn());
+  ASSERT_EQ(OB_SUCCESS, inc_waiting_conn());
+
+  // no connection is freed during waiting
+  const int64_t begin = ObTimeUtility::current_time();
+  ASSERT_FALSE(wait_conn_admission(TEST_POLL_INTERVAL_US * 4));
+  ASSERT_GE(ObTimeUtility::current_time() - begin, TEST_POLL_INTERVAL_US * 4);
+  get_used_conn_count(used_count, waiting_count);
+  ASSERT_EQ(TEST_MAX_CONNECTIONS, used_count);
+  ASSERT_EQ(0, waiting_count);
+
+  // no waiter any more, new logins are admitted as usual
+  dec_conn();
+  ASSERT_FALSE(check_and_inc_conn());
+  for (int64_t i = 0; i < TEST_MAX_CONNECTIONS; ++i) {
+    dec_conn();
+  }
+  get_used_conn_count(used_count, waiting_count);
+  ASSERT_EQ(-1, used_count);
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
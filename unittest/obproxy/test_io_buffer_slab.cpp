@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+
+#define USING_LOG_PREFIX PROXY_EVENT
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#define private public
+#define protected public
+#include "ob_io_buffer_slab.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace event;
+
+#define TEST_BLOCK_NUM    10000
+
+struct RemoteFreeParam
+{
+  void **blocks_;
+  int64_t count_;
+};
+
+class TestIOBufferSlab : public ::testing::Test
+{
+public:
+  virtual void SetUp() { ASSERT_EQ(OB_SUCCESS, slab_.init(false, false)); }
+  virtual void TearDown() { }
+
+  static void *remote_free_func(void *arg)
+  {
+    RemoteFreeParam *param = static_cast<RemoteFreeParam *>(arg);
+    for (int64_t i = 0; i < param->count_; ++i) {
+      ObIOBufferSlab::free(param->blocks_[i], NULL);
+    }
+    return NULL;
+  }
+
+  int64_t get_used_count(const int64_t size_index)
+  {
+    int64_t hold = 0;
+    int64_t used = 0;
+    int64_t count = 0;
+    slab_.get_usage(size_index, hold, used, count);
+    return count;
+  }
+
+public:
+  ObIOBufferSlab slab_;
+  void *blocks_[TEST_BLOCK_NUM];
+};
+
+TEST_F(TestIOBufferSlab, test_size_class)
+{
+  ASSERT_TRUE(NULL == slab_.alloc(0));
+  ASSERT_TRUE(NULL == slab_.alloc(DEFAULT_MAX_BUFFER_SIZE + 1));
+
+  for (int64_t i = 0; i < BUFFER_SIZE_INDEX_COUNT; ++i) {
+    const int64_t size = BUFFER_SIZE_FOR_INDEX(i);
+    // smaller sizes are rounded up to the size class
+    void *a = slab_.alloc(size);
+    void *b = slab_.alloc(size / 2 + 1);
+    ASSERT_TRUE(NULL != a);
+    ASSERT_TRUE(NULL != b);
+    ASSERT_EQ(0, reinterpret_cast<uint64_t>(a) % size);
+    ASSERT_EQ(size, reinterpret_cast<char *>(b) - reinterpret_cast<char *>(a));
+    ASSERT_EQ(2, get_used_count(i));
+    memset(a, 0, size);
+    memset(b, 0, size);
+
+    ObIOBufferSlab::free(a, &slab_);
+    ObIOBufferSlab::free(b, &slab_);
+    ASSERT_EQ(0, get_used_count(i));
+    // the last freed runs first
+    ASSERT_EQ(b, slab_.alloc(size));
+    ObIOBufferSlab::free(b, &slab_);
+  }
+}
+
+TEST_F(TestIOBufferSlab, test_new_arena)
+{
+  const int64_t index = BUFFER_SIZE_INDEX_8K;
+  // the first block of an arena is its header
+  const int64_t per_arena = IO_BUFFER_SLAB_ARENA_SIZE / DEFAULT_MAX_BUFFER_SIZE - 1;
+  for (int64_t i = 0; i < per_arena + 1; ++i) {
+    ASSERT_TRUE(NULL != (blocks_[i] = slab_.alloc(DEFAULT_MAX_BUFFER_SIZE)));
+  }
+  int64_t hold = 0;
+  int64_t used = 0;
+  int64_t count = 0;
+  slab_.get_usage(index, hold, used, count);
+  ASSERT_EQ(2 * IO_BUFFER_SLAB_ARENA_SIZE, hold);
+  ASSERT_EQ((per_arena + 1) * DEFAULT_MAX_BUFFER_SIZE, used);
+  ASSERT_EQ(per_arena + 1, count);
+  for (int64_t i = 0; i < per_arena + 1; ++i) {
+    ObIOBufferSlab::free(blocks_[i], &slab_);
+  }
+  ASSERT_EQ(0, get_used_count(index));
+}
+
+TEST_F(TestIOBufferSlab, test_remote_free)
+{
+  const int64_t index = BUFFER_SIZE_INDEX_1K;
+  const int64_t size = BUFFER_SIZE_FOR_INDEX(index);
+  for (int64_t i = 0; i < TEST_BLOCK_NUM; ++i) {
+    ASSERT_TRUE(NULL != (blocks_[i] = slab_.alloc(size)));
+  }
+  ASSERT_EQ(TEST_BLOCK_NUM, get_used_count(index));
+  int64_t hold = 0;
+  int64_t used = 0;
+  int64_t count = 0;
+  slab_.get_usage(index, hold, used, count);
+  const int64_t hold_before = hold;
+
+  // two threads free half of the blocks each, concurrently
+  pthread_t threads[2];
+  RemoteFreeParam params[2];
+  for (int64_t i = 0; i < 2; ++i) {
+    params[i].blocks_ = blocks_ + i * (TEST_BLOCK_NUM / 2);
+    params[i].count_ = TEST_BLOCK_NUM / 2;
+    ASSERT_EQ(0, pthread_create(&threads[i], NULL, remote_free_func, &params[i]));
+  }
+  for (int64_t i = 0; i < 2; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+  // counted as used until the owner takes them back
+  ASSERT_EQ(TEST_BLOCK_NUM, get_used_count(index));
+
+  // all of them are reused without a new arena
+  for (int64_t i = 0; i < TEST_BLOCK_NUM; ++i) {
+    ASSERT_TRUE(NULL != (blocks_[i] = slab_.alloc(size)));
+  }
+  slab_.get_usage(index, hold, used, count);
+  ASSERT_EQ(hold_before, hold);
+  ASSERT_EQ(TEST_BLOCK_NUM, count);
+  for (int64_t i = 0; i < TEST_BLOCK_NUM; ++i) {
+    ObIOBufferSlab::free(blocks_[i], &slab_);
+  }
+  ASSERT_EQ(0, get_used_count(index));
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
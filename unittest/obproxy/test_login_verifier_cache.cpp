@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include "proxy/mysql/ob_mysql_login_verifier_cache.h"
+#include "proxy/mysqllib/ob_proxy_session_info.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+namespace proxy
+{
+using namespace common;
+using namespace obmysql;
+
+#define TEST_USER_PRIV_SET  7
+#define TEST_EXPIRE_TIME_US 10000
+
+static const char *SCRAMBLE = "abcdefghijklmnopqrst";
+static const char *OTHER_SCRAMBLE = "tsrqponmlkjihgfedcba";
+static const char *AUTH_RESPONSE = "01234567890123456789";
+static const char *OTHER_AUTH_RESPONSE = "98765432109876543210";
+
+class TestLoginVerifierCache : public ::testing::Test
+{
+public:
+  // the login of user@tenant#cluster to database test
+  static void set_login(ObClientSessionInfo &client_info, const char *scramble,
+                        const char *auth_response)
+  {
+    ObHSRResult &hsr = client_info.get_login_req().get_hsr_result();
+    hsr.user_name_ = ObString::make_string("user");
+    hsr.tenant_name_ = ObString::make_string("tenant");
+    hsr.cluster_name_ = ObString::make_string("cluster");
+    hsr.response_.set_auth_response(ObString::make_string(auth_response));
+    hsr.response_.set_database(ObString::make_string("test"));
+    client_info.get_scramble_string() = ObString::make_string(scramble);
+  }
+
+  void add_verifier()
+  {
+    ObClientSessionInfo client_info;
+    set_login(client_info, SCRAMBLE, AUTH_RESPONSE);
+    client_info.set_user_priv_set(TEST_USER_PRIV_SET);
+    ASSERT_EQ(OB_SUCCESS, cache_.add_verifier(client_info));
+    ASSERT_EQ(1, cache_.count());
+  }
+
+  bool check_verifier(const char *scramble, const char *auth_response,
+                      const int64_t expire_time_us = 0)
+  {
+    ObClientSessionInfo client_info;
+    set_login(client_info, scramble, auth_response);
+    return cache_.check_verifier(client_info, expire_time_us);
+  }
+
+  ObMysqlLoginVerifierCache cache_;
+};
+
+TEST_F(TestLoginVerifierCache, hit)
+{
+  add_verifier();
+  ObClientSessionInfo client_info;
+  set_login(client_info, SCRAMBLE, AUTH_RESPONSE);
+  ASSERT_TRUE(cache_.check_verifier(client_info, 0));
+  // the privilege of the cached login is filled in
+  ASSERT_EQ(TEST_USER_PRIV_SET, client_info.get_priv_info().user_priv_set_);
+  ASSERT_FALSE(client_info.is_oracle_mode());
+  ASSERT_EQ(1, cache_.count());
+}
+
+TEST_F(TestLoginVerifierCache, miss)
+{
+  ASSERT_FALSE(check_verifier(SCRAMBLE, AUTH_RESPONSE));
+
+  // the password changed, or the same password is scrambled by another handshake
+  add_verifier();
+  ASSERT_FALSE(check_verifier(SCRAMBLE, OTHER_AUTH_RESPONSE));
+  ASSERT_FALSE(check_verifier(OTHER_SCRAMBLE, AUTH_RESPONSE));
+  ASSERT_FALSE(check_verifier(OTHER_SCRAMBLE, OTHER_AUTH_RESPONSE));
+
+  // the cached login is kept for the client which logins the same way
+  ASSERT_EQ(1, cache_.count());
+  ASSERT_TRUE(check_verifier(SCRAMBLE, AUTH_RESPONSE));
+}
+
+TEST_F(TestLoginVerifierCache, expire)
+{
+  add_verifier();
+  ASSERT_TRUE(check_verifier(SCRAMBLE, AUTH_RESPONSE, TEST_EXPIRE_TIME_US));
+
+  // the expired login is removed, observer needs to verify it again
+  usleep(TEST_EXPIRE_TIME_US * 2);
+  ASSERT_TRUE(check_verifier(SCRAMBLE, AUTH_RESPONSE));
+  ASSERT_FALSE(check_verifier(SCRAMBLE, AUTH_RESPONSE, TEST_EXPIRE_TIME_US));
+  ASSERT_EQ(0, cache_.count());
+  ASSERT_FALSE(check_verifier(SCRAMBLE, AUTH_RESPONSE));
+}
+
+TEST_F(TestLoginVerifierCache, user_priv_changed)
+{
+  add_verifier();
+  ObClientSessionInfo client_info;
+  set_login(client_info, SCRAMBLE, AUTH_RESPONSE);
+  cache_.check_user_priv_set(client_info, TEST_USER_PRIV_SET);
+  ASSERT_EQ(1, cache_.count());
+  cache_.check_user_priv_set(client_info, TEST_USER_PRIV_SET + 1);
+  ASSERT_EQ(0, cache_.count());
+}
+
+} // end of namespace proxy
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <iostream>
+#include <algorithm>
+#include "lib/time/ob_time_utility.h"
+#include "obutils/ob_mt_hashtable.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace obutils;
+
+#define TEST_KEY_NUM       10000
+#define TEST_LOOKUP_NUM    1000000
+#define TEST_MAX_THREAD    64
+
+typedef ObMTHashTable<int64_t, int64_t> TestHashMap;
+
+struct LookupParam
+{
+  TestHashMap *map_;
+  volatile bool *stop_;
+  bool lock_free_;
+  int64_t found_;
+  int64_t mismatch_;
+};
+
+class TestMTHashTable : public ::testing::Test
+{
+public:
+  static uint64_t hash(const int64_t key) { return murmurhash(&key, sizeof(key), 0); }
+
+  // value of a key is always key or -key, so that a torn read is detectable
+  static void *lookup_func(void *arg)
+  {
+    LookupParam *param = static_cast<LookupParam *>(arg);
+    int64_t key = 0;
+    int64_t value = 0;
+    for (int64_t i = 0; i < TEST_LOOKUP_NUM && !ATOMIC_LOAD(param->stop_); ++i) {
+      key = i % TEST_KEY_NUM + 1;
+      const uint64_t key_hash = hash(key);
+      if (param->lock_free_) {
+        ObMTHashTableReclaimer::ReadGuard guard;
+        value = param->map_->lock_free_lookup_entry(key_hash, key);
+      } else {
+        // the same as the partition lock of the route caches
+        lib::ObMutex *mutex = &param->map_->lock_for_key(key_hash)->the_mutex_;
+        while (!lib::mutex_try_acquire(mutex)) {
+          PAUSE();
+        }
+        value = param->map_->lookup_entry(key_hash, key);
+        lib::mutex_release(mutex);
+      }
+      if (0 != value) {
+        ++param->found_;
+        if (value != key && value != -key) {
+          ++param->mismatch_;
+        }
+      }
+    }
+    return NULL;
+  }
+
+  // returns lookups per second
+  static int64_t run_lookup(TestHashMap &map, const int64_t thread_num, const bool lock_free)
+  {
+    volatile bool stop = false;
+    pthread_t threads[TEST_MAX_THREAD];
+    LookupParam params[TEST_MAX_THREAD];
+    const int64_t begin = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < thread_num; ++i) {
+      params[i].map_ = &map;
+      params[i].stop_ = &stop;
+      params[i].lock_free_ = lock_free;
+      params[i].found_ = 0;
+      params[i].mismatch_ = 0;
+      pthread_create(&threads[i], NULL, lookup_func, &params[i]);
+    }
+    int64_t found = 0;
+    for (int64_t i = 0; i < thread_num; ++i) {
+      pthread_join(threads[i], NULL);
+      found += params[i].found_;
+      EXPECT_EQ(0, params[i].mismatch_);
+    }
+    const int64_t cost_us = std::max(ObTimeUtility::current_time() - begin, 1L);
+    EXPECT_EQ(thread_num * TEST_LOOKUP_NUM, found);
+    return thread_num * TEST_LOOKUP_NUM * 1000000 / cost_us;
+  }
+};
+
+TEST_F(TestMTHashTable, lock_free_lookup_with_writer)
+{
+  TestHashMap map;
+  ASSERT_EQ(OB_SUCCESS, map.init(4, event::COMMON_LOCK, NULL, NULL, true));
+
+  volatile bool stop = false;
+  pthread_t threads[4];
+  LookupParam params[4];
+  for (int64_t i = 0; i < 4; ++i) {
+    params[i].map_ = &map;
+    params[i].stop_ = &stop;
+    params[i].lock_free_ = true;
+    params[i].found_ = 0;
+    params[i].mismatch_ = 0;
+    pthread_create(&threads[i], NULL, lookup_func, &params[i]);
+  }
+
+  // insert (with resize), replace and remove while readers are running
+  for (int64_t round = 0; round <= 10; ++round) {
+    for (int64_t key = 1; key <= TEST_KEY_NUM; ++key) {
+      const uint64_t key_hash = hash(key);
+      lib::ObMutex *mutex = &map.lock_for_key(key_hash)->the_mutex_;
+      lib::mutex_acquire(mutex);
+      if (0 == round % 3 && 0 == key % 2) {
+        map.remove_entry(key_hash, key);
+      } else {
+        map.insert_entry(key_hash, key, 0 == round % 2 ? key : -key);
+      }
+      lib::mutex_release(mutex);
+    }
+  }
+  ATOMIC_STORE(&stop, true);
+
+  for (int64_t i = 0; i < 4; ++i) {
+    pthread_join(threads[i], NULL);
+    ASSERT_EQ(0, params[i].mismatch_);
+  }
+  for (int64_t key = 1; key <= TEST_KEY_NUM; ++key) {
+    ASSERT_EQ(key, map.lookup_entry(hash(key), key));
+  }
+  ObMTHashTableReclaimer::purge();
+}
+
+// compare the locked lookup with the lock free one, read only
+TEST_F(TestMTHashTable, lookup_benchmark)
+{
+  TestHashMap locked_map;
+  TestHashMap lock_free_map;
+  ASSERT_EQ(OB_SUCCESS, locked_map.init(64));
+  ASSERT_EQ(OB_SUCCESS, lock_free_map.init(64, event::COMMON_LOCK, NULL, NULL, true));
+  for (int64_t key = 1; key <= TEST_KEY_NUM; ++key) {
+    locked_map.insert_entry(hash(key), key, key);
+    lock_free_map.insert_entry(hash(key), key, key);
+  }
+
+  for (int64_t thread_num = 1; thread_num <= TEST_MAX_THREAD; thread_num *= 2) {
+    const int64_t locked_qps = run_lookup(locked_map, thread_num, false);
+    const int64_t lock_free_qps = run_lookup(lock_free_map, thread_num, true);
+    std::cout << "threads:" << thread_num << " locked_qps:" << locked_qps
+              << " lock_free_qps:" << lock_free_qps << std::endl;
+  }
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <algorithm>
+#include "lib/time/ob_time_utility.h"
+#include "lib/allocator/page_arena.h"
+#include "common/ob_range.h"
+#include "share/part/ob_part_desc_list.h"
+#include "share/part/ob_part_desc_key.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace share::schema;
+
+#define TEST_PART_NUM      1024
+#define TEST_LOOKUP_NUM    100000
+
+class TestPartDescList : public ::testing::Test
+{
+public:
+  // partition i has the values (part_num - i) * 2 and (part_num - i) * 2 + 1, so the
+  // values are in descending order, and the last partition is the default one
+  static void build_desc_list(ObIAllocator &allocator, ObPartDescList &desc_list,
+                              const int64_t part_num, const bool with_default)
+  {
+    const int64_t part_array_size = with_default ? part_num + 1 : part_num;
+    void *buf = allocator.alloc(sizeof(ListPartition) * part_array_size);
+    ASSERT_TRUE(NULL != buf);
+    ListPartition *part_array = new (buf) ListPartition[part_array_size];
+    for (int64_t i = 0; i < part_array_size; ++i) {
+      part_array[i].part_id_ = i;
+      const int64_t value_num = (i < part_num ? 2 : 1);
+      for (int64_t j = 0; j < value_num; ++j) {
+        ObObj *obj = static_cast<ObObj *>(allocator.alloc(sizeof(ObObj)));
+        ASSERT_TRUE(NULL != obj);
+        new (obj) ObObj();
+        if (i < part_num) {
+          obj->set_int((part_num - i) * 2 + j);
+        } else {
+          obj->set_max_value();
+          desc_list.set_default_part_array_idx(i);
+        }
+        ObNewRow row;
+        row.assign(obj, 1);
+        ASSERT_EQ(OB_SUCCESS, part_array[i].rows_.push_back(row));
+      }
+    }
+    desc_list.set_part_level(PARTITION_LEVEL_ONE);
+    desc_list.get_accuracies().push_back(ObAccuracy());
+    ASSERT_EQ(OB_SUCCESS, desc_list.set_part_array(part_array, part_array_size));
+  }
+
+  static int64_t expected_part_id(const int64_t value, const int64_t part_num, const bool with_default)
+  {
+    int64_t part_id = OB_INVALID_INDEX;
+    if (value >= 2 && value <= part_num * 2 + 1) {
+      part_id = part_num - value / 2;
+    } else if (with_default) {
+      part_id = part_num;
+    }
+    return part_id;
+  }
+
+  static int get_part(ObPartDesc &desc, ObIAllocator &allocator, const int64_t value, int64_t &part_id)
+  {
+    int ret = OB_SUCCESS;
+    ObObj obj;
+    obj.set_int(value);
+    ObNewRange range;
+    range.start_key_.assign(&obj, 1);
+    range.end_key_.assign(&obj, 1);
+    ObPartDescCtx ctx;
+    ObSEArray<int64_t, 1> part_ids;
+    ObSEArray<int64_t, 1> tablet_ids;
+    int64_t part_idx = OB_INVALID_INDEX;
+    part_id = OB_INVALID_INDEX;
+    if (OB_SUCC(desc.get_part(range, allocator, part_ids, ctx, tablet_ids, part_idx))
+        && part_ids.count() > 0) {
+      part_id = part_ids.at(0);
+    }
+    return ret;
+  }
+
+  // returns the average cost of one lookup in ns
+  static int64_t run_lookup(ObPartDesc &desc, const int64_t value_range)
+  {
+    ObArenaAllocator allocator;
+    int64_t part_id = OB_INVALID_INDEX;
+    const int64_t begin = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < TEST_LOOKUP_NUM; ++i) {
+      get_part(desc, allocator, i % value_range, part_id);
+      if (0 == i % 1024) {
+        allocator.reuse();
+      }
+    }
+    return (ObTimeUtility::current_time() - begin) * 1000 / TEST_LOOKUP_NUM;
+  }
+};
+
+TEST_F(TestPartDescList, row_index_lookup)
+{
+  ObArenaAllocator allocator;
+  for (int64_t k = 0; k < 2; ++k) {
+    const bool with_default = (0 == k);
+    ObPartDescList linear_list;
+    ObPartDescList index_list;
+    build_desc_list(allocator, linear_list, TEST_PART_NUM, with_default);
+    build_desc_list(allocator, index_list, TEST_PART_NUM, with_default);
+    ASSERT_EQ(OB_SUCCESS, index_list.build_row_index(allocator));
+    ASSERT_EQ(0, linear_list.get_row_index_size());
+    ASSERT_EQ(TEST_PART_NUM * 2, index_list.get_row_index_size());
+
+    int64_t linear_part_id = OB_INVALID_INDEX;
+    int64_t index_part_id = OB_INVALID_INDEX;
+    for (int64_t value = -1; value <= TEST_PART_NUM * 2 + 3; ++value) {
+      get_part(linear_list, allocator, value, linear_part_id);
+      get_part(index_list, allocator, value, index_part_id);
+      ASSERT_EQ(expected_part_id(value, TEST_PART_NUM, with_default), linear_part_id);
+      ASSERT_EQ(linear_part_id, index_part_id);
+    }
+  }
+}
+
+TEST_F(TestPartDescList, no_row_index_for_mixed_types)
+{
+  ObArenaAllocator allocator;
+  ObPartDescList desc_list;
+  build_desc_list(allocator, desc_list, 4, false);
+  ObObj obj;
+  obj.set_null();
+  ObNewRow row;
+  row.assign(&obj, 1);
+  ASSERT_EQ(OB_SUCCESS, desc_list.get_part_array()[0].rows_.push_back(row));
+  ASSERT_EQ(OB_SUCCESS, desc_list.build_row_index(allocator));
+  ASSERT_EQ(0, desc_list.get_row_index_size());
+
+  int64_t part_id = OB_INVALID_INDEX;
+  get_part(desc_list, allocator, 9, part_id);
+  ASSERT_EQ(0, part_id);
+}
+
+// compare the linear scan with the row index, and with key partition
+TEST_F(TestPartDescList, lookup_benchmark)
+{
+  ObArenaAllocator allocator;
+  for (int64_t part_num = 16; part_num <= TEST_PART_NUM * 4; part_num *= 4) {
+    ObPartDescList linear_list;
+    ObPartDescList index_list;
+    build_desc_list(allocator, linear_list, part_num, true);
+    build_desc_list(allocator, index_list, part_num, true);
+    ASSERT_EQ(OB_SUCCESS, index_list.build_row_index(allocator));
+
+    ObPartDescKey desc_key;
+    desc_key.set_part_num(part_num);
+    desc_key.set_part_level(PARTITION_LEVEL_ONE);
+    desc_key.get_obj_types().push_back(ObIntType);
+    desc_key.get_cs_types().push_back(CS_TYPE_BINARY);
+    desc_key.get_accuracies().push_back(ObAccuracy());
+
+    const int64_t value_range = part_num * 2 + 2;
+    const int64_t linear_ns = run_lookup(linear_list, value_range);
+    const int64_t index_ns = run_lookup(index_list, value_range);
+    const int64_t key_ns = run_lookup(desc_key, value_range);
+    std::cout << "part_num:" << part_num << " list_linear_ns:" << linear_ns
+              << " list_index_ns:" << index_ns << " key_ns:" << key_ns << std::endl;
+  }
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 #include <pthread.h>
+#include <sys/eventfd.h>
 #define private public
 #define protected public
 #include "test_eventsystem_api.h"
@@ -31,6 +32,15 @@ int64_t signal_hook_result = 0;
 
 #define MAX_EVENT_CREATE_NUM        2*DEFALUT_CHANGE_COOKIE_SIZE
 #define DEFALLT_ETHREAD_NUM         4
+#define BENCH_PRODUCER_NUM          4
+#define BENCH_EVENT_NUM_PER_PRODUCER 200000
+
+struct BenchParam
+{
+  ObProtectedQueue *queue_;
+  ObEvent *events_;
+  int64_t count_;
+};
 
 class TestProtectedQueue : public ::testing::Test
 {
@@ -420,6 +430,55 @@ void *thread_fill_al_cancelled(void *protected_queue)
   return NULL;
 }
 
+void *thread_bench_enqueue(void *data)
+{
+  BenchParam *param = static_cast<BenchParam *>(data);
+  for (int64_t i = 0; i < param->count_; ++i) {
+    param->queue_->enqueue(&param->events_[i], false);
+  }
+  return NULL;
+}
+
+// enqueue from BENCH_PRODUCER_NUM non-event threads, as blocking tasks and
+// config refreshes do, and dequeue all of them on this thread
+int64_t bench_enqueue_dequeue(ObProtectedQueue &queue)
+{
+  ObThreadId tid[BENCH_PRODUCER_NUM];
+  BenchParam param[BENCH_PRODUCER_NUM];
+  const int64_t total = BENCH_PRODUCER_NUM * BENCH_EVENT_NUM_PER_PRODUCER;
+  int64_t received = 0;
+  ObEvent *e = NULL;
+
+  for (int64_t i = 0; i < BENCH_PRODUCER_NUM; ++i) {
+    param[i].queue_ = &queue;
+    param[i].count_ = BENCH_EVENT_NUM_PER_PRODUCER;
+    param[i].events_ = new ObEvent[BENCH_EVENT_NUM_PER_PRODUCER];
+    for (int64_t j = 0; j < BENCH_EVENT_NUM_PER_PRODUCER; ++j) {
+      param[i].events_[j].ethread_ = g_event_processor.all_event_threads_[0];
+    }
+  }
+
+  const int64_t start_us = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < BENCH_PRODUCER_NUM; ++i) {
+    tid[i] = thread_create(thread_bench_enqueue, (void *)&param[i], 0, 0);
+  }
+  while (received < total) {
+    queue.dequeue_timed(get_hrtime_internal() + HRTIME_MSECONDS(10), true);
+    while (NULL != (e = queue.dequeue_local())) {
+      ++received;
+    }
+  }
+  const int64_t cost_us = ObTimeUtility::current_time() - start_us;
+
+  for (int64_t i = 0; i < BENCH_PRODUCER_NUM; ++i) {
+    if (tid[i] > 0) {
+      thread_join(tid[i]);
+    }
+    delete [] param[i].events_;
+  }
+  return cost_us;
+}
+
 void fill_al_by_event_array(TestProtectedQueue *this_test)
 {
   ObThreadId tid;
@@ -761,6 +820,72 @@ TEST_F(TestProtectedQueue, dequeue_timed_sleep_empty_exception)
   ASSERT_TRUE(protected_queue_->local_queue_.empty());
 }
 
+TEST_F(TestProtectedQueue, bench_coalesced_wakeup)
+{
+  LOG_DEBUG("bench coalesced wakeup");
+  const int64_t total = BENCH_PRODUCER_NUM * BENCH_EVENT_NUM_PER_PRODUCER;
+  ObProtectedQueue cond_queue;
+  ASSERT_EQ(OB_SUCCESS, cond_queue.init());
+  const int64_t cond_cost_us = bench_enqueue_dequeue(cond_queue);
+  ASSERT_TRUE(cond_queue.atomic_list_.empty());
+  mutex_destroy(&cond_queue.lock_);
+  cond_destroy(&cond_queue.might_have_data_);
+
+  ObProtectedQueue eventfd_queue;
+  ASSERT_EQ(OB_SUCCESS, eventfd_queue.init());
+  int evfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  ASSERT_TRUE(evfd >= 0);
+  eventfd_queue.set_wakeup_fd(evfd);
+  const int64_t eventfd_cost_us = bench_enqueue_dequeue(eventfd_queue);
+  ASSERT_TRUE(eventfd_queue.atomic_list_.empty());
+  ASSERT_FALSE(eventfd_queue.sleeping_);
+  mutex_destroy(&eventfd_queue.lock_);
+  cond_destroy(&eventfd_queue.might_have_data_);
+  close(evfd);
+
+  LOG_INFO("enqueue/dequeue throughput", "producers", BENCH_PRODUCER_NUM, K(total),
+           K(cond_cost_us), "cond events/s", total * 1000000 / (cond_cost_us + 1),
+           K(eventfd_cost_us), "eventfd events/s", total * 1000000 / (eventfd_cost_us + 1));
+}
+
+TEST_F(TestProtectedQueue, coalesced_wakeup)
+{
+  LOG_DEBUG("coalesced wakeup");
+  int evfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  uint64_t counter = 0;
+  ASSERT_TRUE(evfd >= 0);
+  protected_queue_->set_wakeup_fd(evfd);
+
+  // awake owner is never signaled
+  event_array_[0]->ethread_ = g_event_processor.all_event_threads_[0];
+  protected_queue_->enqueue(event_array_[0], false);
+  ASSERT_EQ(-1, read(evfd, &counter, sizeof(counter)));
+  ASSERT_FALSE(protected_queue_->prepare_sleep());
+  protected_queue_->dequeue_timed(0, false);
+  ASSERT_TRUE(event_array_[0] == protected_queue_->dequeue_local());
+
+  // sleeping owner is signaled only once
+  ASSERT_TRUE(protected_queue_->prepare_sleep());
+  for (int64_t i = 1; i < MAX_EVENT_CREATE_NUM; ++i) {
+    event_array_[i]->ethread_ = g_event_processor.all_event_threads_[0];
+    protected_queue_->enqueue(event_array_[i], false);
+    ASSERT_EQ(OB_SUCCESS, protected_queue_->signal());
+  }
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(counter)), read(evfd, &counter, sizeof(counter)));
+  ASSERT_EQ(1U, counter);
+  ASSERT_FALSE(protected_queue_->sleeping_);
+
+  // dequeue_timed() doesn't sleep if there are events
+  ObHRTime last_time = get_hrtime_internal();
+  protected_queue_->dequeue_timed(last_time + HRTIME_SECONDS(2), true);
+  ASSERT_TRUE(check_imm_test_ok(get_hrtime_internal() - last_time));
+  for (int64_t i = 1; i < MAX_EVENT_CREATE_NUM; ++i) {
+    ASSERT_TRUE(event_array_[i] == protected_queue_->dequeue_local());
+  }
+  protected_queue_->set_wakeup_fd(-1);
+  close(evfd);
+}
+
 } // end of namespace obproxy
 } // end of namespace oceanbase
 
@@ -89,6 +89,31 @@ TEST_F(TestProxySessionInfo, set_get_func)
   ASSERT_EQ(session.get_db_name_version(), 2);
 }
 
+TEST_F(TestProxySessionInfo, session_vars_fingerprint)
+{
+  ObClientSessionInfo client_info;
+  ObServerSessionInfo server_info;
+  ASSERT_EQ(OB_SUCCESS, client_info.init());
+  ASSERT_EQ(OB_SUCCESS, server_info.init());
+  ASSERT_EQ(OB_SUCCESS, client_info.set_database_name(ObString::make_string("obproxy")));
+  client_info.val_hash_.hot_sys_var_hash_ = 100;
+  client_info.val_hash_.user_var_hash_ = 1000;
+  ASSERT_NE(client_info.get_session_vars_fingerprint(), server_info.get_session_vars_fingerprint());
+
+  // same synced state, same fingerprint
+  ASSERT_EQ(OB_SUCCESS, server_info.set_database_name(ObString::make_string("obproxy"), false));
+  server_info.val_hash_.hot_sys_var_hash_ = 100;
+  server_info.val_hash_.user_var_hash_ = 1000;
+  ASSERT_EQ(client_info.get_session_vars_fingerprint(), server_info.get_session_vars_fingerprint());
+
+  // differ in one category or in database
+  server_info.val_hash_.user_var_hash_ = 1001;
+  ASSERT_NE(client_info.get_session_vars_fingerprint(), server_info.get_session_vars_fingerprint());
+  server_info.val_hash_.user_var_hash_ = 1000;
+  ASSERT_EQ(OB_SUCCESS, server_info.set_database_name(ObString::make_string("hust"), false));
+  ASSERT_NE(client_info.get_session_vars_fingerprint(), server_info.get_session_vars_fingerprint());
+}
+
 TEST_F(TestProxySessionInfo, not_init)
 {
   ObClientSessionInfo session;
@@ -189,6 +214,75 @@ TEST_F(TestProxySessionInfo, user_variable_func)
 
 }
 
+TEST_F(TestProxySessionInfo, changed_val_hash_func)
+{
+  ObClientSessionInfo session;
+  ObServerSessionInfo server_session;
+  ObString var_name = ObString::make_string("a");
+  ObObj value;
+  ASSERT_EQ(OB_SUCCESS, session.init());
+  ASSERT_EQ(OB_SUCCESS, server_session.init());
+
+  value.set_int(1);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(var_name, value));
+  ASSERT_TRUE(session.is_user_var_version_changed());
+  ASSERT_EQ(OB_SUCCESS, session.calc_changed_val_hash());
+  ASSERT_FALSE(session.is_user_var_version_changed());
+  const uint64_t hash_one = session.val_hash_.user_var_hash_;
+
+  // set and set back, the version goes on but the value hash comes back
+  value.set_int(2);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(var_name, value));
+  ASSERT_EQ(OB_SUCCESS, session.calc_changed_val_hash());
+  ASSERT_NE(hash_one, session.val_hash_.user_var_hash_);
+  value.set_int(1);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(var_name, value));
+  ASSERT_EQ(OB_SUCCESS, session.calc_changed_val_hash());
+  ASSERT_EQ(hash_one, session.val_hash_.user_var_hash_);
+
+  // the synced val hash is invalid once the versions change by other ways
+  ASSERT_FALSE(server_session.is_val_hash_synced());
+  server_session.val_hash_.assign(session.val_hash_);
+  server_session.set_val_hash_synced();
+  ASSERT_TRUE(server_session.is_val_hash_synced());
+  ASSERT_TRUE(server_session.val_hash_.equal(session.val_hash_));
+  server_session.set_user_var_version(session.get_user_var_version());
+  ASSERT_FALSE(server_session.is_val_hash_synced());
+}
+
+TEST_F(TestProxySessionInfo, session_vars_image_func)
+{
+  ObClientSessionInfo session;
+  ObString var_name = ObString::make_string("a");
+  ObObj value;
+  ASSERT_EQ(OB_SUCCESS, session.init());
+
+  value.set_varchar("abc");
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(var_name, value));
+  ASSERT_EQ(OB_SUCCESS, session.calc_changed_val_hash());
+  ASSERT_EQ(OB_SUCCESS, session.calc_session_vars_image());
+  const uint64_t lower_hash = session.val_hash_.user_var_hash_;
+  ObSqlString lower_image;
+  ASSERT_EQ(OB_SUCCESS, lower_image.assign(session.get_session_vars_image()));
+
+  // the val hash is case insensitive, but the image is not
+  value.set_varchar("ABC");
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(var_name, value));
+  ASSERT_EQ(OB_SUCCESS, session.calc_changed_val_hash());
+  ASSERT_EQ(OB_SUCCESS, session.calc_session_vars_image());
+  ASSERT_EQ(lower_hash, session.val_hash_.user_var_hash_);
+  ASSERT_FALSE(lower_image.string() == session.get_session_vars_image());
+
+  // set back, the image comes back
+  value.set_varchar("abc");
+  value.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ASSERT_EQ(OB_SUCCESS, session.replace_user_variable(var_name, value));
+  ASSERT_EQ(OB_SUCCESS, session.calc_session_vars_image());
+  ASSERT_TRUE(lower_image.string() == session.get_session_vars_image());
+}
+
 TEST_F(TestProxySessionInfo, extract_variable_reset_sql_func)
 {
   ObClientSessionInfo session;
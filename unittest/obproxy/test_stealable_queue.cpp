@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_EVENT
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#define private public
+#define protected public
+#include "ob_stealable_queue.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace event;
+
+#define TEST_EVENT_NUM    100000
+#define TEST_THIEF_NUM    3
+
+struct StealParam
+{
+  ObStealableQueue *queue_;
+  volatile bool *stop_;
+  int64_t count_;
+};
+
+class TestStealableQueue : public ::testing::Test
+{
+public:
+  virtual void SetUp() { ASSERT_EQ(OB_SUCCESS, queue_.init()); }
+  virtual void TearDown() { }
+
+  static void *thief_func(void *arg)
+  {
+    StealParam *param = static_cast<StealParam *>(arg);
+    ObEvent *e = NULL;
+    while (!ATOMIC_LOAD(param->stop_) || param->queue_->get_size() > 0) {
+      if (NULL != (e = param->queue_->steal())) {
+        e->cookie_ = reinterpret_cast<void *>(1);
+        ++param->count_;
+      }
+    }
+    return NULL;
+  }
+
+public:
+  ObStealableQueue queue_;
+  ObEvent events_[TEST_EVENT_NUM];
+};
+
+TEST_F(TestStealableQueue, test_owner_lifo_thief_fifo)
+{
+  ASSERT_TRUE(NULL == queue_.pop());
+  ASSERT_TRUE(NULL == queue_.steal());
+  for (int64_t i = 0; i < 4; ++i) {
+    queue_.push(&events_[i]);
+  }
+  ASSERT_EQ(4, queue_.get_size());
+  // the owner runs the newest, the thief takes the oldest
+  ASSERT_EQ(&events_[3], queue_.pop());
+  ASSERT_EQ(&events_[0], queue_.steal());
+  ASSERT_EQ(&events_[1], queue_.steal());
+  ASSERT_EQ(&events_[2], queue_.pop());
+  ASSERT_EQ(0, queue_.get_size());
+  ASSERT_TRUE(NULL == queue_.pop());
+  ASSERT_TRUE(NULL == queue_.steal());
+}
+
+TEST_F(TestStealableQueue, test_concurrent_steal)
+{
+  volatile bool stop = false;
+  pthread_t threads[TEST_THIEF_NUM];
+  StealParam params[TEST_THIEF_NUM];
+  for (int64_t i = 0; i < TEST_THIEF_NUM; ++i) {
+    params[i].queue_ = &queue_;
+    params[i].stop_ = &stop;
+    params[i].count_ = 0;
+    ASSERT_EQ(0, pthread_create(&threads[i], NULL, thief_func, &params[i]));
+  }
+
+  int64_t popped = 0;
+  ObEvent *e = NULL;
+  for (int64_t i = 0; i < TEST_EVENT_NUM; ++i) {
+    queue_.push(&events_[i]);
+    if (0 == (i & 1) && NULL != (e = queue_.pop())) {
+      e->cookie_ = reinterpret_cast<void *>(1);
+      ++popped;
+    }
+  }
+  ATOMIC_STORE(&stop, true);
+
+  int64_t stolen = 0;
+  for (int64_t i = 0; i < TEST_THIEF_NUM; ++i) {
+    pthread_join(threads[i], NULL);
+    stolen += params[i].count_;
+  }
+  while (NULL != (e = queue_.pop())) {
+    e->cookie_ = reinterpret_cast<void *>(1);
+    ++popped;
+  }
+
+  // every event is taken exactly once
+  ASSERT_EQ(TEST_EVENT_NUM, popped + stolen);
+  ASSERT_EQ(0, queue_.get_size());
+  for (int64_t i = 0; i < TEST_EVENT_NUM; ++i) {
+    ASSERT_TRUE(NULL != events_[i].cookie_);
+  }
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
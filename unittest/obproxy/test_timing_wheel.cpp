@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase Database Proxy(ODP) is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PROXY_EVENT
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "ob_timing_wheel.h"
+
+namespace oceanbase
+{
+namespace obproxy
+{
+using namespace common;
+using namespace event;
+
+#define TEST_WHEEL_TICK      HRTIME_MSECONDS(10)
+#define TEST_WHEEL_NODE_NUM  1000
+
+struct TestWheelNode
+{
+  TestWheelNode() : wheel_expire_at_(0), wheel_slot_(-1), expired_at_(0) { }
+
+  ObHRTime wheel_expire_at_;
+  int32_t wheel_slot_;
+  ObHRTime expired_at_;
+  LINK(TestWheelNode, link_);
+};
+
+typedef ObTimingWheel<TestWheelNode, TestWheelNode::Link_link_> TestWheel;
+
+class TestTimingWheel : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    base_ = HRTIME_SECONDS(1000);
+    ASSERT_EQ(OB_SUCCESS, wheel_.init(TEST_WHEEL_TICK, base_));
+  }
+  virtual void TearDown() { }
+
+  // advance the wheel tick by tick up to now and record the expire time
+  int64_t advance_to(const ObHRTime now)
+  {
+    int64_t count = 0;
+    TestWheelNode *node = NULL;
+    for (ObHRTime t = cur_; t <= now; t += TEST_WHEEL_TICK) {
+      wheel_.advance(t, expired_);
+      while (NULL != (node = expired_.pop())) {
+        node->expired_at_ = t;
+        ++count;
+      }
+    }
+    cur_ = now + TEST_WHEEL_TICK;
+    return count;
+  }
+
+public:
+  ObHRTime base_;
+  ObHRTime cur_;
+  TestWheel wheel_;
+  Que(TestWheelNode, link_) expired_;
+  TestWheelNode nodes_[TEST_WHEEL_NODE_NUM];
+};
+
+TEST_F(TestTimingWheel, test_init)
+{
+  TestWheel wheel;
+  ASSERT_FALSE(wheel.is_inited());
+  ASSERT_EQ(OB_INVALID_ARGUMENT, wheel.init(0, base_));
+  ASSERT_EQ(OB_SUCCESS, wheel.init(TEST_WHEEL_TICK, base_));
+  ASSERT_EQ(OB_INIT_TWICE, wheel.init(TEST_WHEEL_TICK, base_));
+  ASSERT_EQ(INT64_MAX, wheel.next_expire_time());
+}
+
+TEST_F(TestTimingWheel, test_expire_in_order)
+{
+  // from one tick to beyond the top level
+  const ObHRTime delays[] = {
+    0, TEST_WHEEL_TICK, HRTIME_MSECONDS(15), HRTIME_MSECONDS(630), HRTIME_MSECONDS(650),
+    HRTIME_SECONDS(40), HRTIME_SECONDS(41), HRTIME_MINUTES(43), HRTIME_MINUTES(44), HRTIME_HOURS(50),
+  };
+  const int64_t count = sizeof(delays) / sizeof(delays[0]);
+  for (int64_t i = 0; i < count; ++i) {
+    wheel_.schedule(&nodes_[i], base_ + delays[i]);
+    ASSERT_TRUE(wheel_.in(&nodes_[i]));
+  }
+  ASSERT_EQ(count, wheel_.get_count());
+
+  cur_ = base_;
+  ASSERT_EQ(count, advance_to(base_ + delays[count - 1] + TEST_WHEEL_TICK));
+  for (int64_t i = 0; i < count; ++i) {
+    // never early, and late for less than one tick
+    ASSERT_FALSE(wheel_.in(&nodes_[i]));
+    ASSERT_GE(nodes_[i].expired_at_, base_ + delays[i]);
+    ASSERT_LT(nodes_[i].expired_at_, base_ + delays[i] + TEST_WHEEL_TICK);
+  }
+  ASSERT_EQ(0, wheel_.get_count());
+}
+
+TEST_F(TestTimingWheel, test_remove_and_reschedule)
+{
+  for (int64_t i = 0; i < TEST_WHEEL_NODE_NUM; ++i) {
+    wheel_.schedule(&nodes_[i], base_ + HRTIME_MSECONDS(i * 7));
+  }
+  ASSERT_EQ(base_, wheel_.next_expire_time());
+
+  // remove the odd ones, move the rest 1 second later
+  for (int64_t i = 0; i < TEST_WHEEL_NODE_NUM; ++i) {
+    if (0 != (i & 1)) {
+      wheel_.remove(&nodes_[i]);
+      ASSERT_FALSE(wheel_.in(&nodes_[i]));
+    } else {
+      wheel_.schedule(&nodes_[i], base_ + HRTIME_SECONDS(1) + HRTIME_MSECONDS(i * 7));
+    }
+  }
+  ASSERT_EQ(TEST_WHEEL_NODE_NUM / 2, wheel_.get_count());
+  // the earliest one is in a higher level, wake up for the cascade before it
+  ASSERT_GT(wheel_.next_expire_time(), base_);
+  ASSERT_LE(wheel_.next_expire_time(), base_ + HRTIME_SECONDS(1));
+
+  // one advance over a long time expires everything, even with empty rounds skipped
+  wheel_.advance(base_ + HRTIME_SECONDS(100), expired_);
+  int64_t expired = 0;
+  TestWheelNode *node = NULL;
+  while (NULL != (node = expired_.pop())) {
+    ASSERT_EQ(0, (node - nodes_) & 1);
+    ++expired;
+  }
+  ASSERT_EQ(TEST_WHEEL_NODE_NUM / 2, expired);
+  ASSERT_EQ(0, wheel_.get_count());
+  ASSERT_EQ(INT64_MAX, wheel_.next_expire_time());
+}
+
+TEST_F(TestTimingWheel, test_past_expire_time)
+{
+  cur_ = base_;
+  ASSERT_EQ(0, advance_to(base_ + HRTIME_SECONDS(1)));
+  // expires at the next advance
+  wheel_.schedule(&nodes_[0], base_);
+  ASSERT_LE(wheel_.next_expire_time(), cur_);
+  ASSERT_EQ(1, advance_to(cur_));
+}
+
+} // end of namespace obproxy
+} // end of namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("WARN");
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}